@@ -0,0 +1,1633 @@
+#pragma once
+#include "Utilities.h"
+#include "Array.h"
+#include "ArrayView.h"
+
+#include <limits>
+#include <type_traits>
+
+// Define ALGORITHMS_USE_SIMD as 0 to only use the scalar loops
+#ifndef ALGORITHMS_USE_SIMD
+#if defined(__x86_64__) || defined(_M_X64)
+    #define ALGORITHMS_USE_SIMD 1
+#else
+    #define ALGORITHMS_USE_SIMD 0
+#endif
+#endif
+
+#if ALGORITHMS_USE_SIMD
+    // GCC warns about the undefined source operand of the AVX-512 min and max intrinsics
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wuninitialized"
+        #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+        #include <immintrin.h>
+        #pragma GCC diagnostic pop
+    #else
+        #include <immintrin.h>
+    #endif
+
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#endif
+
+// Functions that use instructions above the compiler's target, MSVC allows all intrinsics everywhere
+#if defined(_MSC_VER)
+    #define SIMD_TARGET(Target)
+#else
+    #define SIMD_TARGET(Target) __attribute__((target(Target)))
+#endif
+
+/*
+ * Algorithms - Search and reduction of the elements in a TArrayView, TArrays can be passed directly. Integer, Float and
+ * Double elements are processed with SSE2, AVX2 or AVX-512, selected at runtime from what the CPU supports, and all
+ * other types use scalar loops. Sum and Dot of floating point elements add in a different order than a loop does, so
+ * the result can differ in the last bits. The result of Min, Max, ArgMin and ArgMax is unspecified with NaNs, but
+ * ArgMin and ArgMax always return the index of an element.
+ */
+
+enum class ESimdLevel : UInt8
+{
+    Scalar = 0,
+    SSE2   = 1,
+    AVX2   = 2,
+    AVX512 = 3, // AVX-512 F, BW and DQ, and POPCNT
+};
+
+// _SimdImpl - Level detection, scalar loops and the dispatch to the instruction sets
+
+struct _SimdImpl
+{
+    enum class EReduce : UInt8
+    {
+        Min,
+        Max,
+        Sum,
+    };
+
+    template<typename T>
+    static constexpr Bool IsVectorizable = (std::is_integral<T>::value && !std::is_same<T, Bool>::value) || std::is_same<T, Float>::value || std::is_same<T, Double>::value;
+
+    static ESimdLevel DetectLevel() noexcept
+    {
+#if ALGORITHMS_USE_SIMD
+    #if defined(_MSC_VER)
+        Int32 Info[4];
+        __cpuid(Info, 0);
+        const Int32 MaxLeaf = Info[0];
+
+        // The OS must save the YMM and ZMM registers as well
+        __cpuid(Info, 1);
+        const Bool HasOSXSave  = (Info[2] & (1 << 27)) != 0;
+        const Bool HasPopCount = (Info[2] & (1 << 23)) != 0;
+        if (!HasOSXSave || MaxLeaf < 7)
+        {
+            return ESimdLevel::SSE2;
+        }
+
+        const UInt64 EnabledState = _xgetbv(0);
+        if ((EnabledState & 0x6) != 0x6)
+        {
+            return ESimdLevel::SSE2;
+        }
+
+        __cpuidex(Info, 7, 0);
+        const Bool HasAVX512 = (Info[1] & (1 << 16)) && (Info[1] & (1 << 17)) && (Info[1] & (1 << 30)) && ((EnabledState & 0xE6) == 0xE6) && HasPopCount;
+        if (HasAVX512)
+        {
+            return ESimdLevel::AVX512;
+        }
+
+        return (Info[1] & (1 << 5)) ? ESimdLevel::AVX2 : ESimdLevel::SSE2;
+    #else
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("popcnt"))
+        {
+            return ESimdLevel::AVX512;
+        }
+
+        return __builtin_cpu_supports("avx2") ? ESimdLevel::AVX2 : ESimdLevel::SSE2;
+    #endif
+#else
+        return ESimdLevel::Scalar;
+#endif
+    }
+
+    static ESimdLevel GetSupportedLevel() noexcept
+    {
+        static const ESimdLevel SupportedLevel = DetectLevel();
+        return SupportedLevel;
+    }
+
+    static ESimdLevel& GetLevel() noexcept
+    {
+        static ESimdLevel Level = GetSupportedLevel();
+        return Level;
+    }
+
+    static FORCEINLINE UInt32 CountTrailingZeros(UInt64 Mask) noexcept
+    {
+#if defined(_MSC_VER)
+        unsigned long Index;
+        _BitScanForward64(&Index, Mask);
+        return UInt32(Index);
+#else
+        return UInt32(__builtin_ctzll(Mask));
+#endif
+    }
+
+    static FORCEINLINE UInt32 PopCount(UInt64 Mask) noexcept
+    {
+#if defined(_MSC_VER)
+        return UInt32(__popcnt64(Mask));
+#else
+        return UInt32(__builtin_popcountll(Mask));
+#endif
+    }
+
+    template<EReduce Op, typename T>
+    static FORCEINLINE T Combine(const T& Lhs, const T& Rhs) noexcept
+    {
+        if constexpr (Op == EReduce::Min)
+        {
+            return (Rhs < Lhs) ? Rhs : Lhs;
+        }
+        else if constexpr (Op == EReduce::Max)
+        {
+            return (Lhs < Rhs) ? Rhs : Lhs;
+        }
+        else
+        {
+            return Add(Lhs, Rhs);
+        }
+    }
+
+    // Integers wrap around instead of overflowing, as the vector instructions do
+    template<typename T>
+    static FORCEINLINE T Add(const T& Lhs, const T& Rhs) noexcept
+    {
+        if constexpr (std::is_integral<T>::value)
+        {
+            return T(UInt64(Lhs) + UInt64(Rhs));
+        }
+        else
+        {
+            return T(Lhs + Rhs);
+        }
+    }
+
+    template<typename T>
+    static FORCEINLINE T Multiply(const T& Lhs, const T& Rhs) noexcept
+    {
+        if constexpr (std::is_integral<T>::value)
+        {
+            return T(UInt64(Lhs) * UInt64(Rhs));
+        }
+        else
+        {
+            return T(Lhs * Rhs);
+        }
+    }
+
+    template<typename T>
+    static UInt64 ScalarIndexOf(const T* Data, UInt64 Size, const T& Value) noexcept
+    {
+        for (UInt64 Index = 0; Index < Size; Index++)
+        {
+            if (Data[Index] == Value)
+            {
+                return Index;
+            }
+        }
+
+        return Size;
+    }
+
+    template<typename T>
+    static UInt64 ScalarCount(const T* Data, UInt64 Size, const T& Value) noexcept
+    {
+        UInt64 Count = 0;
+        for (UInt64 Index = 0; Index < Size; Index++)
+        {
+            Count += (Data[Index] == Value) ? 1 : 0;
+        }
+
+        return Count;
+    }
+
+    template<EReduce Op, typename T>
+    static T ScalarReduce(const T* Data, UInt64 Size, T Result) noexcept
+    {
+        for (UInt64 Index = 0; Index < Size; Index++)
+        {
+            Result = Combine<Op>(Result, Data[Index]);
+        }
+
+        return Result;
+    }
+
+    template<typename T>
+    static T ScalarDot(const T* Lhs, const T* Rhs, UInt64 Size, T Result) noexcept
+    {
+        for (UInt64 Index = 0; Index < Size; Index++)
+        {
+            Result = Add(Result, Multiply(Lhs[Index], Rhs[Index]));
+        }
+
+        return Result;
+    }
+
+    template<typename T>
+    static UInt64 IndexOf(const T* Data, UInt64 Size, const T& Value) noexcept;
+
+    template<typename T>
+    static UInt64 Count(const T* Data, UInt64 Size, const T& Value) noexcept;
+
+    template<EReduce Op, typename T>
+    static T Reduce(const T* Data, UInt64 Size, T Init) noexcept;
+
+    template<typename T>
+    static T Dot(const T* Lhs, const T* Rhs, UInt64 Size) noexcept;
+};
+
+#if ALGORITHMS_USE_SIMD
+
+/*
+ * Instruction sets - Every set has the same operations on a vector of T and the same kernels. EqualMask returns
+ * MaskBits<T> bits per element, so the kernels divide the bit index and the bit count by it. The kernels are repeated
+ * per set since GCC and Clang only inline the intrinsics into functions that are compiled for the same target.
+ */
+
+struct _SimdSSE2
+{
+    typedef _SimdImpl::EReduce EReduce;
+
+    template<typename T, typename TDummy = Void>
+    struct TVectorType
+    {
+        typedef __m128i Type;
+    };
+
+    template<typename TDummy>
+    struct TVectorType<Float, TDummy>
+    {
+        typedef __m128 Type;
+    };
+
+    template<typename TDummy>
+    struct TVectorType<Double, TDummy>
+    {
+        typedef __m128d Type;
+    };
+
+    template<typename T>
+    using TVector = typename TVectorType<T>::Type;
+
+    template<typename T>
+    static constexpr UInt32 Width = UInt32(sizeof(__m128i) / sizeof(T));
+
+    template<typename T>
+    static constexpr UInt32 MaskBits = UInt32(sizeof(T));
+
+    // There is no 64-bit integer compare, and 16-bit is the only integer multiply
+    template<typename T>
+    static constexpr Bool HasMinMax = std::is_floating_point<T>::value || (sizeof(T) < 8);
+
+    template<typename T>
+    static constexpr Bool HasMultiply = std::is_floating_point<T>::value || (sizeof(T) == 2);
+
+    template<typename T>
+    static SIMD_TARGET("sse2") TVector<T> Load(const T* Data) noexcept
+    {
+        if constexpr (std::is_same<T, Float>::value)
+        {
+            return _mm_loadu_ps(Data);
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            return _mm_loadu_pd(Data);
+        }
+        else
+        {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data));
+        }
+    }
+
+    template<typename T>
+    static SIMD_TARGET("sse2") void Store(T* Data, TVector<T> Vector) noexcept
+    {
+        if constexpr (std::is_same<T, Float>::value)
+        {
+            _mm_storeu_ps(Data, Vector);
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            _mm_storeu_pd(Data, Vector);
+        }
+        else
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(Data), Vector);
+        }
+    }
+
+    template<typename T>
+    static SIMD_TARGET("sse2") TVector<T> Set1(T Value) noexcept
+    {
+        if constexpr (std::is_same<T, Float>::value)
+        {
+            return _mm_set1_ps(Value);
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            return _mm_set1_pd(Value);
+        }
+        else if constexpr (sizeof(T) == 1)
+        {
+            return _mm_set1_epi8(Int8(Value));
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            return _mm_set1_epi16(Int16(Value));
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            return _mm_set1_epi32(Int32(Value));
+        }
+        else
+        {
+            return _mm_set1_epi64x(Int64(Value));
+        }
+    }
+
+    // All bytes of the equal elements are set
+    template<typename T>
+    static SIMD_TARGET("sse2") __m128i Equal(TVector<T> Lhs, TVector<T> Rhs) noexcept
+    {
+        if constexpr (std::is_same<T, Float>::value)
+        {
+            return _mm_castps_si128(_mm_cmpeq_ps(Lhs, Rhs));
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            return _mm_castpd_si128(_mm_cmpeq_pd(Lhs, Rhs));
+        }
+        else if constexpr (sizeof(T) == 1)
+        {
+            return _mm_cmpeq_epi8(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            return _mm_cmpeq_epi16(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            return _mm_cmpeq_epi32(Lhs, Rhs);
+        }
+        else
+        {
+            // Both halves of a 64-bit element must be equal
+            const __m128i Equal = _mm_cmpeq_epi32(Lhs, Rhs);
+            return _mm_and_si128(Equal, _mm_shuffle_epi32(Equal, _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+    }
+
+    template<typename T>
+    static SIMD_TARGET("sse2") UInt64 EqualMask(TVector<T> Lhs, TVector<T> Rhs) noexcept
+    {
+        return UInt32(_mm_movemask_epi8(Equal<T>(Lhs, Rhs)));
+    }
+
+    // Signed compare, unsigned elements are biased into the signed range
+    template<typename T>
+    static SIMD_TARGET("sse2") __m128i Greater(__m128i Lhs, __m128i Rhs) noexcept
+    {
+        if constexpr (!std::is_signed<T>::value)
+        {
+            typedef std::make_signed_t<T> TSigned;
+
+            const __m128i Bias = Set1<TSigned>(std::numeric_limits<TSigned>::min());
+            return Greater<TSigned>(_mm_xor_si128(Lhs, Bias), _mm_xor_si128(Rhs, Bias));
+        }
+        else if constexpr (sizeof(T) == 1)
+        {
+            return _mm_cmpgt_epi8(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            return _mm_cmpgt_epi16(Lhs, Rhs);
+        }
+        else
+        {
+            return _mm_cmpgt_epi32(Lhs, Rhs);
+        }
+    }
+
+    static SIMD_TARGET("sse2") __m128i Select(__m128i Mask, __m128i IfSet, __m128i IfClear) noexcept
+    {
+        return _mm_or_si128(_mm_and_si128(Mask, IfSet), _mm_andnot_si128(Mask, IfClear));
+    }
+
+    template<typename T>
+    static SIMD_TARGET("sse2") TVector<T> Add(TVector<T> Lhs, TVector<T> Rhs) noexcept
+    {
+        if constexpr (std::is_same<T, Float>::value)
+        {
+            return _mm_add_ps(Lhs, Rhs);
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            return _mm_add_pd(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 1)
+        {
+            return _mm_add_epi8(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            return _mm_add_epi16(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            return _mm_add_epi32(Lhs, Rhs);
+        }
+        else
+        {
+            return _mm_add_epi64(Lhs, Rhs);
+        }
+    }
+
+    template<typename T>
+    static SIMD_TARGET("sse2") TVector<T> Multiply(TVector<T> Lhs, TVector<T> Rhs) noexcept
+    {
+        static_assert(HasMultiply<T>, "No SSE2 multiply for this type");
+
+        if constexpr (std::is_same<T, Float>::value)
+        {
+            return _mm_mul_ps(Lhs, Rhs);
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            return _mm_mul_pd(Lhs, Rhs);
+        }
+        else
+        {
+            return _mm_mullo_epi16(Lhs, Rhs);
+        }
+    }
+
+    template<EReduce Op, typename T>
+    static SIMD_TARGET("sse2") TVector<T> Combine(TVector<T> Lhs, TVector<T> Rhs) noexcept
+    {
+        static_assert(Op == EReduce::Sum || HasMinMax<T>, "No SSE2 min and max for this type");
+
+        if constexpr (Op == EReduce::Sum)
+        {
+            return Add<T>(Lhs, Rhs);
+        }
+        else if constexpr (std::is_same<T, Float>::value)
+        {
+            return (Op == EReduce::Min) ? _mm_min_ps(Lhs, Rhs) : _mm_max_ps(Lhs, Rhs);
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            return (Op == EReduce::Min) ? _mm_min_pd(Lhs, Rhs) : _mm_max_pd(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 1 && !std::is_signed<T>::value)
+        {
+            return (Op == EReduce::Min) ? _mm_min_epu8(Lhs, Rhs) : _mm_max_epu8(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 2 && std::is_signed<T>::value)
+        {
+            return (Op == EReduce::Min) ? _mm_min_epi16(Lhs, Rhs) : _mm_max_epi16(Lhs, Rhs);
+        }
+        else
+        {
+            const __m128i IsGreater = Greater<T>(Lhs, Rhs);
+            return (Op == EReduce::Min) ? Select(IsGreater, Rhs, Lhs) : Select(IsGreater, Lhs, Rhs);
+        }
+    }
+
+    template<typename T>
+    static SIMD_TARGET("sse2") UInt64 IndexOf(const T* Data, UInt64 Size, T Value) noexcept
+    {
+        const TVector<T> Needle = Set1<T>(Value);
+
+        UInt64 Index = 0;
+        for (; Index + Width<T> <= Size; Index += Width<T>)
+        {
+            const UInt64 Mask = EqualMask<T>(Load<T>(Data + Index), Needle);
+            if (Mask)
+            {
+                return Index + _SimdImpl::CountTrailingZeros(Mask) / MaskBits<T>;
+            }
+        }
+
+        return Index + _SimdImpl::ScalarIndexOf(Data + Index, Size - Index, Value);
+    }
+
+    // Subtracting the compare results counts the equal bytes, the counters are summed before they can overflow
+    template<typename T>
+    static SIMD_TARGET("sse2") UInt64 Count(const T* Data, UInt64 Size, T Value) noexcept
+    {
+        const TVector<T> Needle = Set1<T>(Value);
+        const __m128i    Zero   = _mm_setzero_si128();
+
+        __m128i Totals = Zero;
+        UInt64  Index  = 0;
+        while (Index + Width<T> <= Size)
+        {
+            __m128i Counters = Zero;
+            for (UInt32 Step = 0; Step < 255 && Index + Width<T> <= Size; Step++, Index += Width<T>)
+            {
+                Counters = _mm_sub_epi8(Counters, Equal<T>(Load<T>(Data + Index), Needle));
+            }
+
+            Totals = _mm_add_epi64(Totals, _mm_sad_epu8(Counters, Zero));
+        }
+
+        UInt64 Lanes[sizeof(__m128i) / sizeof(UInt64)];
+        Store<UInt64>(Lanes, Totals);
+
+        const UInt64 Count = _SimdImpl::ScalarReduce<EReduce::Sum>(Lanes, sizeof(__m128i) / sizeof(UInt64), UInt64(0));
+        return (Count / sizeof(T)) + _SimdImpl::ScalarCount(Data + Index, Size - Index, Value);
+    }
+
+    // Four accumulators hide the latency of the operation
+    template<EReduce Op, typename T>
+    static SIMD_TARGET("sse2") T Reduce(const T* Data, UInt64 Size, T Init) noexcept
+    {
+        TVector<T> Result0 = Set1<T>(Init);
+        TVector<T> Result1 = Result0;
+        TVector<T> Result2 = Result0;
+        TVector<T> Result3 = Result0;
+
+        UInt64 Index = 0;
+        for (; Index + 4 * Width<T> <= Size; Index += 4 * Width<T>)
+        {
+            Result0 = Combine<Op, T>(Result0, Load<T>(Data + Index));
+            Result1 = Combine<Op, T>(Result1, Load<T>(Data + Index + Width<T>));
+            Result2 = Combine<Op, T>(Result2, Load<T>(Data + Index + 2 * Width<T>));
+            Result3 = Combine<Op, T>(Result3, Load<T>(Data + Index + 3 * Width<T>));
+        }
+
+        for (; Index + Width<T> <= Size; Index += Width<T>)
+        {
+            Result0 = Combine<Op, T>(Result0, Load<T>(Data + Index));
+        }
+
+        T Lanes[Width<T>];
+        Store<T>(Lanes, Combine<Op, T>(Combine<Op, T>(Result0, Result1), Combine<Op, T>(Result2, Result3)));
+
+        const T Result = _SimdImpl::ScalarReduce<Op>(Lanes, Width<T>, Init);
+        return _SimdImpl::ScalarReduce<Op>(Data + Index, Size - Index, Result);
+    }
+
+    template<typename T>
+    static SIMD_TARGET("sse2") T Dot(const T* Lhs, const T* Rhs, UInt64 Size) noexcept
+    {
+        TVector<T> Result0 = Set1<T>(T(0));
+        TVector<T> Result1 = Result0;
+        TVector<T> Result2 = Result0;
+        TVector<T> Result3 = Result0;
+
+        UInt64 Index = 0;
+        for (; Index + 4 * Width<T> <= Size; Index += 4 * Width<T>)
+        {
+            Result0 = Add<T>(Result0, Multiply<T>(Load<T>(Lhs + Index), Load<T>(Rhs + Index)));
+            Result1 = Add<T>(Result1, Multiply<T>(Load<T>(Lhs + Index + Width<T>), Load<T>(Rhs + Index + Width<T>)));
+            Result2 = Add<T>(Result2, Multiply<T>(Load<T>(Lhs + Index + 2 * Width<T>), Load<T>(Rhs + Index + 2 * Width<T>)));
+            Result3 = Add<T>(Result3, Multiply<T>(Load<T>(Lhs + Index + 3 * Width<T>), Load<T>(Rhs + Index + 3 * Width<T>)));
+        }
+
+        for (; Index + Width<T> <= Size; Index += Width<T>)
+        {
+            Result0 = Add<T>(Result0, Multiply<T>(Load<T>(Lhs + Index), Load<T>(Rhs + Index)));
+        }
+
+        T Lanes[Width<T>];
+        Store<T>(Lanes, Add<T>(Add<T>(Result0, Result1), Add<T>(Result2, Result3)));
+
+        const T Result = _SimdImpl::ScalarReduce<EReduce::Sum>(Lanes, Width<T>, T(0));
+        return _SimdImpl::ScalarDot(Lhs + Index, Rhs + Index, Size - Index, Result);
+    }
+};
+
+struct _SimdAVX2
+{
+    typedef _SimdImpl::EReduce EReduce;
+
+    template<typename T, typename TDummy = Void>
+    struct TVectorType
+    {
+        typedef __m256i Type;
+    };
+
+    template<typename TDummy>
+    struct TVectorType<Float, TDummy>
+    {
+        typedef __m256 Type;
+    };
+
+    template<typename TDummy>
+    struct TVectorType<Double, TDummy>
+    {
+        typedef __m256d Type;
+    };
+
+    template<typename T>
+    using TVector = typename TVectorType<T>::Type;
+
+    template<typename T>
+    static constexpr UInt32 Width = UInt32(sizeof(__m256i) / sizeof(T));
+
+    template<typename T>
+    static constexpr UInt32 MaskBits = UInt32(sizeof(T));
+
+    template<typename T>
+    static constexpr Bool HasMinMax = true;
+
+    template<typename T>
+    static constexpr Bool HasMultiply = std::is_floating_point<T>::value || (sizeof(T) == 2) || (sizeof(T) == 4);
+
+    template<typename T>
+    static SIMD_TARGET("avx2") TVector<T> Load(const T* Data) noexcept
+    {
+        if constexpr (std::is_same<T, Float>::value)
+        {
+            return _mm256_loadu_ps(Data);
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            return _mm256_loadu_pd(Data);
+        }
+        else
+        {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Data));
+        }
+    }
+
+    template<typename T>
+    static SIMD_TARGET("avx2") void Store(T* Data, TVector<T> Vector) noexcept
+    {
+        if constexpr (std::is_same<T, Float>::value)
+        {
+            _mm256_storeu_ps(Data, Vector);
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            _mm256_storeu_pd(Data, Vector);
+        }
+        else
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(Data), Vector);
+        }
+    }
+
+    template<typename T>
+    static SIMD_TARGET("avx2") TVector<T> Set1(T Value) noexcept
+    {
+        if constexpr (std::is_same<T, Float>::value)
+        {
+            return _mm256_set1_ps(Value);
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            return _mm256_set1_pd(Value);
+        }
+        else if constexpr (sizeof(T) == 1)
+        {
+            return _mm256_set1_epi8(Int8(Value));
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            return _mm256_set1_epi16(Int16(Value));
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            return _mm256_set1_epi32(Int32(Value));
+        }
+        else
+        {
+            return _mm256_set1_epi64x(Int64(Value));
+        }
+    }
+
+    // All bytes of the equal elements are set
+    template<typename T>
+    static SIMD_TARGET("avx2") __m256i Equal(TVector<T> Lhs, TVector<T> Rhs) noexcept
+    {
+        if constexpr (std::is_same<T, Float>::value)
+        {
+            return _mm256_castps_si256(_mm256_cmp_ps(Lhs, Rhs, _CMP_EQ_OQ));
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            return _mm256_castpd_si256(_mm256_cmp_pd(Lhs, Rhs, _CMP_EQ_OQ));
+        }
+        else if constexpr (sizeof(T) == 1)
+        {
+            return _mm256_cmpeq_epi8(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            return _mm256_cmpeq_epi16(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            return _mm256_cmpeq_epi32(Lhs, Rhs);
+        }
+        else
+        {
+            return _mm256_cmpeq_epi64(Lhs, Rhs);
+        }
+    }
+
+    template<typename T>
+    static SIMD_TARGET("avx2") UInt64 EqualMask(TVector<T> Lhs, TVector<T> Rhs) noexcept
+    {
+        return UInt32(_mm256_movemask_epi8(Equal<T>(Lhs, Rhs)));
+    }
+
+    // Only needed for 64-bit elements, the smaller ones have min and max instructions
+    template<typename T>
+    static SIMD_TARGET("avx2") __m256i Greater(__m256i Lhs, __m256i Rhs) noexcept
+    {
+        if constexpr (!std::is_signed<T>::value)
+        {
+            const __m256i Bias = _mm256_set1_epi64x(std::numeric_limits<Int64>::min());
+            return _mm256_cmpgt_epi64(_mm256_xor_si256(Lhs, Bias), _mm256_xor_si256(Rhs, Bias));
+        }
+        else
+        {
+            return _mm256_cmpgt_epi64(Lhs, Rhs);
+        }
+    }
+
+    template<typename T>
+    static SIMD_TARGET("avx2") TVector<T> Add(TVector<T> Lhs, TVector<T> Rhs) noexcept
+    {
+        if constexpr (std::is_same<T, Float>::value)
+        {
+            return _mm256_add_ps(Lhs, Rhs);
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            return _mm256_add_pd(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 1)
+        {
+            return _mm256_add_epi8(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            return _mm256_add_epi16(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            return _mm256_add_epi32(Lhs, Rhs);
+        }
+        else
+        {
+            return _mm256_add_epi64(Lhs, Rhs);
+        }
+    }
+
+    template<typename T>
+    static SIMD_TARGET("avx2") TVector<T> Multiply(TVector<T> Lhs, TVector<T> Rhs) noexcept
+    {
+        static_assert(HasMultiply<T>, "No AVX2 multiply for this type");
+
+        if constexpr (std::is_same<T, Float>::value)
+        {
+            return _mm256_mul_ps(Lhs, Rhs);
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            return _mm256_mul_pd(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            return _mm256_mullo_epi16(Lhs, Rhs);
+        }
+        else
+        {
+            return _mm256_mullo_epi32(Lhs, Rhs);
+        }
+    }
+
+    template<EReduce Op, typename T>
+    static SIMD_TARGET("avx2") TVector<T> Combine(TVector<T> Lhs, TVector<T> Rhs) noexcept
+    {
+        constexpr Bool IsMin = (Op == EReduce::Min);
+        if constexpr (Op == EReduce::Sum)
+        {
+            return Add<T>(Lhs, Rhs);
+        }
+        else if constexpr (std::is_same<T, Float>::value)
+        {
+            return IsMin ? _mm256_min_ps(Lhs, Rhs) : _mm256_max_ps(Lhs, Rhs);
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            return IsMin ? _mm256_min_pd(Lhs, Rhs) : _mm256_max_pd(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 1)
+        {
+            if constexpr (std::is_signed<T>::value)
+            {
+                return IsMin ? _mm256_min_epi8(Lhs, Rhs) : _mm256_max_epi8(Lhs, Rhs);
+            }
+            else
+            {
+                return IsMin ? _mm256_min_epu8(Lhs, Rhs) : _mm256_max_epu8(Lhs, Rhs);
+            }
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            if constexpr (std::is_signed<T>::value)
+            {
+                return IsMin ? _mm256_min_epi16(Lhs, Rhs) : _mm256_max_epi16(Lhs, Rhs);
+            }
+            else
+            {
+                return IsMin ? _mm256_min_epu16(Lhs, Rhs) : _mm256_max_epu16(Lhs, Rhs);
+            }
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            if constexpr (std::is_signed<T>::value)
+            {
+                return IsMin ? _mm256_min_epi32(Lhs, Rhs) : _mm256_max_epi32(Lhs, Rhs);
+            }
+            else
+            {
+                return IsMin ? _mm256_min_epu32(Lhs, Rhs) : _mm256_max_epu32(Lhs, Rhs);
+            }
+        }
+        else
+        {
+            // Blend takes the second operand where the mask is set
+            const __m256i IsGreater = Greater<T>(Lhs, Rhs);
+            return IsMin ? _mm256_blendv_epi8(Lhs, Rhs, IsGreater) : _mm256_blendv_epi8(Rhs, Lhs, IsGreater);
+        }
+    }
+
+    template<typename T>
+    static SIMD_TARGET("avx2") UInt64 IndexOf(const T* Data, UInt64 Size, T Value) noexcept
+    {
+        const TVector<T> Needle = Set1<T>(Value);
+
+        UInt64 Index = 0;
+        for (; Index + Width<T> <= Size; Index += Width<T>)
+        {
+            const UInt64 Mask = EqualMask<T>(Load<T>(Data + Index), Needle);
+            if (Mask)
+            {
+                return Index + _SimdImpl::CountTrailingZeros(Mask) / MaskBits<T>;
+            }
+        }
+
+        return Index + _SimdImpl::ScalarIndexOf(Data + Index, Size - Index, Value);
+    }
+
+    // Subtracting the compare results counts the equal bytes, the counters are summed before they can overflow
+    template<typename T>
+    static SIMD_TARGET("avx2") UInt64 Count(const T* Data, UInt64 Size, T Value) noexcept
+    {
+        const TVector<T> Needle = Set1<T>(Value);
+        const __m256i    Zero   = _mm256_setzero_si256();
+
+        __m256i Totals = Zero;
+        UInt64  Index  = 0;
+        while (Index + Width<T> <= Size)
+        {
+            __m256i Counters = Zero;
+            for (UInt32 Step = 0; Step < 255 && Index + Width<T> <= Size; Step++, Index += Width<T>)
+            {
+                Counters = _mm256_sub_epi8(Counters, Equal<T>(Load<T>(Data + Index), Needle));
+            }
+
+            Totals = _mm256_add_epi64(Totals, _mm256_sad_epu8(Counters, Zero));
+        }
+
+        UInt64 Lanes[sizeof(__m256i) / sizeof(UInt64)];
+        Store<UInt64>(Lanes, Totals);
+
+        const UInt64 Count = _SimdImpl::ScalarReduce<EReduce::Sum>(Lanes, sizeof(__m256i) / sizeof(UInt64), UInt64(0));
+        return (Count / sizeof(T)) + _SimdImpl::ScalarCount(Data + Index, Size - Index, Value);
+    }
+
+    template<EReduce Op, typename T>
+    static SIMD_TARGET("avx2") T Reduce(const T* Data, UInt64 Size, T Init) noexcept
+    {
+        TVector<T> Result0 = Set1<T>(Init);
+        TVector<T> Result1 = Result0;
+        TVector<T> Result2 = Result0;
+        TVector<T> Result3 = Result0;
+
+        UInt64 Index = 0;
+        for (; Index + 4 * Width<T> <= Size; Index += 4 * Width<T>)
+        {
+            Result0 = Combine<Op, T>(Result0, Load<T>(Data + Index));
+            Result1 = Combine<Op, T>(Result1, Load<T>(Data + Index + Width<T>));
+            Result2 = Combine<Op, T>(Result2, Load<T>(Data + Index + 2 * Width<T>));
+            Result3 = Combine<Op, T>(Result3, Load<T>(Data + Index + 3 * Width<T>));
+        }
+
+        for (; Index + Width<T> <= Size; Index += Width<T>)
+        {
+            Result0 = Combine<Op, T>(Result0, Load<T>(Data + Index));
+        }
+
+        T Lanes[Width<T>];
+        Store<T>(Lanes, Combine<Op, T>(Combine<Op, T>(Result0, Result1), Combine<Op, T>(Result2, Result3)));
+
+        const T Result = _SimdImpl::ScalarReduce<Op>(Lanes, Width<T>, Init);
+        return _SimdImpl::ScalarReduce<Op>(Data + Index, Size - Index, Result);
+    }
+
+    template<typename T>
+    static SIMD_TARGET("avx2") T Dot(const T* Lhs, const T* Rhs, UInt64 Size) noexcept
+    {
+        TVector<T> Result0 = Set1<T>(T(0));
+        TVector<T> Result1 = Result0;
+        TVector<T> Result2 = Result0;
+        TVector<T> Result3 = Result0;
+
+        UInt64 Index = 0;
+        for (; Index + 4 * Width<T> <= Size; Index += 4 * Width<T>)
+        {
+            Result0 = Add<T>(Result0, Multiply<T>(Load<T>(Lhs + Index), Load<T>(Rhs + Index)));
+            Result1 = Add<T>(Result1, Multiply<T>(Load<T>(Lhs + Index + Width<T>), Load<T>(Rhs + Index + Width<T>)));
+            Result2 = Add<T>(Result2, Multiply<T>(Load<T>(Lhs + Index + 2 * Width<T>), Load<T>(Rhs + Index + 2 * Width<T>)));
+            Result3 = Add<T>(Result3, Multiply<T>(Load<T>(Lhs + Index + 3 * Width<T>), Load<T>(Rhs + Index + 3 * Width<T>)));
+        }
+
+        for (; Index + Width<T> <= Size; Index += Width<T>)
+        {
+            Result0 = Add<T>(Result0, Multiply<T>(Load<T>(Lhs + Index), Load<T>(Rhs + Index)));
+        }
+
+        T Lanes[Width<T>];
+        Store<T>(Lanes, Add<T>(Add<T>(Result0, Result1), Add<T>(Result2, Result3)));
+
+        const T Result = _SimdImpl::ScalarReduce<EReduce::Sum>(Lanes, Width<T>, T(0));
+        return _SimdImpl::ScalarDot(Lhs + Index, Rhs + Index, Size - Index, Result);
+    }
+};
+
+struct _SimdAVX512
+{
+    typedef _SimdImpl::EReduce EReduce;
+
+    template<typename T, typename TDummy = Void>
+    struct TVectorType
+    {
+        typedef __m512i Type;
+    };
+
+    template<typename TDummy>
+    struct TVectorType<Float, TDummy>
+    {
+        typedef __m512 Type;
+    };
+
+    template<typename TDummy>
+    struct TVectorType<Double, TDummy>
+    {
+        typedef __m512d Type;
+    };
+
+    template<typename T>
+    using TVector = typename TVectorType<T>::Type;
+
+    template<typename T>
+    static constexpr UInt32 Width = UInt32(sizeof(__m512i) / sizeof(T));
+
+    // Compares return one bit per element
+    template<typename T>
+    static constexpr UInt32 MaskBits = 1;
+
+    template<typename T>
+    static constexpr Bool HasMinMax = true;
+
+    template<typename T>
+    static constexpr Bool HasMultiply = std::is_floating_point<T>::value || (sizeof(T) > 1);
+
+    template<typename T>
+    static SIMD_TARGET("avx512f,avx512bw,avx512dq,popcnt") TVector<T> Load(const T* Data) noexcept
+    {
+        if constexpr (std::is_same<T, Float>::value)
+        {
+            return _mm512_loadu_ps(Data);
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            return _mm512_loadu_pd(Data);
+        }
+        else
+        {
+            return _mm512_loadu_si512(reinterpret_cast<const void*>(Data));
+        }
+    }
+
+    template<typename T>
+    static SIMD_TARGET("avx512f,avx512bw,avx512dq,popcnt") void Store(T* Data, TVector<T> Vector) noexcept
+    {
+        if constexpr (std::is_same<T, Float>::value)
+        {
+            _mm512_storeu_ps(Data, Vector);
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            _mm512_storeu_pd(Data, Vector);
+        }
+        else
+        {
+            _mm512_storeu_si512(reinterpret_cast<void*>(Data), Vector);
+        }
+    }
+
+    template<typename T>
+    static SIMD_TARGET("avx512f,avx512bw,avx512dq,popcnt") TVector<T> Set1(T Value) noexcept
+    {
+        if constexpr (std::is_same<T, Float>::value)
+        {
+            return _mm512_set1_ps(Value);
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            return _mm512_set1_pd(Value);
+        }
+        else if constexpr (sizeof(T) == 1)
+        {
+            return _mm512_set1_epi8(Int8(Value));
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            return _mm512_set1_epi16(Int16(Value));
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            return _mm512_set1_epi32(Int32(Value));
+        }
+        else
+        {
+            return _mm512_set1_epi64(Int64(Value));
+        }
+    }
+
+    template<typename T>
+    static SIMD_TARGET("avx512f,avx512bw,avx512dq,popcnt") UInt64 EqualMask(TVector<T> Lhs, TVector<T> Rhs) noexcept
+    {
+        if constexpr (std::is_same<T, Float>::value)
+        {
+            return _mm512_cmp_ps_mask(Lhs, Rhs, _CMP_EQ_OQ);
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            return _mm512_cmp_pd_mask(Lhs, Rhs, _CMP_EQ_OQ);
+        }
+        else if constexpr (sizeof(T) == 1)
+        {
+            return _mm512_cmpeq_epi8_mask(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            return _mm512_cmpeq_epi16_mask(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            return _mm512_cmpeq_epi32_mask(Lhs, Rhs);
+        }
+        else
+        {
+            return _mm512_cmpeq_epi64_mask(Lhs, Rhs);
+        }
+    }
+
+    template<typename T>
+    static SIMD_TARGET("avx512f,avx512bw,avx512dq,popcnt") TVector<T> Add(TVector<T> Lhs, TVector<T> Rhs) noexcept
+    {
+        if constexpr (std::is_same<T, Float>::value)
+        {
+            return _mm512_add_ps(Lhs, Rhs);
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            return _mm512_add_pd(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 1)
+        {
+            return _mm512_add_epi8(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            return _mm512_add_epi16(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            return _mm512_add_epi32(Lhs, Rhs);
+        }
+        else
+        {
+            return _mm512_add_epi64(Lhs, Rhs);
+        }
+    }
+
+    template<typename T>
+    static SIMD_TARGET("avx512f,avx512bw,avx512dq,popcnt") TVector<T> Multiply(TVector<T> Lhs, TVector<T> Rhs) noexcept
+    {
+        static_assert(HasMultiply<T>, "No AVX-512 multiply for this type");
+
+        if constexpr (std::is_same<T, Float>::value)
+        {
+            return _mm512_mul_ps(Lhs, Rhs);
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            return _mm512_mul_pd(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            return _mm512_mullo_epi16(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            return _mm512_mullo_epi32(Lhs, Rhs);
+        }
+        else
+        {
+            return _mm512_mullo_epi64(Lhs, Rhs);
+        }
+    }
+
+    template<EReduce Op, typename T>
+    static SIMD_TARGET("avx512f,avx512bw,avx512dq,popcnt") TVector<T> Combine(TVector<T> Lhs, TVector<T> Rhs) noexcept
+    {
+        constexpr Bool IsMin = (Op == EReduce::Min);
+        if constexpr (Op == EReduce::Sum)
+        {
+            return Add<T>(Lhs, Rhs);
+        }
+        else if constexpr (std::is_same<T, Float>::value)
+        {
+            return IsMin ? _mm512_min_ps(Lhs, Rhs) : _mm512_max_ps(Lhs, Rhs);
+        }
+        else if constexpr (std::is_same<T, Double>::value)
+        {
+            return IsMin ? _mm512_min_pd(Lhs, Rhs) : _mm512_max_pd(Lhs, Rhs);
+        }
+        else if constexpr (sizeof(T) == 1)
+        {
+            if constexpr (std::is_signed<T>::value)
+            {
+                return IsMin ? _mm512_min_epi8(Lhs, Rhs) : _mm512_max_epi8(Lhs, Rhs);
+            }
+            else
+            {
+                return IsMin ? _mm512_min_epu8(Lhs, Rhs) : _mm512_max_epu8(Lhs, Rhs);
+            }
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            if constexpr (std::is_signed<T>::value)
+            {
+                return IsMin ? _mm512_min_epi16(Lhs, Rhs) : _mm512_max_epi16(Lhs, Rhs);
+            }
+            else
+            {
+                return IsMin ? _mm512_min_epu16(Lhs, Rhs) : _mm512_max_epu16(Lhs, Rhs);
+            }
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            if constexpr (std::is_signed<T>::value)
+            {
+                return IsMin ? _mm512_min_epi32(Lhs, Rhs) : _mm512_max_epi32(Lhs, Rhs);
+            }
+            else
+            {
+                return IsMin ? _mm512_min_epu32(Lhs, Rhs) : _mm512_max_epu32(Lhs, Rhs);
+            }
+        }
+        else
+        {
+            if constexpr (std::is_signed<T>::value)
+            {
+                return IsMin ? _mm512_min_epi64(Lhs, Rhs) : _mm512_max_epi64(Lhs, Rhs);
+            }
+            else
+            {
+                return IsMin ? _mm512_min_epu64(Lhs, Rhs) : _mm512_max_epu64(Lhs, Rhs);
+            }
+        }
+    }
+
+    template<typename T>
+    static SIMD_TARGET("avx512f,avx512bw,avx512dq,popcnt") UInt64 IndexOf(const T* Data, UInt64 Size, T Value) noexcept
+    {
+        const TVector<T> Needle = Set1<T>(Value);
+
+        UInt64 Index = 0;
+        for (; Index + Width<T> <= Size; Index += Width<T>)
+        {
+            const UInt64 Mask = EqualMask<T>(Load<T>(Data + Index), Needle);
+            if (Mask)
+            {
+                return Index + _SimdImpl::CountTrailingZeros(Mask) / MaskBits<T>;
+            }
+        }
+
+        return Index + _SimdImpl::ScalarIndexOf(Data + Index, Size - Index, Value);
+    }
+
+    template<typename T>
+    static SIMD_TARGET("avx512f,avx512bw,avx512dq,popcnt") UInt64 Count(const T* Data, UInt64 Size, T Value) noexcept
+    {
+        const TVector<T> Needle = Set1<T>(Value);
+
+        UInt64 Count = 0;
+        UInt64 Index = 0;
+        for (; Index + Width<T> <= Size; Index += Width<T>)
+        {
+            Count += _SimdImpl::PopCount(EqualMask<T>(Load<T>(Data + Index), Needle));
+        }
+
+        return (Count / MaskBits<T>) + _SimdImpl::ScalarCount(Data + Index, Size - Index, Value);
+    }
+
+    template<EReduce Op, typename T>
+    static SIMD_TARGET("avx512f,avx512bw,avx512dq,popcnt") T Reduce(const T* Data, UInt64 Size, T Init) noexcept
+    {
+        TVector<T> Result0 = Set1<T>(Init);
+        TVector<T> Result1 = Result0;
+        TVector<T> Result2 = Result0;
+        TVector<T> Result3 = Result0;
+
+        UInt64 Index = 0;
+        for (; Index + 4 * Width<T> <= Size; Index += 4 * Width<T>)
+        {
+            Result0 = Combine<Op, T>(Result0, Load<T>(Data + Index));
+            Result1 = Combine<Op, T>(Result1, Load<T>(Data + Index + Width<T>));
+            Result2 = Combine<Op, T>(Result2, Load<T>(Data + Index + 2 * Width<T>));
+            Result3 = Combine<Op, T>(Result3, Load<T>(Data + Index + 3 * Width<T>));
+        }
+
+        for (; Index + Width<T> <= Size; Index += Width<T>)
+        {
+            Result0 = Combine<Op, T>(Result0, Load<T>(Data + Index));
+        }
+
+        T Lanes[Width<T>];
+        Store<T>(Lanes, Combine<Op, T>(Combine<Op, T>(Result0, Result1), Combine<Op, T>(Result2, Result3)));
+
+        const T Result = _SimdImpl::ScalarReduce<Op>(Lanes, Width<T>, Init);
+        return _SimdImpl::ScalarReduce<Op>(Data + Index, Size - Index, Result);
+    }
+
+    template<typename T>
+    static SIMD_TARGET("avx512f,avx512bw,avx512dq,popcnt") T Dot(const T* Lhs, const T* Rhs, UInt64 Size) noexcept
+    {
+        TVector<T> Result0 = Set1<T>(T(0));
+        TVector<T> Result1 = Result0;
+        TVector<T> Result2 = Result0;
+        TVector<T> Result3 = Result0;
+
+        UInt64 Index = 0;
+        for (; Index + 4 * Width<T> <= Size; Index += 4 * Width<T>)
+        {
+            Result0 = Add<T>(Result0, Multiply<T>(Load<T>(Lhs + Index), Load<T>(Rhs + Index)));
+            Result1 = Add<T>(Result1, Multiply<T>(Load<T>(Lhs + Index + Width<T>), Load<T>(Rhs + Index + Width<T>)));
+            Result2 = Add<T>(Result2, Multiply<T>(Load<T>(Lhs + Index + 2 * Width<T>), Load<T>(Rhs + Index + 2 * Width<T>)));
+            Result3 = Add<T>(Result3, Multiply<T>(Load<T>(Lhs + Index + 3 * Width<T>), Load<T>(Rhs + Index + 3 * Width<T>)));
+        }
+
+        for (; Index + Width<T> <= Size; Index += Width<T>)
+        {
+            Result0 = Add<T>(Result0, Multiply<T>(Load<T>(Lhs + Index), Load<T>(Rhs + Index)));
+        }
+
+        T Lanes[Width<T>];
+        Store<T>(Lanes, Add<T>(Add<T>(Result0, Result1), Add<T>(Result2, Result3)));
+
+        const T Result = _SimdImpl::ScalarReduce<EReduce::Sum>(Lanes, Width<T>, T(0));
+        return _SimdImpl::ScalarDot(Lhs + Index, Rhs + Index, Size - Index, Result);
+    }
+};
+
+#endif // ALGORITHMS_USE_SIMD
+
+template<typename T>
+inline UInt64 _SimdImpl::IndexOf(const T* Data, UInt64 Size, const T& Value) noexcept
+{
+#if ALGORITHMS_USE_SIMD
+    if constexpr (IsVectorizable<T>)
+    {
+        switch (GetLevel())
+        {
+            case ESimdLevel::AVX512: return _SimdAVX512::IndexOf(Data, Size, Value);
+            case ESimdLevel::AVX2:   return _SimdAVX2::IndexOf(Data, Size, Value);
+            case ESimdLevel::SSE2:   return _SimdSSE2::IndexOf(Data, Size, Value);
+            default: break;
+        }
+    }
+#endif
+
+    return ScalarIndexOf(Data, Size, Value);
+}
+
+template<typename T>
+inline UInt64 _SimdImpl::Count(const T* Data, UInt64 Size, const T& Value) noexcept
+{
+#if ALGORITHMS_USE_SIMD
+    if constexpr (IsVectorizable<T>)
+    {
+        switch (GetLevel())
+        {
+            case ESimdLevel::AVX512: return _SimdAVX512::Count(Data, Size, Value);
+            case ESimdLevel::AVX2:   return _SimdAVX2::Count(Data, Size, Value);
+            case ESimdLevel::SSE2:   return _SimdSSE2::Count(Data, Size, Value);
+            default: break;
+        }
+    }
+#endif
+
+    return ScalarCount(Data, Size, Value);
+}
+
+template<_SimdImpl::EReduce Op, typename T>
+inline T _SimdImpl::Reduce(const T* Data, UInt64 Size, T Init) noexcept
+{
+#if ALGORITHMS_USE_SIMD
+    if constexpr (IsVectorizable<T>)
+    {
+        switch (GetLevel())
+        {
+            case ESimdLevel::AVX512: return _SimdAVX512::Reduce<Op>(Data, Size, Init);
+            case ESimdLevel::AVX2:   return _SimdAVX2::Reduce<Op>(Data, Size, Init);
+            case ESimdLevel::SSE2:
+            {
+                if constexpr (Op == EReduce::Sum || _SimdSSE2::HasMinMax<T>)
+                {
+                    return _SimdSSE2::Reduce<Op>(Data, Size, Init);
+                }
+
+                break;
+            }
+
+            default: break;
+        }
+    }
+#endif
+
+    return ScalarReduce<Op>(Data, Size, Init);
+}
+
+template<typename T>
+inline T _SimdImpl::Dot(const T* Lhs, const T* Rhs, UInt64 Size) noexcept
+{
+#if ALGORITHMS_USE_SIMD
+    if constexpr (IsVectorizable<T>)
+    {
+        switch (GetLevel())
+        {
+            case ESimdLevel::AVX512:
+            {
+                if constexpr (_SimdAVX512::HasMultiply<T>)
+                {
+                    return _SimdAVX512::Dot(Lhs, Rhs, Size);
+                }
+
+                break;
+            }
+
+            case ESimdLevel::AVX2:
+            {
+                if constexpr (_SimdAVX2::HasMultiply<T>)
+                {
+                    return _SimdAVX2::Dot(Lhs, Rhs, Size);
+                }
+
+                break;
+            }
+
+            case ESimdLevel::SSE2:
+            {
+                if constexpr (_SimdSSE2::HasMultiply<T>)
+                {
+                    return _SimdSSE2::Dot(Lhs, Rhs, Size);
+                }
+
+                break;
+            }
+
+            default: break;
+        }
+    }
+#endif
+
+    return ScalarDot(Lhs, Rhs, Size, T());
+}
+
+/*
+ * SIMD level - The highest level the CPU supports is used by default, SetSimdLevel lowers it to compare the
+ * instruction sets. Setting the level is not thread-safe.
+ */
+
+inline ESimdLevel GetSupportedSimdLevel() noexcept
+{
+    return _SimdImpl::GetSupportedLevel();
+}
+
+inline ESimdLevel GetSimdLevel() noexcept
+{
+    return _SimdImpl::GetLevel();
+}
+
+// Levels above the supported level are clamped
+inline void SetSimdLevel(ESimdLevel Level) noexcept
+{
+    _SimdImpl::GetLevel() = (UInt8(Level) < UInt8(GetSupportedSimdLevel())) ? Level : GetSupportedSimdLevel();
+}
+
+/*
+ * Search - The index of the first element that compares equal to Value, or the size of the view
+ */
+
+template<typename T, typename TSizeType>
+inline TSizeType IndexOf(TArrayView<T, TSizeType> View, const std::remove_const_t<T>& Value) noexcept
+{
+    return TSizeType(_SimdImpl::IndexOf<std::remove_const_t<T>>(View.Data(), View.Size(), Value));
+}
+
+template<typename T, typename TSizeType>
+inline T* Find(TArrayView<T, TSizeType> View, const std::remove_const_t<T>& Value) noexcept
+{
+    const TSizeType Index = IndexOf(View, Value);
+    return (Index != View.Size()) ? View.Data() + Index : nullptr;
+}
+
+template<typename T, typename TSizeType>
+inline Bool Contains(TArrayView<T, TSizeType> View, const std::remove_const_t<T>& Value) noexcept
+{
+    return (IndexOf(View, Value) != View.Size());
+}
+
+template<typename T, typename TSizeType>
+inline TSizeType Count(TArrayView<T, TSizeType> View, const std::remove_const_t<T>& Value) noexcept
+{
+    return TSizeType(_SimdImpl::Count<std::remove_const_t<T>>(View.Data(), View.Size(), Value));
+}
+
+/*
+ * Reduction - Min and Max compare with operator<, Sum and Dot add from T() and wrap around for integers
+ */
+
+template<typename T, typename TSizeType>
+inline std::remove_const_t<T> Min(TArrayView<T, TSizeType> View) noexcept
+{
+    VALIDATE(!View.IsEmpty());
+    return _SimdImpl::Reduce<_SimdImpl::EReduce::Min, std::remove_const_t<T>>(View.Data(), View.Size(), View[0]);
+}
+
+template<typename T, typename TSizeType>
+inline std::remove_const_t<T> Max(TArrayView<T, TSizeType> View) noexcept
+{
+    VALIDATE(!View.IsEmpty());
+    return _SimdImpl::Reduce<_SimdImpl::EReduce::Max, std::remove_const_t<T>>(View.Data(), View.Size(), View[0]);
+}
+
+// The index of the first smallest element, vectorized types find the minimum and then search for it
+template<typename T, typename TSizeType>
+inline TSizeType ArgMin(TArrayView<T, TSizeType> View) noexcept
+{
+    VALIDATE(!View.IsEmpty());
+
+    if constexpr (_SimdImpl::IsVectorizable<std::remove_const_t<T>>)
+    {
+        // A NaN result is never found by IndexOf, those views fall back to the loop
+        const TSizeType Found = IndexOf(View, Min(View));
+        if (Found != View.Size())
+        {
+            return Found;
+        }
+    }
+
+    TSizeType Result = 0;
+    for (TSizeType Index = 1; Index < View.Size(); Index++)
+    {
+        Result = (View[Index] < View[Result]) ? Index : Result;
+    }
+
+    return Result;
+}
+
+template<typename T, typename TSizeType>
+inline TSizeType ArgMax(TArrayView<T, TSizeType> View) noexcept
+{
+    VALIDATE(!View.IsEmpty());
+
+    if constexpr (_SimdImpl::IsVectorizable<std::remove_const_t<T>>)
+    {
+        // A NaN result is never found by IndexOf, those views fall back to the loop
+        const TSizeType Found = IndexOf(View, Max(View));
+        if (Found != View.Size())
+        {
+            return Found;
+        }
+    }
+
+    TSizeType Result = 0;
+    for (TSizeType Index = 1; Index < View.Size(); Index++)
+    {
+        Result = (View[Result] < View[Index]) ? Index : Result;
+    }
+
+    return Result;
+}
+
+template<typename T, typename TSizeType>
+inline std::remove_const_t<T> Sum(TArrayView<T, TSizeType> View) noexcept
+{
+    return _SimdImpl::Reduce<_SimdImpl::EReduce::Sum, std::remove_const_t<T>>(View.Data(), View.Size(), std::remove_const_t<T>());
+}
+
+template<typename T, typename TSizeType>
+inline std::remove_const_t<T> Dot(TArrayView<T, TSizeType> Lhs, TArrayView<T, TSizeType> Rhs) noexcept
+{
+    VALIDATE(Lhs.Size() == Rhs.Size());
+    return _SimdImpl::Dot<std::remove_const_t<T>>(Lhs.Data(), Rhs.Data(), Lhs.Size());
+}
+
+/*
+ * TArray overloads
+ */
+
+template<typename T, typename TAllocator, typename TGrowthPolicy, typename... TArgs>
+inline auto IndexOf(const TArray<T, TAllocator, TGrowthPolicy>& Array, TArgs&&... Args) noexcept
+{
+    return IndexOf(TArrayView<const T, typename TArray<T, TAllocator, TGrowthPolicy>::SizeType>(Array), ::Forward<TArgs>(Args)...);
+}
+
+template<typename T, typename TAllocator, typename TGrowthPolicy, typename... TArgs>
+inline T* Find(TArray<T, TAllocator, TGrowthPolicy>& Array, TArgs&&... Args) noexcept
+{
+    return Find(TArrayView<T, typename TArray<T, TAllocator, TGrowthPolicy>::SizeType>(Array), ::Forward<TArgs>(Args)...);
+}
+
+template<typename T, typename TAllocator, typename TGrowthPolicy, typename... TArgs>
+inline const T* Find(const TArray<T, TAllocator, TGrowthPolicy>& Array, TArgs&&... Args) noexcept
+{
+    return Find(TArrayView<const T, typename TArray<T, TAllocator, TGrowthPolicy>::SizeType>(Array), ::Forward<TArgs>(Args)...);
+}
+
+template<typename T, typename TAllocator, typename TGrowthPolicy, typename... TArgs>
+inline Bool Contains(const TArray<T, TAllocator, TGrowthPolicy>& Array, TArgs&&... Args) noexcept
+{
+    return Contains(TArrayView<const T, typename TArray<T, TAllocator, TGrowthPolicy>::SizeType>(Array), ::Forward<TArgs>(Args)...);
+}
+
+template<typename T, typename TAllocator, typename TGrowthPolicy, typename... TArgs>
+inline auto Count(const TArray<T, TAllocator, TGrowthPolicy>& Array, TArgs&&... Args) noexcept
+{
+    return Count(TArrayView<const T, typename TArray<T, TAllocator, TGrowthPolicy>::SizeType>(Array), ::Forward<TArgs>(Args)...);
+}
+
+template<typename T, typename TAllocator, typename TGrowthPolicy>
+inline T Min(const TArray<T, TAllocator, TGrowthPolicy>& Array) noexcept
+{
+    return Min(TArrayView<const T, typename TArray<T, TAllocator, TGrowthPolicy>::SizeType>(Array));
+}
+
+template<typename T, typename TAllocator, typename TGrowthPolicy>
+inline T Max(const TArray<T, TAllocator, TGrowthPolicy>& Array) noexcept
+{
+    return Max(TArrayView<const T, typename TArray<T, TAllocator, TGrowthPolicy>::SizeType>(Array));
+}
+
+template<typename T, typename TAllocator, typename TGrowthPolicy>
+inline auto ArgMin(const TArray<T, TAllocator, TGrowthPolicy>& Array) noexcept
+{
+    return ArgMin(TArrayView<const T, typename TArray<T, TAllocator, TGrowthPolicy>::SizeType>(Array));
+}
+
+template<typename T, typename TAllocator, typename TGrowthPolicy>
+inline auto ArgMax(const TArray<T, TAllocator, TGrowthPolicy>& Array) noexcept
+{
+    return ArgMax(TArrayView<const T, typename TArray<T, TAllocator, TGrowthPolicy>::SizeType>(Array));
+}
+
+template<typename T, typename TAllocator, typename TGrowthPolicy>
+inline T Sum(const TArray<T, TAllocator, TGrowthPolicy>& Array) noexcept
+{
+    return Sum(TArrayView<const T, typename TArray<T, TAllocator, TGrowthPolicy>::SizeType>(Array));
+}
+
+template<typename T, typename TAllocator, typename TGrowthPolicy>
+inline T Dot(const TArray<T, TAllocator, TGrowthPolicy>& Lhs, const TArray<T, TAllocator, TGrowthPolicy>& Rhs) noexcept
+{
+    typedef TArrayView<const T, typename TArray<T, TAllocator, TGrowthPolicy>::SizeType> TView;
+    return Dot(TView(Lhs), TView(Rhs));
+}
@@ -1,17 +1,286 @@
 #pragma once
 #include "Types.h"
 
+#include <cstddef>
 #include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#if defined(__APPLE__)
+    #include <malloc/malloc.h>
+#else
+    #include <malloc.h>
+#endif
+
+/*
+ * Allocators - Allocate and Free are required, Reallocate is optional and lets containers grow a block without a
+ * copy when the allocator can expand it in place or move it more efficiently than the container can. GetUsableSize is
+ * optional and returns the actual size of a block, which may be larger than requested. Sizes are always passed
+ * in bytes as UInt64 together with the alignment of the block, which is a power of two. The same alignment is
+ * passed for every call on a block. An allocator may also define SizeType, which containers use to store their
+ * element counts, see TAllocatorSizeType.
+ */
 
 struct Mallocator
 {
-    void* Allocate(UInt32 Size)
+    // malloc returns blocks that are suitably aligned for any fundamental type
+    static constexpr UInt64 DefaultAlignment = alignof(std::max_align_t);
+
+    void* Allocate(UInt64 Size, UInt64 Alignment)
     {
-        return ::malloc(Size);
+        if (Alignment <= DefaultAlignment)
+        {
+            return ::malloc(static_cast<size_t>(Size));
+        }
+
+#if defined(_WIN32)
+        return ::_aligned_malloc(static_cast<size_t>(Size), static_cast<size_t>(Alignment));
+#else
+        void* Ptr = nullptr;
+        return (::posix_memalign(&Ptr, static_cast<size_t>(Alignment), static_cast<size_t>(Size)) == 0) ? Ptr : nullptr;
+#endif
     }
 
-    void Free(void* Ptr)
+    // Large blocks are served by mmap in most CRTs and grown through the virtual memory system (mremap on Linux),
+    // so the data is never copied and the old and new block never exist at the same time
+    void* Reallocate(void* Ptr, UInt64 Size, UInt64 Alignment)
     {
+        if (Alignment <= DefaultAlignment)
+        {
+            return ::realloc(Ptr, static_cast<size_t>(Size));
+        }
+
+#if defined(_WIN32)
+        return ::_aligned_realloc(Ptr, static_cast<size_t>(Size), static_cast<size_t>(Alignment));
+#else
+        // realloc does not keep the alignment of posix_memalign blocks
+        void* NewPtr = Allocate(Size, Alignment);
+        if (Ptr && NewPtr)
+        {
+            const UInt64 OldSize = GetUsableSize(Ptr, Alignment);
+            ::memcpy(NewPtr, Ptr, static_cast<size_t>((OldSize < Size) ? OldSize : Size));
+            Free(Ptr, Alignment);
+        }
+
+        return NewPtr;
+#endif
+    }
+
+    UInt64 GetUsableSize(void* Ptr, UInt64 Alignment) const
+    {
+#if defined(_WIN32)
+        return (Alignment <= DefaultAlignment) ? ::_msize(Ptr) : ::_aligned_msize(Ptr, static_cast<size_t>(Alignment), 0);
+#elif defined(__APPLE__)
+        (void)Alignment;
+        return ::malloc_size(Ptr);
+#else
+        (void)Alignment;
+        return ::malloc_usable_size(Ptr);
+#endif
+    }
+
+    void Free(void* Ptr, UInt64 Alignment)
+    {
+#if defined(_WIN32)
+        if (Alignment > DefaultAlignment)
+        {
+            ::_aligned_free(Ptr);
+            return;
+        }
+#else
+        (void)Alignment;
+#endif
         ::free(Ptr);
     }
-};
\ No newline at end of file
+};
+
+/*
+ * TAllocatorSizeType - The SizeType of an allocator or UInt32 if it does not define one
+ */
+
+template<typename TAllocator, typename = Void>
+struct _TAllocatorSizeType
+{
+    typedef UInt32 Type;
+};
+
+template<typename TAllocator>
+struct _TAllocatorSizeType<TAllocator, std::void_t<typename TAllocator::SizeType>>
+{
+    typedef typename TAllocator::SizeType Type;
+};
+
+template<typename TAllocator>
+using TAllocatorSizeType = typename _TAllocatorSizeType<TAllocator>::Type;
+
+/*
+ * TInlineAllocator - Serves allocations that fit NumElements of T from storage inside the allocator itself, larger
+ * or more aligned allocations are forwarded to the secondary allocator. Containers must relocate the elements instead of
+ * stealing the block when they are moved, see IsInlineAllocation.
+ */
+
+template<typename T, UInt32 NumElements, typename TSecondaryAllocator = Mallocator>
+struct TInlineAllocator
+{
+    typedef TAllocatorSizeType<TSecondaryAllocator> SizeType;
+
+    TInlineAllocator() noexcept
+        : mSecondaryAllocator()
+    {
+    }
+
+    // The inline storage belongs to each instance and is never copied
+    TInlineAllocator(const TInlineAllocator& Other) noexcept
+        : mSecondaryAllocator(Other.mSecondaryAllocator)
+    {
+    }
+
+    void* Allocate(UInt64 Size, UInt64 Alignment)
+    {
+        if (Size <= sizeof(mInlineStorage) && Alignment <= alignof(T))
+        {
+            return reinterpret_cast<void*>(mInlineStorage);
+        }
+
+        return mSecondaryAllocator.Allocate(Size, Alignment);
+    }
+
+    template<typename TBase = TSecondaryAllocator, typename = std::void_t<decltype(std::declval<const TBase&>().GetUsableSize(nullptr, 0))>>
+    UInt64 GetUsableSize(void* Ptr, UInt64 Alignment) const
+    {
+        return IsInlineAllocation(Ptr) ? sizeof(mInlineStorage) : mSecondaryAllocator.GetUsableSize(Ptr, Alignment);
+    }
+
+    void Free(void* Ptr, UInt64 Alignment)
+    {
+        if (!IsInlineAllocation(Ptr))
+        {
+            mSecondaryAllocator.Free(Ptr, Alignment);
+        }
+    }
+
+    Bool IsInlineAllocation(const void* Ptr) const noexcept
+    {
+        return (Ptr == reinterpret_cast<const void*>(mInlineStorage));
+    }
+
+    TInlineAllocator& operator=(const TInlineAllocator& Other) noexcept
+    {
+        mSecondaryAllocator = Other.mSecondaryAllocator;
+        return *this;
+    }
+
+private:
+    alignas(T) Byte mInlineStorage[sizeof(T) * NumElements];
+    TSecondaryAllocator mSecondaryAllocator;
+};
+
+/*
+ * TSizedAllocator - Overrides the SizeType of an allocator, UInt64 allows containers larger than 4G elements
+ * while UInt16 shrinks the container header
+ */
+
+template<typename TSizeType, typename TAllocator = Mallocator>
+struct TSizedAllocator : public TAllocator
+{
+    static_assert(std::is_unsigned<TSizeType>(), "SizeType must be an unsigned integer");
+
+    typedef TSizeType SizeType;
+};
+
+/*
+ * TAlignedAllocator - Raises the alignment of every block to at least MinAlignment, for example to a cache line or
+ * to the width of a SIMD register
+ */
+
+template<UInt64 MinAlignment, typename TAllocator = Mallocator>
+struct TAlignedAllocator : public TAllocator
+{
+    static_assert((MinAlignment & (MinAlignment - 1)) == 0, "MinAlignment must be a power of two");
+
+    void* Allocate(UInt64 Size, UInt64 Alignment)
+    {
+        return TAllocator::Allocate(Size, GetAlignment(Alignment));
+    }
+
+    template<typename TBase = TAllocator, typename = std::void_t<decltype(std::declval<TBase&>().Reallocate(nullptr, 0, 0))>>
+    void* Reallocate(void* Ptr, UInt64 Size, UInt64 Alignment)
+    {
+        return TBase::Reallocate(Ptr, Size, GetAlignment(Alignment));
+    }
+
+    template<typename TBase = TAllocator, typename = std::void_t<decltype(std::declval<const TBase&>().GetUsableSize(nullptr, 0))>>
+    UInt64 GetUsableSize(void* Ptr, UInt64 Alignment) const
+    {
+        return TBase::GetUsableSize(Ptr, GetAlignment(Alignment));
+    }
+
+    void Free(void* Ptr, UInt64 Alignment)
+    {
+        TAllocator::Free(Ptr, GetAlignment(Alignment));
+    }
+
+private:
+    static constexpr UInt64 GetAlignment(UInt64 Alignment) noexcept
+    {
+        return (Alignment > MinAlignment) ? Alignment : MinAlignment;
+    }
+};
+
+/*
+ * THasReallocate - Checks if an allocator supports Reallocate
+ */
+
+template<typename TAllocator, typename = Void>
+struct _THasReallocate
+{
+    static constexpr Bool Value = false;
+};
+
+template<typename TAllocator>
+struct _THasReallocate<TAllocator, std::void_t<decltype(std::declval<TAllocator&>().Reallocate(nullptr, 0, 0))>>
+{
+    static constexpr Bool Value = true;
+};
+
+template<typename TAllocator>
+inline constexpr Bool THasReallocate = _THasReallocate<TAllocator>::Value;
+
+/*
+ * THasInlineStorage - Checks if an allocator can return storage that is located inside the allocator
+ */
+
+template<typename TAllocator, typename = Void>
+struct _THasInlineStorage
+{
+    static constexpr Bool Value = false;
+};
+
+template<typename TAllocator>
+struct _THasInlineStorage<TAllocator, std::void_t<decltype(std::declval<const TAllocator&>().IsInlineAllocation(nullptr))>>
+{
+    static constexpr Bool Value = true;
+};
+
+template<typename TAllocator>
+inline constexpr Bool THasInlineStorage = _THasInlineStorage<TAllocator>::Value;
+
+/*
+ * THasGetUsableSize - Checks if an allocator can report the usable size of a block
+ */
+
+template<typename TAllocator, typename = Void>
+struct _THasGetUsableSize
+{
+    static constexpr Bool Value = false;
+};
+
+template<typename TAllocator>
+struct _THasGetUsableSize<TAllocator, std::void_t<decltype(std::declval<const TAllocator&>().GetUsableSize(nullptr, 0))>>
+{
+    static constexpr Bool Value = true;
+};
+
+template<typename TAllocator>
+inline constexpr Bool THasGetUsableSize = _THasGetUsableSize<TAllocator>::Value;
@@ -1,13 +1,18 @@
 #pragma once
 #include "Utilities.h"
 #include "Iterator.h"
+#include "ArrayView.h"
 #include "Allocator.h"
+#include "GrowthPolicy.h"
+#include "Fill.h"
 
 #include <initializer_list>
+#include <cstring>
+#include <limits>
 
 // TArray - Dynamic Array similar to std::vector
 
-template<typename T, typename TAllocator = Mallocator>
+template<typename T, typename TAllocator = Mallocator, typename TGrowthPolicy = GeometricGrowth>
 class TArray
 {
 public:
@@ -15,7 +20,7 @@ public:
     typedef const T*                  ConstIterator;
     typedef TReverseIterator<T>       ReverseIterator;
     typedef TReverseIterator<const T> ConstReverseIterator;
-    typedef UInt32                    SizeType;
+    typedef TAllocatorSizeType<TAllocator> SizeType;
 
     TArray() noexcept
         : mArray(nullptr)
@@ -25,39 +30,48 @@ public:
     {
     }
 
-    explicit TArray(SizeType Size) noexcept
+    // Stateful allocators, such as TLinearAllocator, are passed as the last argument and copied into the array
+    explicit TArray(const TAllocator& InAllocator) noexcept
         : mArray(nullptr)
         , mSize(0)
         , mCapacity(0)
-        , mAllocator()
+        , mAllocator(InAllocator)
+    {
+    }
+
+    explicit TArray(SizeType Size, const TAllocator& InAllocator = TAllocator()) noexcept
+        : mArray(nullptr)
+        , mSize(0)
+        , mCapacity(0)
+        , mAllocator(InAllocator)
     {
         InternalConstruct(Size);
     }
 
-    explicit TArray(SizeType Size, const T& Value) noexcept
+    explicit TArray(SizeType Size, const T& Value, const TAllocator& InAllocator = TAllocator()) noexcept
         : mArray(nullptr)
         , mSize(0)
         , mCapacity(0)
-        , mAllocator()
+        , mAllocator(InAllocator)
     {
         InternalConstruct(Size, Value);
     }
 
     template<typename TInput>
-    explicit TArray(TInput Begin, TInput End) noexcept
+    explicit TArray(TInput Begin, TInput End, const TAllocator& InAllocator = TAllocator()) noexcept
         : mArray(nullptr)
         , mSize(0)
         , mCapacity(0)
-        , mAllocator()
+        , mAllocator(InAllocator)
     {
         InternalConstruct(Begin, End);
     }
 
-    TArray(std::initializer_list<T> List) noexcept
+    TArray(std::initializer_list<T> List, const TAllocator& InAllocator = TAllocator()) noexcept
         : mArray(nullptr)
         , mSize(0)
         , mCapacity(0)
-        , mAllocator()
+        , mAllocator(InAllocator)
     {
         InternalConstruct(List.begin(), List.end());
     }
@@ -66,7 +80,7 @@ public:
         : mArray(nullptr)
         , mSize(0)
         , mCapacity(0)
-        , mAllocator()
+        , mAllocator(Other.mAllocator)
     {
         InternalConstruct(Other.Begin(), Other.End());
     }
@@ -75,7 +89,7 @@ public:
         : mArray(nullptr)
         , mSize(0)
         , mCapacity(0)
-        , mAllocator()
+        , mAllocator(Other.mAllocator)
     {
         InternalMove(::Forward<TArray>(Other));
     }
@@ -120,25 +134,46 @@ public:
 
     void Fill(const T& Value) noexcept
     {
-        T* ArrayBegin = mArray;
-        T* ArrayEnd   = ArrayBegin + mSize;
-
-        while (ArrayBegin != ArrayEnd)
+        if constexpr (std::is_trivially_copyable<T>())
+        {
+            FillElements(mArray, UInt64(mSize), Value);
+        }
+        else
         {
-            *ArrayBegin = Value;
-            ArrayBegin++;
+            T* ArrayBegin = mArray;
+            T* ArrayEnd   = ArrayBegin + mSize;
+
+            while (ArrayBegin != ArrayEnd)
+            {
+                *ArrayBegin = Value;
+                ArrayBegin++;
+            }
         }
     }
 
     void Fill(T&& Value) noexcept
     {
-        T* ArrayBegin = mArray;
-        T* ArrayEnd   = ArrayBegin + mSize;
-
-        while (ArrayBegin != ArrayEnd)
+        if constexpr (std::is_trivially_copyable<T>())
         {
-            *ArrayBegin = ::Move(Value);
-            ArrayBegin++;
+            FillElements(mArray, UInt64(mSize), Value);
+        }
+        else
+        {
+            T* ArrayBegin = mArray;
+            T* ArrayEnd   = ArrayBegin + mSize;
+
+            // Only the last element can take the value, the others need a copy
+            if (ArrayBegin != ArrayEnd)
+            {
+                ArrayEnd--;
+                while (ArrayBegin != ArrayEnd)
+                {
+                    *ArrayBegin = Value;
+                    ArrayBegin++;
+                }
+
+                *ArrayEnd = ::Move(Value);
+            }
         }
     }
 
@@ -180,23 +215,60 @@ public:
         mSize = InSize;
     }
 
+    /*
+     * Uninitialized growth - For trivial types, such as byte buffers that are filled by a read right after, these skip
+     * the zeroing that Resize does. The new elements have indeterminate values until they are written.
+     */
+
+    // Appends Count uninitialized elements and returns the index of the first one
+    SizeType AddUninitialized(SizeType Count) noexcept
+    {
+        static_assert(IsUninitializedType, "Uninitialized growth requires a trivially constructible and destructible type");
+
+        const SizeType Index = mSize;
+        InternalReserveForAppend(Count);
+        mSize += Count;
+        return Index;
+    }
+
+    // Appends Count uninitialized elements and returns a view of them, so that the tail can be written in bulk
+    TArrayView<T, SizeType> AppendUninitialized(SizeType Count) noexcept
+    {
+        const SizeType Index = AddUninitialized(Count);
+        return TArrayView<T, SizeType>(mArray + Index, mArray + mSize);
+    }
+
+    void ResizeUninitialized(SizeType InSize) noexcept
+    {
+        static_assert(IsUninitializedType, "Uninitialized growth requires a trivially constructible and destructible type");
+
+        if (InSize > mCapacity)
+        {
+            InternalRealloc(InSize);
+        }
+
+        mSize = InSize;
+    }
+
+    // Sets the size without touching the elements, the capacity must already fit it
+    void SetNumUnchecked(SizeType InSize) noexcept
+    {
+        static_assert(IsUninitializedType, "Uninitialized growth requires a trivially constructible and destructible type");
+        VALIDATE(InSize <= mCapacity);
+        mSize = InSize;
+    }
+
     void Reserve(SizeType Capacity) noexcept
     {
         if (Capacity != mCapacity)
         {
-            SizeType OldSize = mSize;
             if (Capacity < mSize)
             {
+                InternalDestructRange(mArray + Capacity, mArray + mSize);
                 mSize = Capacity;
             }
 
-            T* TempData = InternalAllocateElements(Capacity);
-            InternalMoveEmplace(mArray, mArray + mSize, TempData);
-            InternalDestructRange(mArray, mArray + OldSize);
-
-            InternalReleaseData();
-            mArray      = TempData;
-            mCapacity = Capacity;
+            InternalRealloc(Capacity);
         }
     }
 
@@ -247,11 +319,7 @@ public:
         }
         else
         {
-            // Construct the range so that we can move to It
-            T* DataEnd = mArray + mSize;
-            InternalDefaultConstructRange(DataEnd, DataEnd + 1);
-            InternalMemmoveForward(DataBegin, DataEnd, DataEnd);
-            InternalDestruct(DataBegin);
+            InternalShiftForward(DataBegin, 1);
         }
 
         new (reinterpret_cast<void*>(DataBegin)) T(::Forward<TArgs>(Args)...);
@@ -290,14 +358,11 @@ public:
 
         if (Pos == End())
         {
-            for (const T& Value : List)
-            {
-                EmplaceBack(::Move(Value));
-            }
-
-            return End() - 1;
+            return Append(List.begin(), List.end());
         }
 
+        VALIDATE(List.size() <= UInt64(MaxSize() - mSize));
+
         const SizeType ListSize = static_cast<SizeType>(List.size());
         const SizeType NewSize  = mSize + ListSize;
         const SizeType Index    = InternalIndex(Pos);
@@ -311,13 +376,7 @@ public:
         }
         else
         {
-            // Construct the range so that we can move to It
-            T* DataEnd    = mArray + mSize;
-            T* NewDataEnd = mArray + mSize + ListSize;
-            T* RangeEnd   = RangeBegin + ListSize;
-            InternalDefaultConstructRange(DataEnd, NewDataEnd);
-            InternalMemmoveForward(RangeBegin, DataEnd, NewDataEnd - 1);
-            InternalDestructRange(RangeBegin, RangeEnd);
+            InternalShiftForward(RangeBegin, ListSize);
         }
 
         // TODO: Get rid of const_cast
@@ -327,9 +386,9 @@ public:
     }
 
     template<typename TInput>
-    Iterator Insert(Iterator Pos, TInput Begin, TInput End) noexcept
+    Iterator Insert(Iterator Pos, TInput InBegin, TInput InEnd) noexcept
     {
-        return Insert(Pos, Begin, End);
+        return Insert(ConstIterator(Pos), InBegin, InEnd);
     }
 
     template<typename TInput>
@@ -339,15 +398,12 @@ public:
 
         if (Pos == End())
         {
-            for (TInput It = InBegin; It != InEnd; It++)
-            {
-                EmplaceBack(*It);
-            }
-
-            return End() - 1;
+            return Append(InBegin, InEnd);
         }
 
         const SizeType RangeSize = InternalDistance(InBegin, InEnd);
+        VALIDATE(RangeSize <= MaxSize() - mSize);
+
         const SizeType NewSize   = mSize + RangeSize;
         const SizeType Index     = InternalIndex(Pos);
 
@@ -360,23 +416,88 @@ public:
         }
         else
         {
-            // Construct the range so that we can move to it
-            T* DataEnd    = mArray + mSize;
-            T* NewDataEnd = mArray + mSize + RangeSize;
-            T* RangeEnd   = RangeBegin + RangeSize;
-            InternalDefaultConstructRange(DataEnd, NewDataEnd);
-            InternalMemmoveForward(RangeBegin, DataEnd, NewDataEnd - 1);
-            InternalDestructRange(RangeBegin, RangeEnd);
+            InternalShiftForward(RangeBegin, RangeSize);
         }
 
-        InternalCopyEmplace(Begin, End, RangeBegin);
+        InternalCopyEmplace(InBegin, InEnd, RangeBegin);
         mSize = NewSize;
         return Iterator(RangeBegin);
     }
 
-    Iterator Append(const TArray& Other)
+    // Copies the range to the end, the size of the range is computed first so that the array grows at most once.
+    // Returns an iterator to the first appended element.
+    template<typename TInput>
+    Iterator Append(TInput InBegin, TInput InEnd) noexcept
+    {
+        const SizeType RangeSize = InternalDistance(InBegin, InEnd);
+        const SizeType Index     = mSize;
+        if (RangeSize == 0)
+        {
+            return End();
+        }
+
+        // The range may be part of this array, in which case it moves together with the elements when growing
+        if constexpr (std::is_convertible<TInput, ConstIterator>())
+        {
+            if (RangeSize > (mCapacity - mSize) && InternalIsRangeOwner(InBegin, InEnd))
+            {
+                const SizeType BeginIndex = InternalIndex(InBegin);
+                InternalReserveForAppend(RangeSize);
+                InternalCopyEmplace(mArray + BeginIndex, mArray + BeginIndex + RangeSize, mArray + Index);
+                mSize += RangeSize;
+                return Iterator(mArray + Index);
+            }
+        }
+
+        InternalReserveForAppend(RangeSize);
+        InternalCopyEmplace(InBegin, InEnd, mArray + Index);
+        mSize += RangeSize;
+        return Iterator(mArray + Index);
+    }
+
+    Iterator Append(const TArray& Other) noexcept
+    {
+        return Append(Other.Begin(), Other.End());
+    }
+
+    template<typename TElement, typename TViewSizeType, typename = TEnableIf<std::is_same<std::remove_const_t<TElement>, T>::value>>
+    Iterator Append(const TArrayView<TElement, TViewSizeType>& View) noexcept
+    {
+        return Append(View.Data(), View.Data() + View.Size());
+    }
+
+    // Moves the elements of Other to the end and leaves Other empty. When this array is empty and the other buffer
+    // is at least as large, the buffer is stolen instead, together with the allocator as for move-assignment.
+    Iterator Append(TArray&& Other) noexcept
+    {
+        VALIDATE(this != std::addressof(Other));
+
+        if (IsEmpty() && Other.mCapacity >= mCapacity)
+        {
+            InternalMove(::Move(Other));
+            return Begin();
+        }
+
+        const SizeType Index = mSize;
+        InternalReserveForAppend(Other.mSize);
+        InternalRelocateRange(Other.mArray, Other.mArray + Other.mSize, mArray + Index);
+        mSize      += Other.mSize;
+        Other.mSize = 0;
+        return Iterator(mArray + Index);
+    }
+
+    // Moves the elements of the view to the end, the elements in the view are left in a moved-from state
+    template<typename TViewSizeType>
+    Iterator MoveAppend(TArrayView<T, TViewSizeType> View) noexcept
     {
-        return Insert(End(), Other.Begin(), Other.End());
+        VALIDATE(View.IsEmpty() || !InternalIsRangeOwner(View.Data(), View.Data() + View.Size()));
+
+        const SizeType Index     = mSize;
+        const SizeType RangeSize = InternalDistance(View.Data(), View.Data() + View.Size());
+        InternalReserveForAppend(RangeSize);
+        InternalMoveEmplace(View.Data(), View.Data() + RangeSize, mArray + Index);
+        mSize += RangeSize;
+        return Iterator(mArray + Index);
     }
 
     void PopBack() noexcept
@@ -405,9 +526,7 @@ public:
 
         const SizeType Index = InternalIndex(Pos);
         T* DataBegin = mArray + Index;
-        T* DataEnd   = mArray + mSize;
-        InternalMemmoveBackwards(DataBegin + 1, DataEnd, DataBegin);
-        InternalDestruct(DataEnd - 1);
+        InternalShiftBackwards(DataBegin, 1);
 
         mSize--;
         return Iterator(DataBegin);
@@ -433,15 +552,77 @@ public:
         }
         else
         {
-            T* RealEnd = mArray + mSize;
-            InternalMemmoveBackwards(DataEnd, RealEnd, DataBegin);
-            InternalDestructRange(RealEnd - elementCount, RealEnd);
+            InternalShiftBackwards(DataBegin, elementCount);
         }
 
         mSize -= elementCount;
         return Iterator(DataBegin);
     }
 
+    // Removes the element by moving the last element into its place, O(1) but does not keep the order
+    void RemoveAtSwap(SizeType Index) noexcept
+    {
+        VALIDATE(Index < mSize);
+
+        T* Pos  = mArray + Index;
+        T* Last = mArray + (mSize - 1);
+        if (Pos != Last)
+        {
+            if constexpr (TIsTriviallyRelocatable<T>)
+            {
+                InternalDestruct(Pos);
+                ::memcpy(reinterpret_cast<void*>(Pos), reinterpret_cast<void*>(Last), sizeof(T));
+                mSize--;
+                return;
+            }
+            else
+            {
+                (*Pos) = ::Move(*Last);
+            }
+        }
+
+        PopBack();
+    }
+
+    // Removes all elements that match the predicate in a single pass that keeps the order, returns the number of removed elements
+    template<typename TPredicate>
+    SizeType RemoveIf(TPredicate&& Predicate) noexcept
+    {
+        T* DataEnd = mArray + mSize;
+        T* Write   = mArray;
+        while (Write != DataEnd && !Predicate(*Write))
+        {
+            Write++;
+        }
+
+        if (Write == DataEnd)
+        {
+            return 0;
+        }
+
+        for (T* Read = Write + 1; Read != DataEnd; Read++)
+        {
+            if (!Predicate(*Read))
+            {
+                (*Write) = ::Move(*Read);
+                Write++;
+            }
+        }
+
+        const SizeType NumRemoved = InternalDistance(Write, DataEnd);
+        InternalDestructRange(Write, DataEnd);
+        mSize -= NumRemoved;
+        return NumRemoved;
+    }
+
+    SizeType RemoveAll(const T& Value) noexcept
+    {
+        return RemoveIf([&Value](const T& Element)
+        {
+            return (Element == Value);
+        });
+    }
+
     void Swap(TArray& Other) noexcept
     {
         TArray TempArray(::Move(*this));
@@ -489,15 +670,25 @@ public:
         return mArray[mSize - 1];
     }
 
+    TAllocator& GetAllocator() noexcept { return mAllocator; }
+    const TAllocator& GetAllocator() const noexcept { return mAllocator; }
+
     T* Data() noexcept { return mArray; }
     const T* Data() const noexcept { return mArray; }
 
     SizeType LastIndex() const noexcept { return mSize > 0 ? mSize - 1 : 0; }
     SizeType Size() const noexcept { return mSize; }
-    SizeType SizeInBytes() const noexcept { return mSize * sizeof(T); }
+    UInt64 SizeInBytes() const noexcept { return UInt64(mSize) * sizeof(T); }
 
     SizeType Capacity() const noexcept { return mCapacity; }
-    SizeType CapacityInBytes() const noexcept { return mCapacity * sizeof(T); }
+    UInt64 CapacityInBytes() const noexcept { return UInt64(mCapacity) * sizeof(T); }
+
+    // Largest number of elements that the size type and the allocator byte count can address
+    static constexpr SizeType MaxSize() noexcept
+    {
+        constexpr UInt64 MaxElements = std::numeric_limits<UInt64>::max() / sizeof(T);
+        return (MaxElements < std::numeric_limits<SizeType>::max()) ? SizeType(MaxElements) : std::numeric_limits<SizeType>::max();
+    }
 
     T& At(SizeType Index) noexcept
     {
@@ -563,6 +754,8 @@ public:
     ConstReverseIterator crend() const noexcept { return ConstReverseIterator(begin()); }
 
 private:
+    static constexpr Bool IsUninitializedType = std::is_trivially_default_constructible<T>() && std::is_trivially_destructible<T>();
+
     // Check that the iterator belongs to this TArray
     Bool InternalIsRangeOwner(ConstIterator InBegin, ConstIterator InEnd) const noexcept
     {
@@ -616,22 +809,60 @@ private:
         return InternalGetResizeFactor(mSize);
     }
 
+    // Capacity that fits more than BaseSize elements, saturating at MaxSize instead of wrapping around the size type
     SizeType InternalGetResizeFactor(SizeType BaseSize) const noexcept
     {
-        return BaseSize + (mCapacity / 2) + 1;
+        VALIDATE(BaseSize < MaxSize());
+
+        const UInt64 NumElements = UInt64(BaseSize) + 1;
+        const UInt64 NewCapacity = TGrowthPolicy::GetCapacity(NumElements, mCapacity, sizeof(T));
+        return (NewCapacity >= NumElements && NewCapacity <= MaxSize()) ? SizeType(NewCapacity) : MaxSize();
+    }
+
+    // Grows the capacity geometrically so that Count more elements fit
+    void InternalReserveForAppend(SizeType Count) noexcept
+    {
+        VALIDATE(Count <= MaxSize() - mSize);
+
+        const SizeType NewSize = mSize + Count;
+        if (NewSize > mCapacity)
+        {
+            const SizeType NewCapacity = InternalGetResizeFactor(NewSize - 1);
+            InternalRealloc(NewCapacity);
+        }
+    }
+
+    // The allocator may have returned a larger block than requested, the slack can be used for more elements
+    SizeType InternalGetUsableCapacity(SizeType Capacity) const noexcept
+    {
+        if constexpr (TGrowthPolicy::RoundToUsableSize && THasGetUsableSize<TAllocator>)
+        {
+            if (mArray)
+            {
+                const UInt64 UsableCapacity = mAllocator.GetUsableSize(reinterpret_cast<void*>(mArray), alignof(T)) / sizeof(T);
+                if (UsableCapacity > Capacity)
+                {
+                    return (UsableCapacity <= MaxSize()) ? SizeType(UsableCapacity) : MaxSize();
+                }
+            }
+        }
+
+        return Capacity;
     }
 
     T* InternalAllocateElements(SizeType Capacity) noexcept
     {
-        const SizeType SizeInBytes = sizeof(T) * Capacity;
-        return reinterpret_cast<T*>(mAllocator.Allocate(SizeInBytes));
+        VALIDATE(Capacity <= MaxSize());
+
+        const UInt64 SizeInBytes = UInt64(Capacity) * sizeof(T);
+        return reinterpret_cast<T*>(mAllocator.Allocate(SizeInBytes, alignof(T)));
     }
 
     void InternalReleaseData() noexcept
     {
         if (mArray)
         {
-            mAllocator.Free(mArray);
+            mAllocator.Free(reinterpret_cast<void*>(mArray), alignof(T));
             mArray = nullptr;
         }
     }
@@ -642,19 +873,52 @@ private:
         {
             InternalReleaseData();
             mArray    = InternalAllocateElements(Capacity);
-            mCapacity = Capacity;
+            mCapacity = InternalGetUsableCapacity(Capacity);
         }
     }
 
     void InternalRealloc(SizeType Capacity) noexcept
     {
-        T* TempData = InternalAllocateElements(Capacity);
-        InternalMoveEmplace(mArray, mArray + mSize, TempData);
-        InternalDestructRange(mArray, mArray + mSize);
+        VALIDATE(Capacity >= mSize);
 
-        InternalReleaseData();
-        mArray    = TempData;
-        mCapacity = Capacity;
+        // Relocatable elements can be moved by the allocator, which may be able to grow the block in place
+        if constexpr (TIsTriviallyRelocatable<T> && THasReallocate<TAllocator>)
+        {
+            if (Capacity > 0)
+            {
+                VALIDATE(Capacity <= MaxSize());
+
+                const UInt64 SizeInBytes = UInt64(Capacity) * sizeof(T);
+                T* NewArray = reinterpret_cast<T*>(mAllocator.Reallocate(reinterpret_cast<void*>(mArray), SizeInBytes, alignof(T)));
+                VALIDATE(NewArray != nullptr);
+
+                // The old block is still valid when Reallocate fails, so the array keeps it
+                if (!NewArray)
+                {
+                    return;
+                }
+
+                mArray = NewArray;
+            }
+            else
+            {
+                InternalReleaseData();
+            }
+        }
+        else
+        {
+            // Inline allocators return the same block as long as the elements still fit
+            T* TempData = InternalAllocateElements(Capacity);
+            if (TempData != mArray)
+            {
+                InternalRelocateRange(mArray, mArray + mSize, TempData);
+
+                InternalReleaseData();
+                mArray = TempData;
+            }
+        }
+
+        mCapacity = InternalGetUsableCapacity(Capacity);
     }
 
     void InternalEmplaceRealloc(SizeType Capacity, T* EmplacePos, SizeType Count) noexcept
@@ -662,18 +926,29 @@ private:
         VALIDATE(Capacity >= mSize + Count);
 
         const SizeType Index = InternalIndex(EmplacePos);
-        T* TempData = InternalAllocateElements(Capacity);
-        InternalMoveEmplace(mArray, EmplacePos, TempData);
-        if (EmplacePos != mArray + mSize)
+        if constexpr (TIsTriviallyRelocatable<T> && THasReallocate<TAllocator>)
         {
-            InternalMoveEmplace(EmplacePos, mArray + mSize, TempData + Index + Count);
+            InternalRealloc(Capacity);
+            InternalShiftForward(mArray + Index, Count);
         }
+        else
+        {
+            T* TempData = InternalAllocateElements(Capacity);
+            if (TempData != mArray)
+            {
+                InternalRelocateRange(mArray, EmplacePos, TempData);
+                InternalRelocateRange(EmplacePos, mArray + mSize, TempData + Index + Count);
 
-        InternalDestructRange(mArray, mArray + mSize);
-
-        InternalReleaseData();
-        mArray    = TempData;
-        mCapacity = Capacity;
+                InternalReleaseData();
+                mArray    = TempData;
+                mCapacity = InternalGetUsableCapacity(Capacity);
+            }
+            else
+            {
+                mCapacity = InternalGetUsableCapacity(Capacity);
+                InternalShiftForward(EmplacePos, Count);
+            }
+        }
     }
 
     // Construct
@@ -711,7 +986,23 @@ private:
 
     void InternalMove(TArray&& Other) noexcept
     {
+        // The block is released by the allocator that owns it, the allocator then follows the stolen block
         InternalReleaseData();
+        mAllocator = Other.mAllocator;
+
+        // Elements that are stored inside the other allocator cannot be stolen, so they are relocated instead
+        if constexpr (THasInlineStorage<TAllocator>)
+        {
+            if (Other.mAllocator.IsInlineAllocation(Other.mArray))
+            {
+                mCapacity = 0;
+                InternalAllocData(Other.mSize);
+                InternalRelocateRange(Other.mArray, Other.mArray + Other.mSize, mArray);
+                mSize       = Other.mSize;
+                Other.mSize = 0;
+                return;
+            }
+        }
 
         mArray    = Other.mArray;
         mSize     = Other.mSize;
@@ -734,7 +1025,7 @@ private:
         if constexpr (IsTrivial && (IsPointer || IsCustomIterator))
         {
             const SizeType Count   = InternalDistance(Begin, End);
-            const SizeType CpySize = Count * sizeof(T);
+            const UInt64   CpySize = UInt64(Count) * sizeof(T);
             memcpy(Dest, InternalUnwrapConst(Begin), CpySize);
         }
         else
@@ -750,11 +1041,18 @@ private:
 
     void InternalCopyEmplace(SizeType Size, const T& Value, T* Dest) noexcept
     {
-        T* ItEnd = Dest + Size;
-        while (Dest != ItEnd)
+        if constexpr (std::is_trivially_copyable<T>())
+        {
+            FillElements(Dest, UInt64(Size), Value);
+        }
+        else
         {
-            new(reinterpret_cast<void*>(Dest)) T(Value);
-            Dest++;
+            T* ItEnd = Dest + Size;
+            while (Dest != ItEnd)
+            {
+                new(reinterpret_cast<void*>(Dest)) T(Value);
+                Dest++;
+            }
         }
     }
 
@@ -764,7 +1062,7 @@ private:
         if constexpr (std::is_trivially_move_constructible<T>())
         {
             const SizeType Count   = InternalDistance(InBegin, InEnd);
-            const SizeType CpySize = Count * sizeof(T);
+            const UInt64   CpySize = UInt64(Count) * sizeof(T);
             ::memcpy(Dest, InBegin, CpySize);
         }
         else
@@ -778,6 +1076,66 @@ private:
         }
     }
 
+    // Moves the range into uninitialized memory that does not overlap and destroys the source,
+    // relocatable types are moved with a single memcpy
+    void InternalRelocateRange(T* InBegin, T* InEnd, T* Dest) noexcept
+    {
+        if constexpr (TIsTriviallyRelocatable<T>)
+        {
+            const SizeType Count = InternalDistance(InBegin, InEnd);
+            if (Count > 0)
+            {
+                ::memcpy(reinterpret_cast<void*>(Dest), reinterpret_cast<void*>(InBegin), Count * sizeof(T));
+            }
+        }
+        else
+        {
+            InternalMoveEmplace(InBegin, InEnd, Dest);
+            InternalDestructRange(InBegin, InEnd);
+        }
+    }
+
+    // Opens a gap of Count uninitialized elements at Pos by moving the tail forward, the capacity must fit the tail
+    void InternalShiftForward(T* Pos, SizeType Count) noexcept
+    {
+        T* DataEnd = mArray + mSize;
+        VALIDATE(DataEnd + Count <= mArray + mCapacity);
+
+        if constexpr (TIsTriviallyRelocatable<T>)
+        {
+            const UInt64 NumBytes = UInt64(InternalDistance(Pos, DataEnd)) * sizeof(T);
+            ::memmove(reinterpret_cast<void*>(Pos + Count), reinterpret_cast<void*>(Pos), NumBytes);
+        }
+        else
+        {
+            // Construct the range so that we can move to it
+            T* NewDataEnd = DataEnd + Count;
+            InternalDefaultConstructRange(DataEnd, NewDataEnd);
+            InternalMemmoveForward(Pos, DataEnd, NewDataEnd - 1);
+            InternalDestructRange(Pos, Pos + Count);
+        }
+    }
+
+    // Destroys Count elements at Pos and moves the tail backwards to close the gap
+    void InternalShiftBackwards(T* Pos, SizeType Count) noexcept
+    {
+        T* DataEnd = mArray + mSize;
+        VALIDATE(Pos + Count <= DataEnd);
+
+        if constexpr (TIsTriviallyRelocatable<T>)
+        {
+            InternalDestructRange(Pos, Pos + Count);
+
+            const UInt64 NumBytes = UInt64(InternalDistance(Pos + Count, DataEnd)) * sizeof(T);
+            ::memmove(reinterpret_cast<void*>(Pos), reinterpret_cast<void*>(Pos + Count), NumBytes);
+        }
+        else
+        {
+            InternalMemmoveBackwards(Pos + Count, DataEnd, Pos);
+            InternalDestructRange(DataEnd - Count, DataEnd);
+        }
+    }
+
     void InternalMemmoveBackwards(T* InBegin, T* InEnd, T* Dest) noexcept
     {
         VALIDATE(InBegin <= InEnd);
@@ -792,7 +1150,7 @@ private:
         const SizeType Count = InternalDistance(InBegin, InEnd);
         if constexpr (std::is_trivially_move_assignable<T>())
         {
-            const SizeType CpySize = Count * sizeof(T);
+            const UInt64   CpySize = UInt64(Count) * sizeof(T);
             ::memmove(Dest, InBegin, CpySize); // Assumes that data can overlap
         }
         else
@@ -823,8 +1181,8 @@ private:
         {
             if (Count > 0)
             {
-                const SizeType CpySize    = Count * sizeof(T);
-                const SizeType OffsetSize = (Count - 1) * sizeof(T);
+                const UInt64 CpySize    = UInt64(Count) * sizeof(T);
+                const UInt64 OffsetSize = UInt64(Count - 1) * sizeof(T);
                 ::memmove(reinterpret_cast<Char*>(Dest) - OffsetSize, InBegin, CpySize);
             }
         }
@@ -857,7 +1215,7 @@ private:
     void InternalDestructRange(const T* InBegin, const T* InEnd) noexcept
     {
         VALIDATE(InBegin <= InEnd);
-        VALIDATE(InEnd - InBegin <= mCapacity);
+        VALIDATE(UInt64(InEnd - InBegin) <= UInt64(mCapacity));
 
         if constexpr (std::is_trivially_destructible<T>() == false)
         {
@@ -889,3 +1247,26 @@ private:
     SizeType   mCapacity;
     TAllocator mAllocator;
 };
+
+// TInlineArray - TArray that stores the first N elements inside the object and only allocates when it grows larger
+
+template<typename T, UInt32 N, typename TSecondaryAllocator = Mallocator>
+using TInlineArray = TArray<T, TInlineAllocator<T, N, TSecondaryAllocator>>;
+
+// TAlignedArray - TArray where the whole buffer is aligned to at least Alignment bytes
+
+template<typename T, UInt64 Alignment>
+using TAlignedArray = TArray<T, TAlignedAllocator<Alignment>>;
+
+// TArray64 - TArray that can hold more than 4G elements
+
+template<typename T>
+using TArray64 = TArray<T, TSizedAllocator<UInt64>>;
+
+// TArray is relocatable as long as the allocator does not point into itself
+
+template<typename T, typename TAllocator, typename TGrowthPolicy>
+struct _TIsTriviallyRelocatable<TArray<T, TAllocator, TGrowthPolicy>>
+{
+    static constexpr Bool Value = TIsTriviallyRelocatable<TAllocator>;
+};
\ No newline at end of file
@@ -2,9 +2,11 @@
 #include "Utilities.h"
 #include "Iterator.h"
 
-// TArrayView - View of an array similar to std::span
+#include <limits>
 
-template<typename T>
+// TArrayView - View of an array similar to std::span, TSizeType must be able to hold the size of the viewed array
+
+template<typename T, typename TSizeType = UInt32>
 class TArrayView
 {
 public:
@@ -12,7 +14,7 @@ public:
     typedef const T*                  ConstIterator;
     typedef TReverseIterator<T>       ReverseIterator;
     typedef TReverseIterator<const T> ConstReverseIterator;
-    typedef UInt32                    SizeType;
+    typedef TSizeType                 SizeType;
 
     TArrayView() noexcept
         : mView(nullptr)
@@ -23,8 +25,9 @@ public:
     template<typename TArrayType>
     explicit TArrayView(TArrayType& Array) noexcept
         : mView(Array.Data())
-        , mSize(Array.Size())
+        , mSize(SizeType(Array.Size()))
     {
+        VALIDATE(UInt64(Array.Size()) <= UInt64(std::numeric_limits<SizeType>::max()));
     }
     
     template<const SizeType N>
@@ -39,6 +42,7 @@ public:
         : mView(Begin)
         , mSize(SizeType(End - Begin))
     {
+        VALIDATE(UInt64(End - Begin) <= UInt64(std::numeric_limits<SizeType>::max()));
     }
 
     TArrayView(const TArrayView& Other) noexcept
@@ -90,7 +94,7 @@ public:
 
     SizeType LastIndex() const noexcept { return mSize > 0 ? mSize - 1 : 0; }
     SizeType Size() const noexcept { return mSize; }
-    SizeType SizeInBytes() const noexcept { return mSize * sizeof(T); }
+    UInt64 SizeInBytes() const noexcept { return UInt64(mSize) * sizeof(T); }
 
     T* Data() noexcept { return mView; }
     const T* Data() const noexcept { return mView; }
@@ -142,3 +146,11 @@ private:
     T*       mView;
     SizeType mSize;
 };
+
+// TArrayView only stores a pointer and a size
+
+template<typename T, typename TSizeType>
+struct _TIsTriviallyRelocatable<TArrayView<T, TSizeType>>
+{
+    static constexpr Bool Value = true;
+};
@@ -0,0 +1,566 @@
+#pragma once
+#include "Utilities.h"
+#include "Allocator.h"
+#include "ArrayView.h"
+
+#include <initializer_list>
+#include <iterator>
+#include <cstring>
+#include <limits>
+
+// TDequeIterator - Random access iterator that stores the logical index, so that it stays valid when the ring wraps around
+
+template<typename TDequeType, typename TElement>
+class TDequeIterator
+{
+public:
+    typedef typename TDequeType::SizeType SizeType;
+
+    typedef std::random_access_iterator_tag    iterator_category;
+    typedef std::remove_const_t<TElement>      value_type;
+    typedef Int64                              difference_type;
+    typedef TElement*                          pointer;
+    typedef TElement&                          reference;
+
+    TDequeIterator() noexcept
+        : mDeque(nullptr)
+        , mIndex(0)
+    {
+    }
+
+    TDequeIterator(TDequeType* InDeque, SizeType InIndex) noexcept
+        : mDeque(InDeque)
+        , mIndex(InIndex)
+    {
+    }
+
+    template<typename TOtherDeque, typename TOtherElement>
+    TDequeIterator(const TDequeIterator<TOtherDeque, TOtherElement>& Other) noexcept
+        : mDeque(Other.GetDeque())
+        , mIndex(Other.GetIndex())
+    {
+    }
+
+    TDequeType* GetDeque() const noexcept { return mDeque; }
+    SizeType GetIndex() const noexcept { return mIndex; }
+
+    TElement& operator*() const noexcept { return (*mDeque)[mIndex]; }
+    TElement* operator->() const noexcept { return &(*mDeque)[mIndex]; }
+    TElement& operator[](Int64 Offset) const noexcept { return (*mDeque)[SizeType(mIndex + Offset)]; }
+
+    TDequeIterator& operator++() noexcept
+    {
+        mIndex++;
+        return *this;
+    }
+
+    TDequeIterator operator++(Int32) noexcept
+    {
+        TDequeIterator Temp = *this;
+        mIndex++;
+        return Temp;
+    }
+
+    TDequeIterator& operator--() noexcept
+    {
+        mIndex--;
+        return *this;
+    }
+
+    TDequeIterator operator--(Int32) noexcept
+    {
+        TDequeIterator Temp = *this;
+        mIndex--;
+        return Temp;
+    }
+
+    TDequeIterator& operator+=(Int64 Offset) noexcept
+    {
+        mIndex = SizeType(mIndex + Offset);
+        return *this;
+    }
+
+    TDequeIterator& operator-=(Int64 Offset) noexcept
+    {
+        mIndex = SizeType(mIndex - Offset);
+        return *this;
+    }
+
+    TDequeIterator operator+(Int64 Offset) const noexcept { return TDequeIterator(mDeque, SizeType(mIndex + Offset)); }
+    TDequeIterator operator-(Int64 Offset) const noexcept { return TDequeIterator(mDeque, SizeType(mIndex - Offset)); }
+
+    Int64 operator-(const TDequeIterator& Other) const noexcept { return Int64(mIndex) - Int64(Other.mIndex); }
+
+    Bool operator==(const TDequeIterator& Other) const noexcept { return (mIndex == Other.mIndex); }
+    Bool operator!=(const TDequeIterator& Other) const noexcept { return (mIndex != Other.mIndex); }
+    Bool operator<(const TDequeIterator& Other) const noexcept { return (mIndex < Other.mIndex); }
+    Bool operator<=(const TDequeIterator& Other) const noexcept { return (mIndex <= Other.mIndex); }
+    Bool operator>(const TDequeIterator& Other) const noexcept { return (mIndex > Other.mIndex); }
+    Bool operator>=(const TDequeIterator& Other) const noexcept { return (mIndex >= Other.mIndex); }
+
+private:
+    TDequeType* mDeque;
+    SizeType    mIndex;
+};
+
+/*
+ * TDeque - Double-ended queue stored in a ring buffer with a power of two capacity. Pushing and popping at both ends
+ * is O(1), and the elements are stored in at most two contiguous segments that can be accessed as TArrayViews.
+ */
+
+template<typename T, typename TAllocator = Mallocator>
+class TDeque
+{
+    // Growing relocates the elements into a new block, which cannot be the same block as the old one
+    static_assert(THasInlineStorage<TAllocator> == false, "TDeque does not support allocators with inline storage");
+
+public:
+    typedef TAllocatorSizeType<TAllocator>       SizeType;
+    typedef TDequeIterator<TDeque, T>             Iterator;
+    typedef TDequeIterator<const TDeque, const T> ConstIterator;
+
+    TDeque() noexcept
+        : mData(nullptr)
+        , mHead(0)
+        , mSize(0)
+        , mCapacity(0)
+        , mAllocator()
+    {
+    }
+
+    explicit TDeque(const TAllocator& InAllocator) noexcept
+        : mData(nullptr)
+        , mHead(0)
+        , mSize(0)
+        , mCapacity(0)
+        , mAllocator(InAllocator)
+    {
+    }
+
+    TDeque(std::initializer_list<T> List, const TAllocator& InAllocator = TAllocator()) noexcept
+        : mData(nullptr)
+        , mHead(0)
+        , mSize(0)
+        , mCapacity(0)
+        , mAllocator(InAllocator)
+    {
+        InternalCopyConstruct(List.begin(), List.end());
+    }
+
+    TDeque(const TDeque& Other) noexcept
+        : mData(nullptr)
+        , mHead(0)
+        , mSize(0)
+        , mCapacity(0)
+        , mAllocator(Other.mAllocator)
+    {
+        InternalCopyConstruct(Other.Begin(), Other.End());
+    }
+
+    TDeque(TDeque&& Other) noexcept
+        : mData(nullptr)
+        , mHead(0)
+        , mSize(0)
+        , mCapacity(0)
+        , mAllocator(Other.mAllocator)
+    {
+        InternalMove(::Forward<TDeque>(Other));
+    }
+
+    ~TDeque()
+    {
+        Clear();
+        InternalReleaseData();
+    }
+
+    void Clear() noexcept
+    {
+        TArrayView<T, SizeType> First  = GetFirstSegment();
+        TArrayView<T, SizeType> Second = GetSecondSegment();
+        InternalDestructRange(First.Data(), First.Data() + First.Size());
+        InternalDestructRange(Second.Data(), Second.Data() + Second.Size());
+
+        mHead = 0;
+        mSize = 0;
+    }
+
+    // The capacity is rounded up to a power of two
+    void Reserve(SizeType Capacity) noexcept
+    {
+        if (Capacity > mCapacity)
+        {
+            InternalRealloc(InternalRoundCapacity(Capacity));
+        }
+    }
+
+    template<typename... TArgs>
+    T& EmplaceBack(TArgs&&... Args) noexcept
+    {
+        if (mSize == mCapacity)
+        {
+            InternalGrow();
+        }
+
+        T* Slot = mData + InternalWrap(mHead + mSize);
+        new(reinterpret_cast<void*>(Slot)) T(::Forward<TArgs>(Args)...);
+        mSize++;
+        return *Slot;
+    }
+
+    template<typename... TArgs>
+    T& EmplaceFront(TArgs&&... Args) noexcept
+    {
+        if (mSize == mCapacity)
+        {
+            InternalGrow();
+        }
+
+        const SizeType NewHead = InternalWrap(mHead + mCapacity - 1);
+
+        T* Slot = mData + NewHead;
+        new(reinterpret_cast<void*>(Slot)) T(::Forward<TArgs>(Args)...);
+        mHead = NewHead;
+        mSize++;
+        return *Slot;
+    }
+
+    T& PushBack(const T& Element) noexcept { return EmplaceBack(Element); }
+    T& PushBack(T&& Element) noexcept { return EmplaceBack(::Move(Element)); }
+
+    T& PushFront(const T& Element) noexcept { return EmplaceFront(Element); }
+    T& PushFront(T&& Element) noexcept { return EmplaceFront(::Move(Element)); }
+
+    void PopBack() noexcept
+    {
+        VALIDATE(!IsEmpty());
+
+        mSize--;
+        InternalDestruct(mData + InternalWrap(mHead + mSize));
+    }
+
+    void PopFront() noexcept
+    {
+        VALIDATE(!IsEmpty());
+
+        InternalDestruct(mData + mHead);
+        mHead = InternalWrap(mHead + 1);
+        mSize--;
+    }
+
+    // Moves the front element into OutElement and removes it, returns false if the deque is empty
+    Bool TryPopFront(T& OutElement) noexcept
+    {
+        if (IsEmpty())
+        {
+            return false;
+        }
+
+        OutElement = ::Move(Front());
+        PopFront();
+        return true;
+    }
+
+    T& Front() noexcept
+    {
+        VALIDATE(!IsEmpty());
+        return mData[mHead];
+    }
+
+    const T& Front() const noexcept
+    {
+        VALIDATE(!IsEmpty());
+        return mData[mHead];
+    }
+
+    T& Back() noexcept
+    {
+        VALIDATE(!IsEmpty());
+        return mData[InternalWrap(mHead + mSize - 1)];
+    }
+
+    const T& Back() const noexcept
+    {
+        VALIDATE(!IsEmpty());
+        return mData[InternalWrap(mHead + mSize - 1)];
+    }
+
+    T& At(SizeType Index) noexcept
+    {
+        VALIDATE(Index < mSize);
+        return mData[InternalWrap(mHead + Index)];
+    }
+
+    const T& At(SizeType Index) const noexcept
+    {
+        VALIDATE(Index < mSize);
+        return mData[InternalWrap(mHead + Index)];
+    }
+
+    // The elements from the front up to the end of the buffer
+    TArrayView<T, SizeType> GetFirstSegment() noexcept
+    {
+        T* SegmentBegin = mData + mHead;
+        return TArrayView<T, SizeType>(SegmentBegin, SegmentBegin + InternalFirstSegmentSize());
+    }
+
+    TArrayView<const T, SizeType> GetFirstSegment() const noexcept
+    {
+        const T* SegmentBegin = mData + mHead;
+        return TArrayView<const T, SizeType>(SegmentBegin, SegmentBegin + InternalFirstSegmentSize());
+    }
+
+    // The elements that have wrapped around to the start of the buffer, empty if the deque is contiguous
+    TArrayView<T, SizeType> GetSecondSegment() noexcept
+    {
+        return TArrayView<T, SizeType>(mData, mData + (mSize - InternalFirstSegmentSize()));
+    }
+
+    TArrayView<const T, SizeType> GetSecondSegment() const noexcept
+    {
+        return TArrayView<const T, SizeType>(mData, mData + (mSize - InternalFirstSegmentSize()));
+    }
+
+    // Relocates the elements into a single segment if they wrap around, and returns a view of all elements
+    TArrayView<T, SizeType> MakeContiguous() noexcept
+    {
+        if (InternalFirstSegmentSize() < mSize)
+        {
+            InternalRealloc(mCapacity);
+        }
+
+        return GetFirstSegment();
+    }
+
+    void Swap(TDeque& Other) noexcept
+    {
+        TDeque TempDeque(::Move(*this));
+        *this = ::Move(Other);
+        Other = ::Move(TempDeque);
+    }
+
+    Bool IsEmpty() const noexcept { return (mSize == 0); }
+
+    SizeType Size() const noexcept { return mSize; }
+    UInt64 SizeInBytes() const noexcept { return UInt64(mSize) * sizeof(T); }
+
+    SizeType Capacity() const noexcept { return mCapacity; }
+    UInt64 CapacityInBytes() const noexcept { return UInt64(mCapacity) * sizeof(T); }
+
+    // The capacity is a power of two, so the largest size is the largest power of two that the array can address
+    static constexpr SizeType MaxSize() noexcept
+    {
+        constexpr UInt64 MaxElements = std::numeric_limits<UInt64>::max() / sizeof(T);
+        constexpr UInt64 MaxCapacity = (MaxElements < std::numeric_limits<SizeType>::max()) ? MaxElements : std::numeric_limits<SizeType>::max();
+
+        UInt64 PowerOfTwo = 1;
+        while (PowerOfTwo <= (MaxCapacity / 2))
+        {
+            PowerOfTwo *= 2;
+        }
+
+        return SizeType(PowerOfTwo);
+    }
+
+    TAllocator& GetAllocator() noexcept { return mAllocator; }
+    const TAllocator& GetAllocator() const noexcept { return mAllocator; }
+
+    Iterator Begin() noexcept { return Iterator(this, 0); }
+    Iterator End() noexcept { return Iterator(this, mSize); }
+
+    ConstIterator Begin() const noexcept { return ConstIterator(this, 0); }
+    ConstIterator End() const noexcept { return ConstIterator(this, mSize); }
+
+    TDeque& operator=(const TDeque& Other) noexcept
+    {
+        if (this != std::addressof(Other))
+        {
+            Clear();
+            InternalCopyConstruct(Other.Begin(), Other.End());
+        }
+
+        return *this;
+    }
+
+    TDeque& operator=(TDeque&& Other) noexcept
+    {
+        if (this != std::addressof(Other))
+        {
+            Clear();
+            InternalMove(::Forward<TDeque>(Other));
+        }
+
+        return *this;
+    }
+
+    TDeque& operator=(std::initializer_list<T> List) noexcept
+    {
+        Clear();
+        InternalCopyConstruct(List.begin(), List.end());
+        return *this;
+    }
+
+    T& operator[](SizeType Index) noexcept { return At(Index); }
+    const T& operator[](SizeType Index) const noexcept { return At(Index); }
+
+    // STL iterator functions - Enables Range-based for-loops
+public:
+    Iterator begin() noexcept { return Begin(); }
+    Iterator end() noexcept { return End(); }
+
+    ConstIterator begin() const noexcept { return Begin(); }
+    ConstIterator end() const noexcept { return End(); }
+
+    ConstIterator cbegin() const noexcept { return Begin(); }
+    ConstIterator cend() const noexcept { return End(); }
+
+private:
+    static constexpr SizeType MinCapacity = 4;
+
+    SizeType InternalWrap(SizeType Index) const noexcept
+    {
+        return Index & (mCapacity - 1);
+    }
+
+    SizeType InternalFirstSegmentSize() const noexcept
+    {
+        const SizeType ToEnd = mCapacity - mHead;
+        return (mSize < ToEnd) ? mSize : ToEnd;
+    }
+
+    static SizeType InternalRoundCapacity(SizeType Capacity) noexcept
+    {
+        VALIDATE(Capacity <= MaxSize());
+
+        SizeType NewCapacity = MinCapacity;
+        while (NewCapacity < Capacity)
+        {
+            NewCapacity *= 2;
+        }
+
+        return NewCapacity;
+    }
+
+    void InternalGrow() noexcept
+    {
+        VALIDATE(mCapacity < MaxSize());
+        InternalRealloc((mCapacity > 0) ? (mCapacity * 2) : MinCapacity);
+    }
+
+    // Moves the elements to a new block of Capacity elements, starting at the beginning of the block
+    void InternalRealloc(SizeType Capacity) noexcept
+    {
+        VALIDATE(Capacity >= mSize);
+
+        T* NewData = reinterpret_cast<T*>(mAllocator.Allocate(UInt64(Capacity) * sizeof(T), alignof(T)));
+        VALIDATE(NewData != nullptr);
+
+        TArrayView<T, SizeType> First  = GetFirstSegment();
+        TArrayView<T, SizeType> Second = GetSecondSegment();
+        InternalRelocateRange(First.Data(), First.Data() + First.Size(), NewData);
+        InternalRelocateRange(Second.Data(), Second.Data() + Second.Size(), NewData + First.Size());
+
+        InternalReleaseData();
+        mData     = NewData;
+        mHead     = 0;
+        mCapacity = Capacity;
+    }
+
+    void InternalReleaseData() noexcept
+    {
+        if (mData)
+        {
+            mAllocator.Free(reinterpret_cast<void*>(mData), alignof(T));
+            mData = nullptr;
+        }
+
+        mCapacity = 0;
+    }
+
+    template<typename TInput>
+    void InternalCopyConstruct(TInput InBegin, TInput InEnd) noexcept
+    {
+        const UInt64 Distance = UInt64(std::distance(InBegin, InEnd));
+        VALIDATE(Distance <= UInt64(MaxSize()));
+
+        Reserve(SizeType(Distance));
+        for (TInput It = InBegin; It != InEnd; It++)
+        {
+            EmplaceBack(*It);
+        }
+    }
+
+    void InternalMove(TDeque&& Other) noexcept
+    {
+        InternalReleaseData();
+        mAllocator = Other.mAllocator;
+
+        mData     = Other.mData;
+        mHead     = Other.mHead;
+        mSize     = Other.mSize;
+        mCapacity = Other.mCapacity;
+
+        Other.mData     = nullptr;
+        Other.mHead     = 0;
+        Other.mSize     = 0;
+        Other.mCapacity = 0;
+    }
+
+    // Moves the range into uninitialized memory that does not overlap and destroys the source,
+    // relocatable types are moved with a single memcpy
+    void InternalRelocateRange(T* InBegin, T* InEnd, T* Dest) noexcept
+    {
+        if constexpr (TIsTriviallyRelocatable<T>)
+        {
+            const UInt64 NumBytes = UInt64(InEnd - InBegin) * sizeof(T);
+            if (NumBytes > 0)
+            {
+                ::memcpy(reinterpret_cast<void*>(Dest), reinterpret_cast<void*>(InBegin), NumBytes);
+            }
+        }
+        else
+        {
+            while (InBegin != InEnd)
+            {
+                new(reinterpret_cast<void*>(Dest)) T(::Move(*InBegin));
+                InBegin->~T();
+                InBegin++;
+                Dest++;
+            }
+        }
+    }
+
+    void InternalDestruct(T* Pos) noexcept
+    {
+        if constexpr (std::is_trivially_destructible<T>() == false)
+        {
+            Pos->~T();
+        }
+    }
+
+    void InternalDestructRange(T* InBegin, T* InEnd) noexcept
+    {
+        if constexpr (std::is_trivially_destructible<T>() == false)
+        {
+            while (InBegin != InEnd)
+            {
+                InternalDestruct(InBegin);
+                InBegin++;
+            }
+        }
+    }
+
+private:
+    T*         mData;
+    SizeType   mHead;
+    SizeType   mSize;
+    SizeType   mCapacity;
+    TAllocator mAllocator;
+};
+
+// TDeque is relocatable as long as the allocator does not point into itself
+
+template<typename T, typename TAllocator>
+struct _TIsTriviallyRelocatable<TDeque<T, TAllocator>>
+{
+    static constexpr Bool Value = TIsTriviallyRelocatable<TAllocator>;
+};
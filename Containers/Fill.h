@@ -0,0 +1,173 @@
+#pragma once
+#include "Utilities.h"
+
+#include <cstring>
+#include <type_traits>
+
+// Define FILL_USE_SSE2 as 0 to fill with loops and memset only
+#ifndef FILL_USE_SSE2
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define FILL_USE_SSE2 1
+#else
+    #define FILL_USE_SSE2 0
+#endif
+#endif
+
+// Fills of at least this many bytes use streaming stores that bypass the caches, so they do not evict the working set
+#ifndef FILL_NON_TEMPORAL_THRESHOLD
+    #define FILL_NON_TEMPORAL_THRESHOLD (4ull * 1024 * 1024)
+#endif
+
+#if FILL_USE_SSE2
+    #include <emmintrin.h>
+#endif
+
+/*
+ * Fill - Writes copies of a trivially copyable value. Values where all bytes are equal, such as zero, are written with
+ * memset. Other values are written one cache line at a time from a pattern of whole elements that repeats every
+ * PatternSize bytes, which also works for elements that do not divide the cache line, such as a Vec3.
+ */
+
+struct _FillImpl
+{
+    static constexpr UInt64 LineSize = 64;
+
+    static constexpr UInt64 GreatestCommonDivisor(UInt64 Lhs, UInt64 Rhs) noexcept
+    {
+        return (Rhs == 0) ? Lhs : GreatestCommonDivisor(Rhs, Lhs % Rhs);
+    }
+
+    // The smallest number of whole cache lines that holds a whole number of elements
+    template<typename T>
+    static constexpr UInt64 PatternSize = (sizeof(T) / GreatestCommonDivisor(sizeof(T), LineSize)) * LineSize;
+
+    // Elements with larger patterns are copied one at a time
+    static constexpr UInt64 MaxPatternSize = 4096;
+
+    template<typename T>
+    static Bool IsBytePattern(const T& Value) noexcept
+    {
+        const Byte* Bytes = reinterpret_cast<const Byte*>(std::addressof(Value));
+        for (UInt64 Index = 1; Index < sizeof(T); Index++)
+        {
+            if (Bytes[Index] != Bytes[0])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+#if FILL_USE_SSE2
+    /*
+     * The bytes before the first aligned cache line are the start of the pattern, so line i of the aligned part starts
+     * at HeadSize + i * LineSize in the pattern. The pattern buffer is one line longer than PatternSize, so every line
+     * is read without wrapping.
+     */
+    template<Bool NonTemporal>
+    static void StorePattern(Byte* Dest, UInt64 NumBytes, const Byte* Pattern, UInt64 InPatternSize) noexcept
+    {
+        const UInt64 Misalignment = UInt64(reinterpret_cast<size_t>(Dest) & (LineSize - 1));
+        const UInt64 HeadSize     = (Misalignment != 0) ? LineSize - Misalignment : 0;
+        VALIDATE(NumBytes >= HeadSize);
+
+        ::memcpy(Dest, Pattern, HeadSize);
+        Dest     += HeadSize;
+        NumBytes -= HeadSize;
+
+        UInt64 Offset = 0;
+        while (NumBytes >= LineSize)
+        {
+            const __m128i* Source = reinterpret_cast<const __m128i*>(Pattern + HeadSize + Offset);
+            const __m128i  Value0 = _mm_loadu_si128(Source + 0);
+            const __m128i  Value1 = _mm_loadu_si128(Source + 1);
+            const __m128i  Value2 = _mm_loadu_si128(Source + 2);
+            const __m128i  Value3 = _mm_loadu_si128(Source + 3);
+
+            __m128i* Line = reinterpret_cast<__m128i*>(Dest);
+            if constexpr (NonTemporal)
+            {
+                _mm_stream_si128(Line + 0, Value0);
+                _mm_stream_si128(Line + 1, Value1);
+                _mm_stream_si128(Line + 2, Value2);
+                _mm_stream_si128(Line + 3, Value3);
+            }
+            else
+            {
+                _mm_store_si128(Line + 0, Value0);
+                _mm_store_si128(Line + 1, Value1);
+                _mm_store_si128(Line + 2, Value2);
+                _mm_store_si128(Line + 3, Value3);
+            }
+
+            Dest     += LineSize;
+            NumBytes -= LineSize;
+            Offset    = (Offset + LineSize == InPatternSize) ? 0 : Offset + LineSize;
+        }
+
+        ::memcpy(Dest, Pattern + HeadSize + Offset, NumBytes);
+
+        // Streaming stores are weakly ordered, the fence makes them visible before any later store
+        if constexpr (NonTemporal)
+        {
+            _mm_sfence();
+        }
+    }
+#endif
+};
+
+// FillElements - Copies Value into Count elements at Dest, which may be uninitialized
+template<typename T>
+inline void FillElements(T* Dest, UInt64 Count, const T& Value) noexcept
+{
+    static_assert(std::is_trivially_copyable<T>::value, "FillElements requires a trivially copyable type");
+
+    if (Count == 0)
+    {
+        return;
+    }
+
+    const UInt64 NumBytes      = Count * sizeof(T);
+    const Bool   IsNonTemporal = (NumBytes >= FILL_NON_TEMPORAL_THRESHOLD);
+    const Bool   IsBytePattern = _FillImpl::IsBytePattern(Value);
+    if (IsBytePattern && (!FILL_USE_SSE2 || !IsNonTemporal))
+    {
+        ::memset(reinterpret_cast<void*>(Dest), *reinterpret_cast<const Byte*>(std::addressof(Value)), NumBytes);
+        return;
+    }
+
+#if FILL_USE_SSE2
+    if constexpr (_FillImpl::PatternSize<T> <= _FillImpl::MaxPatternSize)
+    {
+        Byte Pattern[_FillImpl::PatternSize<T> + _FillImpl::LineSize];
+
+        // Building the pattern costs about as much as a small fill, so those copy the elements
+        if (NumBytes >= 8 * sizeof(Pattern))
+        {
+            for (UInt64 Offset = 0; Offset < sizeof(Pattern); Offset += sizeof(T))
+            {
+                const UInt64 CopySize = (sizeof(Pattern) - Offset < sizeof(T)) ? sizeof(Pattern) - Offset : sizeof(T);
+                ::memcpy(Pattern + Offset, std::addressof(Value), CopySize);
+            }
+
+            Byte* Bytes = reinterpret_cast<Byte*>(Dest);
+            if (IsNonTemporal)
+            {
+                _FillImpl::StorePattern<true>(Bytes, NumBytes, Pattern, _FillImpl::PatternSize<T>);
+            }
+            else
+            {
+                _FillImpl::StorePattern<false>(Bytes, NumBytes, Pattern, _FillImpl::PatternSize<T>);
+            }
+
+            return;
+        }
+    }
+#endif
+
+    for (UInt64 Index = 0; Index < Count; Index++)
+    {
+        ::memcpy(reinterpret_cast<void*>(Dest + Index), std::addressof(Value), sizeof(T));
+    }
+}
@@ -0,0 +1,643 @@
+#pragma once
+#include "Utilities.h"
+#include "Allocator.h"
+#include "Array.h"
+#include "ArrayView.h"
+#include "Sort.h"
+
+#include <initializer_list>
+
+/*
+ * Flat containers - Associative containers that keep their keys sorted in a TArray. Lookups are a branchless binary
+ * search over contiguous keys, which beats node based maps for tables that are read much more often than they are
+ * modified. Inserting or removing a single key shifts the elements after it, so large batches should be added with
+ * the bulk constructor or Merge, which sort once.
+ */
+
+struct _FlatImpl
+{
+    // Index of the first key that is not less than Key, the loop compiles to conditional moves
+    template<typename TKey, typename TKeyArg, typename TLess, typename TSizeType>
+    static FORCEINLINE TSizeType LowerBound(const TKey* Keys, TSizeType Size, const TKeyArg& Key, const TLess& Less) noexcept
+    {
+        if (Size == 0)
+        {
+            return 0;
+        }
+
+        const TKey* Base   = Keys;
+        TSizeType   Length = Size;
+        while (Length > 1)
+        {
+            const TSizeType Half = Length / 2;
+            Base = Less(Base[Half], Key) ? Base + Half : Base;
+            Length -= Half;
+        }
+
+        return TSizeType(Base - Keys) + TSizeType(Less(*Base, Key));
+    }
+
+    template<typename TKey, typename TLess, typename TSizeType>
+    static Bool IsStrictlySorted(const TKey* Keys, TSizeType Size, const TLess& Less) noexcept
+    {
+        for (TSizeType Index = 1; Index < Size; Index++)
+        {
+            if (!Less(Keys[Index - 1], Keys[Index]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Sorts the keys and removes duplicates, keeping the last of the equal keys
+    template<typename TKey, typename TAllocator, typename TLess>
+    static void SortUnique(TArray<TKey, TAllocator>& Keys, const TLess& Less) noexcept
+    {
+        typedef typename TArray<TKey, TAllocator>::SizeType SizeType;
+        if (IsStrictlySorted(Keys.Data(), Keys.Size(), Less))
+        {
+            return;
+        }
+
+        TArray<SizeType> Order;
+        Order.ResizeUninitialized(Keys.Size());
+        for (SizeType Index = 0; Index < Keys.Size(); Index++)
+        {
+            Order[Index] = Index;
+        }
+
+        SortOrder(Keys, Order, Less);
+
+        TArray<TKey, TAllocator> NewKeys(Keys.GetAllocator());
+        NewKeys.Reserve(Order.Size());
+        for (SizeType Index = 0; Index < Order.Size(); Index++)
+        {
+            if (IsLastOfEqual(Keys, Order, Index, Less))
+            {
+                NewKeys.EmplaceBack(::Move(Keys[Order[Index]]));
+            }
+        }
+
+        Keys = ::Move(NewKeys);
+    }
+
+    // Sorts the keys and reorders the values with them, removes duplicates and keeps the last of the equal keys
+    template<typename TKey, typename TValue, typename TAllocator, typename TLess>
+    static void SortUnique(TArray<TKey, TAllocator>& Keys, TArray<TValue, TAllocator>& Values, const TLess& Less) noexcept
+    {
+        typedef typename TArray<TKey, TAllocator>::SizeType SizeType;
+        VALIDATE(Keys.Size() == Values.Size());
+
+        if (IsStrictlySorted(Keys.Data(), Keys.Size(), Less))
+        {
+            return;
+        }
+
+        TArray<SizeType> Order;
+        Order.ResizeUninitialized(Keys.Size());
+        for (SizeType Index = 0; Index < Keys.Size(); Index++)
+        {
+            Order[Index] = Index;
+        }
+
+        SortOrder(Keys, Order, Less);
+
+        TArray<TKey, TAllocator>   NewKeys(Keys.GetAllocator());
+        TArray<TValue, TAllocator> NewValues(Values.GetAllocator());
+        NewKeys.Reserve(Order.Size());
+        NewValues.Reserve(Order.Size());
+        for (SizeType Index = 0; Index < Order.Size(); Index++)
+        {
+            if (IsLastOfEqual(Keys, Order, Index, Less))
+            {
+                NewKeys.EmplaceBack(::Move(Keys[Order[Index]]));
+                NewValues.EmplaceBack(::Move(Values[Order[Index]]));
+            }
+        }
+
+        Keys   = ::Move(NewKeys);
+        Values = ::Move(NewValues);
+    }
+
+private:
+    // Sorts the indices by key, equal keys keep the order they were added in
+    template<typename TKey, typename TAllocator, typename TSizeType, typename TLess>
+    static void SortOrder(const TArray<TKey, TAllocator>& Keys, TArray<TSizeType>& Order, const TLess& Less) noexcept
+    {
+        Sort(Order, [&Keys, &Less](TSizeType Lhs, TSizeType Rhs)
+        {
+            if (Less(Keys[Lhs], Keys[Rhs]))
+            {
+                return true;
+            }
+
+            return !Less(Keys[Rhs], Keys[Lhs]) && (Lhs < Rhs);
+        });
+    }
+
+    template<typename TKey, typename TAllocator, typename TSizeType, typename TLess>
+    static Bool IsLastOfEqual(const TArray<TKey, TAllocator>& Keys, const TArray<TSizeType>& Order, TSizeType Index, const TLess& Less) noexcept
+    {
+        return (Index + 1 == Order.Size()) || Less(Keys[Order[Index]], Keys[Order[Index + 1]]);
+    }
+};
+
+// TFlatMapIterator - Iterates the keys and values of a TFlatMap together
+
+template<typename TMapType, typename TKey, typename TValue>
+class TFlatMapIterator
+{
+public:
+    typedef typename TMapType::SizeType SizeType;
+
+    struct Reference
+    {
+        const TKey& Key;
+        TValue&     Value;
+    };
+
+    TFlatMapIterator(TMapType* InMap, SizeType InIndex) noexcept
+        : mMap(InMap)
+        , mIndex(InIndex)
+    {
+    }
+
+    SizeType GetIndex() const noexcept { return mIndex; }
+
+    Reference operator*() const noexcept { return Reference{ mMap->KeyAt(mIndex), mMap->ValueAt(mIndex) }; }
+
+    TFlatMapIterator& operator++() noexcept
+    {
+        mIndex++;
+        return *this;
+    }
+
+    TFlatMapIterator operator++(Int32) noexcept
+    {
+        TFlatMapIterator Temp = *this;
+        mIndex++;
+        return Temp;
+    }
+
+    Bool operator==(const TFlatMapIterator& Other) const noexcept { return (mIndex == Other.mIndex); }
+    Bool operator!=(const TFlatMapIterator& Other) const noexcept { return (mIndex != Other.mIndex); }
+
+private:
+    TMapType* mMap;
+    SizeType  mIndex;
+};
+
+/*
+ * TFlatMap - Sorted map that stores the keys and the values in two separate TArrays, so that a search only touches
+ * the keys. Lookups accept any type that TLess can compare with the key.
+ */
+
+template<typename TKey, typename TValue, typename TLess = LessThan, typename TAllocator = Mallocator>
+class TFlatMap
+{
+public:
+    typedef TArray<TKey, TAllocator>   KeyArray;
+    typedef TArray<TValue, TAllocator> ValueArray;
+    typedef typename KeyArray::SizeType SizeType;
+
+    typedef TFlatMapIterator<TFlatMap, TKey, TValue>             Iterator;
+    typedef TFlatMapIterator<const TFlatMap, TKey, const TValue> ConstIterator;
+
+    TFlatMap() noexcept
+        : mKeys()
+        , mValues()
+        , mLess()
+    {
+    }
+
+    explicit TFlatMap(const TLess& InLess, const TAllocator& InAllocator = TAllocator()) noexcept
+        : mKeys(InAllocator)
+        , mValues(InAllocator)
+        , mLess(InLess)
+    {
+    }
+
+    // Takes unsorted keys and values and sorts them once, the last value wins for duplicate keys
+    TFlatMap(KeyArray&& InKeys, ValueArray&& InValues, const TLess& InLess = TLess()) noexcept
+        : mKeys(::Move(InKeys))
+        , mValues(::Move(InValues))
+        , mLess(InLess)
+    {
+        _FlatImpl::SortUnique(mKeys, mValues, mLess);
+    }
+
+    TFlatMap(const TFlatMap& Other) = default;
+    TFlatMap(TFlatMap&& Other) = default;
+
+    ~TFlatMap() = default;
+
+    template<typename TKeyArg>
+    SizeType LowerBound(const TKeyArg& Key) const noexcept
+    {
+        return _FlatImpl::LowerBound(mKeys.Data(), mKeys.Size(), Key, mLess);
+    }
+
+    // Index of the key or Size() if the map does not contain it
+    template<typename TKeyArg>
+    SizeType IndexOf(const TKeyArg& Key) const noexcept
+    {
+        const SizeType Index = LowerBound(Key);
+        return IsMatch(Index, Key) ? Index : Size();
+    }
+
+    template<typename TKeyArg>
+    TValue* Find(const TKeyArg& Key) noexcept
+    {
+        const SizeType Index = LowerBound(Key);
+        return IsMatch(Index, Key) ? std::addressof(mValues[Index]) : nullptr;
+    }
+
+    template<typename TKeyArg>
+    const TValue* Find(const TKeyArg& Key) const noexcept
+    {
+        const SizeType Index = LowerBound(Key);
+        return IsMatch(Index, Key) ? std::addressof(mValues[Index]) : nullptr;
+    }
+
+    template<typename TKeyArg>
+    Bool Contains(const TKeyArg& Key) const noexcept
+    {
+        return IsMatch(LowerBound(Key), Key);
+    }
+
+    // Constructs the value if the key is not in the map, otherwise the existing value is returned unchanged
+    template<typename TKeyArg, typename... TArgs>
+    TValue& Emplace(TKeyArg&& Key, TArgs&&... Args) noexcept
+    {
+        const SizeType Index = LowerBound(Key);
+        if (IsMatch(Index, Key))
+        {
+            return mValues[Index];
+        }
+
+        mKeys.Emplace(mKeys.Begin() + Index, ::Forward<TKeyArg>(Key));
+        return *mValues.Emplace(mValues.Begin() + Index, ::Forward<TArgs>(Args)...);
+    }
+
+    // Inserts the value or assigns it to the existing value of the key
+    template<typename TKeyArg, typename TValueArg>
+    TValue& Add(TKeyArg&& Key, TValueArg&& Value) noexcept
+    {
+        const SizeType Index = LowerBound(Key);
+        if (IsMatch(Index, Key))
+        {
+            mValues[Index] = ::Forward<TValueArg>(Value);
+            return mValues[Index];
+        }
+
+        mKeys.Emplace(mKeys.Begin() + Index, ::Forward<TKeyArg>(Key));
+        return *mValues.Emplace(mValues.Begin() + Index, ::Forward<TValueArg>(Value));
+    }
+
+    template<typename TKeyArg>
+    Bool Remove(const TKeyArg& Key) noexcept
+    {
+        const SizeType Index = LowerBound(Key);
+        if (!IsMatch(Index, Key))
+        {
+            return false;
+        }
+
+        RemoveAt(Index);
+        return true;
+    }
+
+    void RemoveAt(SizeType Index) noexcept
+    {
+        VALIDATE(Index < Size());
+        mKeys.Erase(mKeys.Begin() + Index);
+        mValues.Erase(mValues.Begin() + Index);
+    }
+
+    // Merges a batch of keys and values in one pass, values in the batch replace the values of existing keys
+    void Merge(KeyArray&& InKeys, ValueArray&& InValues) noexcept
+    {
+        _FlatImpl::SortUnique(InKeys, InValues, mLess);
+        if (InKeys.IsEmpty())
+        {
+            return;
+        }
+
+        // Batches that are larger than all keys in the map are appended
+        if (IsEmpty() || mLess(mKeys.Back(), InKeys.Front()))
+        {
+            mKeys.Append(::Move(InKeys));
+            mValues.Append(::Move(InValues));
+            return;
+        }
+
+        KeyArray   NewKeys(mKeys.GetAllocator());
+        ValueArray NewValues(mValues.GetAllocator());
+        NewKeys.Reserve(Size() + InKeys.Size());
+        NewValues.Reserve(Size() + InKeys.Size());
+
+        SizeType Index      = 0;
+        SizeType BatchIndex = 0;
+        while (Index < Size() && BatchIndex < InKeys.Size())
+        {
+            if (mLess(mKeys[Index], InKeys[BatchIndex]))
+            {
+                NewKeys.EmplaceBack(::Move(mKeys[Index]));
+                NewValues.EmplaceBack(::Move(mValues[Index]));
+                Index++;
+            }
+            else
+            {
+                // Skip the existing key if the batch replaces it
+                if (!mLess(InKeys[BatchIndex], mKeys[Index]))
+                {
+                    Index++;
+                }
+
+                NewKeys.EmplaceBack(::Move(InKeys[BatchIndex]));
+                NewValues.EmplaceBack(::Move(InValues[BatchIndex]));
+                BatchIndex++;
+            }
+        }
+
+        NewKeys.MoveAppend(TArrayView<TKey, SizeType>(mKeys.Data() + Index, mKeys.Data() + Size()));
+        NewValues.MoveAppend(TArrayView<TValue, SizeType>(mValues.Data() + Index, mValues.Data() + Size()));
+        NewKeys.MoveAppend(TArrayView<TKey, SizeType>(InKeys.Data() + BatchIndex, InKeys.Data() + InKeys.Size()));
+        NewValues.MoveAppend(TArrayView<TValue, SizeType>(InValues.Data() + BatchIndex, InValues.Data() + InValues.Size()));
+
+        mKeys   = ::Move(NewKeys);
+        mValues = ::Move(NewValues);
+    }
+
+    void Reserve(SizeType Capacity) noexcept
+    {
+        mKeys.Reserve(Capacity);
+        mValues.Reserve(Capacity);
+    }
+
+    void ShrinkToFit() noexcept
+    {
+        mKeys.ShrinkToFit();
+        mValues.ShrinkToFit();
+    }
+
+    void Clear() noexcept
+    {
+        mKeys.Clear();
+        mValues.Clear();
+    }
+
+    void Swap(TFlatMap& Other) noexcept
+    {
+        mKeys.Swap(Other.mKeys);
+        mValues.Swap(Other.mValues);
+
+        TLess TempLess(::Move(mLess));
+        mLess       = ::Move(Other.mLess);
+        Other.mLess = ::Move(TempLess);
+    }
+
+    Iterator Begin() noexcept { return Iterator(this, 0); }
+    Iterator End() noexcept { return Iterator(this, Size()); }
+
+    ConstIterator Begin() const noexcept { return ConstIterator(this, 0); }
+    ConstIterator End() const noexcept { return ConstIterator(this, Size()); }
+
+    const TKey& KeyAt(SizeType Index) const noexcept { return mKeys[Index]; }
+    TValue& ValueAt(SizeType Index) noexcept { return mValues[Index]; }
+    const TValue& ValueAt(SizeType Index) const noexcept { return mValues[Index]; }
+
+    // The keys can only be read, changing them would break the order
+    TArrayView<const TKey, SizeType> GetKeys() const noexcept { return TArrayView<const TKey, SizeType>(mKeys.Data(), mKeys.Data() + Size()); }
+    TArrayView<TValue, SizeType> GetValues() noexcept { return TArrayView<TValue, SizeType>(mValues.Data(), mValues.Data() + Size()); }
+    TArrayView<const TValue, SizeType> GetValues() const noexcept { return TArrayView<const TValue, SizeType>(mValues.Data(), mValues.Data() + Size()); }
+
+    Bool IsEmpty() const noexcept { return mKeys.IsEmpty(); }
+    SizeType Size() const noexcept { return mKeys.Size(); }
+    SizeType Capacity() const noexcept { return mKeys.Capacity(); }
+
+    template<typename TKeyArg>
+    TValue& At(const TKeyArg& Key) noexcept
+    {
+        TValue* Value = Find(Key);
+        VALIDATE(Value != nullptr);
+        return *Value;
+    }
+
+    template<typename TKeyArg>
+    const TValue& At(const TKeyArg& Key) const noexcept
+    {
+        const TValue* Value = Find(Key);
+        VALIDATE(Value != nullptr);
+        return *Value;
+    }
+
+    TFlatMap& operator=(const TFlatMap& Other) = default;
+    TFlatMap& operator=(TFlatMap&& Other) = default;
+
+    // Default constructs the value if the key is not in the map
+    template<typename TKeyArg>
+    TValue& operator[](TKeyArg&& Key) noexcept
+    {
+        return Emplace(::Forward<TKeyArg>(Key));
+    }
+
+    // STL iterator functions - Enables Range-based for-loops
+public:
+    Iterator begin() noexcept { return Begin(); }
+    Iterator end() noexcept { return End(); }
+
+    ConstIterator begin() const noexcept { return Begin(); }
+    ConstIterator end() const noexcept { return End(); }
+
+private:
+    template<typename TKeyArg>
+    Bool IsMatch(SizeType Index, const TKeyArg& Key) const noexcept
+    {
+        return (Index < Size()) && !mLess(Key, mKeys[Index]);
+    }
+
+    KeyArray   mKeys;
+    ValueArray mValues;
+    TLess      mLess;
+};
+
+/*
+ * TFlatSet - Sorted set of unique keys in a TArray
+ */
+
+template<typename TKey, typename TLess = LessThan, typename TAllocator = Mallocator>
+class TFlatSet
+{
+public:
+    typedef TArray<TKey, TAllocator>  KeyArray;
+    typedef typename KeyArray::SizeType SizeType;
+
+    typedef const TKey* Iterator;
+    typedef const TKey* ConstIterator;
+
+    TFlatSet() noexcept
+        : mKeys()
+        , mLess()
+    {
+    }
+
+    explicit TFlatSet(const TLess& InLess, const TAllocator& InAllocator = TAllocator()) noexcept
+        : mKeys(InAllocator)
+        , mLess(InLess)
+    {
+    }
+
+    // Takes unsorted keys and sorts them once
+    explicit TFlatSet(KeyArray&& InKeys, const TLess& InLess = TLess()) noexcept
+        : mKeys(::Move(InKeys))
+        , mLess(InLess)
+    {
+        _FlatImpl::SortUnique(mKeys, mLess);
+    }
+
+    TFlatSet(std::initializer_list<TKey> List, const TLess& InLess = TLess()) noexcept
+        : mKeys(List)
+        , mLess(InLess)
+    {
+        _FlatImpl::SortUnique(mKeys, mLess);
+    }
+
+    TFlatSet(const TFlatSet& Other) = default;
+    TFlatSet(TFlatSet&& Other) = default;
+
+    ~TFlatSet() = default;
+
+    template<typename TKeyArg>
+    SizeType LowerBound(const TKeyArg& Key) const noexcept
+    {
+        return _FlatImpl::LowerBound(mKeys.Data(), mKeys.Size(), Key, mLess);
+    }
+
+    // Index of the key or Size() if the set does not contain it
+    template<typename TKeyArg>
+    SizeType IndexOf(const TKeyArg& Key) const noexcept
+    {
+        const SizeType Index = LowerBound(Key);
+        return IsMatch(Index, Key) ? Index : Size();
+    }
+
+    template<typename TKeyArg>
+    Bool Contains(const TKeyArg& Key) const noexcept
+    {
+        return IsMatch(LowerBound(Key), Key);
+    }
+
+    // Returns false if the key was already in the set
+    template<typename TKeyArg>
+    Bool Add(TKeyArg&& Key) noexcept
+    {
+        const SizeType Index = LowerBound(Key);
+        if (IsMatch(Index, Key))
+        {
+            return false;
+        }
+
+        mKeys.Emplace(mKeys.Begin() + Index, ::Forward<TKeyArg>(Key));
+        return true;
+    }
+
+    template<typename TKeyArg>
+    Bool Remove(const TKeyArg& Key) noexcept
+    {
+        const SizeType Index = LowerBound(Key);
+        if (!IsMatch(Index, Key))
+        {
+            return false;
+        }
+
+        mKeys.Erase(mKeys.Begin() + Index);
+        return true;
+    }
+
+    // Merges a batch of keys in one pass
+    void Merge(KeyArray&& InKeys) noexcept
+    {
+        _FlatImpl::SortUnique(InKeys, mLess);
+        if (InKeys.IsEmpty())
+        {
+            return;
+        }
+
+        if (IsEmpty() || mLess(mKeys.Back(), InKeys.Front()))
+        {
+            mKeys.Append(::Move(InKeys));
+            return;
+        }
+
+        KeyArray NewKeys(mKeys.GetAllocator());
+        NewKeys.Reserve(Size() + InKeys.Size());
+
+        SizeType Index      = 0;
+        SizeType BatchIndex = 0;
+        while (Index < Size() && BatchIndex < InKeys.Size())
+        {
+            if (mLess(mKeys[Index], InKeys[BatchIndex]))
+            {
+                NewKeys.EmplaceBack(::Move(mKeys[Index++]));
+            }
+            else
+            {
+                if (!mLess(InKeys[BatchIndex], mKeys[Index]))
+                {
+                    Index++;
+                }
+
+                NewKeys.EmplaceBack(::Move(InKeys[BatchIndex++]));
+            }
+        }
+
+        NewKeys.MoveAppend(TArrayView<TKey, SizeType>(mKeys.Data() + Index, mKeys.Data() + Size()));
+        NewKeys.MoveAppend(TArrayView<TKey, SizeType>(InKeys.Data() + BatchIndex, InKeys.Data() + InKeys.Size()));
+        mKeys = ::Move(NewKeys);
+    }
+
+    void Reserve(SizeType Capacity) noexcept { mKeys.Reserve(Capacity); }
+    void ShrinkToFit() noexcept { mKeys.ShrinkToFit(); }
+    void Clear() noexcept { mKeys.Clear(); }
+
+    void Swap(TFlatSet& Other) noexcept
+    {
+        mKeys.Swap(Other.mKeys);
+
+        TLess TempLess(::Move(mLess));
+        mLess       = ::Move(Other.mLess);
+        Other.mLess = ::Move(TempLess);
+    }
+
+    ConstIterator Begin() const noexcept { return mKeys.Begin(); }
+    ConstIterator End() const noexcept { return mKeys.End(); }
+
+    const TKey& KeyAt(SizeType Index) const noexcept { return mKeys[Index]; }
+
+    TArrayView<const TKey, SizeType> GetKeys() const noexcept { return TArrayView<const TKey, SizeType>(mKeys.Data(), mKeys.Data() + Size()); }
+
+    Bool IsEmpty() const noexcept { return mKeys.IsEmpty(); }
+    SizeType Size() const noexcept { return mKeys.Size(); }
+    SizeType Capacity() const noexcept { return mKeys.Capacity(); }
+
+    TFlatSet& operator=(const TFlatSet& Other) = default;
+    TFlatSet& operator=(TFlatSet&& Other) = default;
+
+    // STL iterator functions - Enables Range-based for-loops
+public:
+    ConstIterator begin() const noexcept { return Begin(); }
+    ConstIterator end() const noexcept { return End(); }
+
+private:
+    template<typename TKeyArg>
+    Bool IsMatch(SizeType Index, const TKeyArg& Key) const noexcept
+    {
+        return (Index < Size()) && !mLess(Key, mKeys[Index]);
+    }
+
+    KeyArray mKeys;
+    TLess    mLess;
+};
@@ -1,6 +1,17 @@
 #pragma once
 #include "Utilities.h"
 #include "Allocator.h"
+#include "PoolAllocator.h"
+#include "TrackingAllocator.h"
+
+// FunctorAllocator - Allocator for functors that do not fit into TFunction, tracked under FunctorMemory when memory tracking is enabled
+
+#if ENABLE_MEMORY_TRACKING
+DECLARE_MEMORY_TAG(FunctorMemory);
+typedef TTrackingAllocator<PoolAllocator, FunctorMemory> FunctorAllocator;
+#else
+typedef PoolAllocator FunctorAllocator;
+#endif
 
 // TMemberFunction - Encapsulates a member function
 
@@ -80,13 +91,17 @@ inline TConstMemberFunction<T, TReturn(TArgs...)> BindFunction(const T* mThis, T
     return ::Move(TConstMemberFunction<T, TReturn(TArgs...)>(mThis, mFunc));
 }
 
-// TFunction - Encapsulates callables similar to std::function
+/*
+ * TFunction - Encapsulates callables similar to std::function. Functors that fit into InlineSize bytes, including the
+ * vtable pointer, are stored inside the TFunction, larger functors are allocated from the FunctorAllocator. The default
+ * size keeps a TFunction at 32 bytes.
+ */
 
-template<typename TInvokable>
+template<typename TInvokable, UInt32 InlineSize = 23>
 class TFunction;
 
-template<typename TReturn, typename... TArgs>
-class TFunction<TReturn(TArgs...)>
+template<typename TReturn, typename... TArgs, UInt32 InlineSize>
+class TFunction<TReturn(TArgs...), InlineSize>
 {
 private:  
     class IFunctor
@@ -98,6 +113,10 @@ private:
 
         virtual IFunctor* Clone(void* Memory) noexcept = 0;
         virtual IFunctor* Move(void* Memory) noexcept = 0;
+
+        // Functors that do not fit the stack buffer are allocated from the pool, which needs the size of the functor
+        virtual IFunctor* CloneToHeap() noexcept = 0;
+        virtual void DeleteFromHeap() noexcept = 0;
     };
     
     template<typename F>
@@ -141,6 +160,19 @@ private:
             return new(Memory) TGenericFunctor(::Move(*this));
         }
 
+        virtual IFunctor* CloneToHeap() noexcept override final
+        {
+            void* Memory = FunctorAllocator().Allocate(sizeof(TGenericFunctor), alignof(TGenericFunctor));
+            VALIDATE(Memory != nullptr);
+            return Clone(Memory);
+        }
+
+        virtual void DeleteFromHeap() noexcept override final
+        {
+            this->~TGenericFunctor();
+            FunctorAllocator().Free(reinterpret_cast<void*>(this), sizeof(TGenericFunctor), alignof(TGenericFunctor));
+        }
+
     private:
         F mFunctor;
     };
@@ -220,6 +252,12 @@ public:
         return (mFunc != nullptr);
     }
 
+    // True when the functor is stored inside the TFunction
+    Bool IsStackAllocated() const noexcept
+    {
+        return mStackAllocated;
+    }
+
     TFunction& operator=(const TFunction& Other) noexcept
     {
         if (this != &Other)
@@ -236,7 +274,7 @@ public:
         if (this != &Other)
         {
             InternalRelease();
-            InternalMoveConstruct(Other);
+            InternalMoveConstruct(::Move(Other));
         }
 
         return *this;
@@ -259,7 +297,7 @@ private:
             }
             else
             {
-                delete mFunc;
+                mFunc->DeleteFromHeap();
             }
 
             mFunc = nullptr;
@@ -276,14 +314,21 @@ private:
         }
         else
         {
-            mFunc = new TGenericFunctor<F>(::Forward<F>(Functor));
-            mSizeInBytes    = sizeof(TGenericFunctor<F>);
+            void* Memory = FunctorAllocator().Allocate(sizeof(TGenericFunctor<F>), alignof(TGenericFunctor<F>));
+            VALIDATE(Memory != nullptr);
+
+            mFunc = new(Memory) TGenericFunctor<F>(::Forward<F>(Functor));
             mStackAllocated = false;
         }
     }
     
     void InternalMoveConstruct(TFunction&& Other) noexcept
     {
+        if (!Other.mFunc)
+        {
+            return;
+        }
+
         if (Other.mStackAllocated)
         {
             mFunc = Other.mFunc->Move(reinterpret_cast<void*>(mStackBuffer));
@@ -291,14 +336,22 @@ private:
         }
         else
         {
-            mFunc = Other.mFunc->Move(::malloc(Other.mSizeInBytes));
-            mSizeInBytes    = Other.mSizeInBytes;
+            // Heap allocated functors are stolen
+            mFunc = Other.mFunc;
             mStackAllocated = false;
+
+            Other.mFunc = nullptr;
+            Other.mStackAllocated = true;
         }
     }
     
     void InternalCopyConstruct(const TFunction& Other) noexcept
     {
+        if (!Other.mFunc)
+        {
+            return;
+        }
+
         if (Other.mStackAllocated)
         {
             mFunc = Other.mFunc->Clone(reinterpret_cast<void*>(mStackBuffer));
@@ -306,8 +359,7 @@ private:
         }
         else
         {
-            mFunc = Other.mFunc->Clone(::malloc(Other.mSizeInBytes));
-            mSizeInBytes    = Other.mSizeInBytes;
+            mFunc = Other.mFunc->CloneToHeap();
             mStackAllocated = false;
         }
     }
@@ -317,15 +369,11 @@ private:
     {
         constexpr UInt32 StackSize   = sizeof(mStackBuffer);
         constexpr UInt32 FunctorSize = sizeof(TGenericFunctor<F>);
-        return FunctorSize <= StackSize;
+        return (FunctorSize <= StackSize) && (alignof(TGenericFunctor<F>) <= alignof(IFunctor*));
     }
 
 private:
-    IFunctor* mFunc      = nullptr;
+    IFunctor* mFunc = nullptr;
+    alignas(IFunctor*) Byte mStackBuffer[InlineSize];
     Bool mStackAllocated = true;
-    union
-    {
-        Byte   mStackBuffer[23];
-        UInt32 mSizeInBytes;
-    };
 };
@@ -0,0 +1,72 @@
+#pragma once
+#include "Types.h"
+
+/*
+ * Growth policies - Decide the capacity of a container when it runs out of space. GetCapacity receives the number
+ * of elements that must fit, the current capacity and the size of an element, and returns the new capacity in
+ * elements, which must be at least NumElements. When RoundToUsableSize is set, the container also claims the slack
+ * at the end of each block if the allocator can report the usable size of an allocation.
+ */
+
+// GeometricGrowth - Grows by 50%, keeps the memory overhead low
+
+struct GeometricGrowth
+{
+    static constexpr Bool RoundToUsableSize = false;
+
+    static UInt64 GetCapacity(UInt64 NumElements, UInt64 Capacity, UInt64 ElementSize) noexcept
+    {
+        (void)ElementSize;
+        return NumElements + (Capacity / 2);
+    }
+};
+
+// DoublingGrowth - Doubles the capacity, fewer reallocations for arrays that grow to a large size
+
+struct DoublingGrowth
+{
+    static constexpr Bool RoundToUsableSize = true;
+
+    static UInt64 GetCapacity(UInt64 NumElements, UInt64 Capacity, UInt64 ElementSize) noexcept
+    {
+        (void)ElementSize;
+
+        const UInt64 NewCapacity = (Capacity > 0) ? (Capacity * 2) : 4;
+        return (NewCapacity > NumElements) ? NewCapacity : NumElements;
+    }
+};
+
+// TPageRoundedGrowth - Rounds blocks of at least one page up to whole pages, smaller blocks are left as they are
+
+template<typename TBaseGrowth = DoublingGrowth, UInt64 PageSize = 4096>
+struct TPageRoundedGrowth
+{
+    static_assert((PageSize & (PageSize - 1)) == 0, "PageSize must be a power of two");
+
+    static constexpr Bool RoundToUsableSize = true;
+
+    static UInt64 GetCapacity(UInt64 NumElements, UInt64 Capacity, UInt64 ElementSize) noexcept
+    {
+        const UInt64 NewCapacity = TBaseGrowth::GetCapacity(NumElements, Capacity, ElementSize);
+        const UInt64 NumBytes    = NewCapacity * ElementSize;
+        if (NumBytes < PageSize)
+        {
+            return NewCapacity;
+        }
+
+        const UInt64 NumPageBytes = (NumBytes + (PageSize - 1)) & ~(PageSize - 1);
+        return NumPageBytes / ElementSize;
+    }
+};
+
+// SizeClassGrowth - Grows by 50% and then takes the rest of the allocator's size class, suited for many small arrays
+
+struct SizeClassGrowth
+{
+    static constexpr Bool RoundToUsableSize = true;
+
+    static UInt64 GetCapacity(UInt64 NumElements, UInt64 Capacity, UInt64 ElementSize) noexcept
+    {
+        return GeometricGrowth::GetCapacity(NumElements, Capacity, ElementSize);
+    }
+};
@@ -0,0 +1,287 @@
+#pragma once
+#include "Utilities.h"
+#include "Array.h"
+#include "ArrayView.h"
+#include "StaticArray.h"
+
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+    #include <intrin.h>
+#endif
+
+/*
+ * Hashing - THash is the default hasher of the hash containers and returns 64-bit hashes where all bits are well
+ * mixed, since the containers use both the low and the high bits. Specialize THash to hash other key types, composite
+ * keys can combine the hashes of their members with HashValues. The hashes are not stable across platforms or
+ * versions and must not be stored.
+ */
+
+struct _HashImpl
+{
+    static constexpr UInt64 Secret[4] = { 0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull };
+
+    // 64x64 to 128-bit multiply, returns the low half in Lhs and the high half in Rhs
+    static FORCEINLINE void Multiply(UInt64& Lhs, UInt64& Rhs) noexcept
+    {
+#if defined(__SIZEOF_INT128__)
+        const unsigned __int128 Result = static_cast<unsigned __int128>(Lhs) * Rhs;
+        Lhs = UInt64(Result);
+        Rhs = UInt64(Result >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        Lhs = _umul128(Lhs, Rhs, &Rhs);
+#else
+        const UInt64 LowLow   = (Lhs & 0xffffffff) * (Rhs & 0xffffffff);
+        const UInt64 HighLow  = (Lhs >> 32) * (Rhs & 0xffffffff);
+        const UInt64 LowHigh  = (Lhs & 0xffffffff) * (Rhs >> 32);
+        const UInt64 HighHigh = (Lhs >> 32) * (Rhs >> 32);
+        const UInt64 Middle   = (LowLow >> 32) + (HighLow & 0xffffffff) + LowHigh;
+        Lhs = (Middle << 32) | (LowLow & 0xffffffff);
+        Rhs = HighHigh + (HighLow >> 32) + (Middle >> 32);
+#endif
+    }
+
+    // Folds the 128-bit product, the core of wyhash
+    static FORCEINLINE UInt64 Mix(UInt64 Lhs, UInt64 Rhs) noexcept
+    {
+        Multiply(Lhs, Rhs);
+        return Lhs ^ Rhs;
+    }
+
+    static FORCEINLINE UInt64 Read8(const Byte* Data) noexcept
+    {
+        UInt64 Value;
+        ::memcpy(&Value, Data, sizeof(Value));
+        return Value;
+    }
+
+    static FORCEINLINE UInt64 Read4(const Byte* Data) noexcept
+    {
+        UInt32 Value;
+        ::memcpy(&Value, Data, sizeof(Value));
+        return Value;
+    }
+
+    // Reads 1 to 3 bytes
+    static FORCEINLINE UInt64 Read3(const Byte* Data, UInt64 Size) noexcept
+    {
+        return (UInt64(Data[0]) << 16) | (UInt64(Data[Size >> 1]) << 8) | UInt64(Data[Size - 1]);
+    }
+};
+
+// HashInteger - Bijective mixer, every bit of the input affects every bit of the result
+FORCEINLINE constexpr UInt64 HashInteger(UInt64 Value) noexcept
+{
+    Value ^= Value >> 27;
+    Value *= 0x3C79AC492BA7B653ull;
+    Value ^= Value >> 33;
+    Value *= 0x1C69B3F74AC4AE35ull;
+    Value ^= Value >> 27;
+    return Value;
+}
+
+// HashCombine - Combines a hash into a seed, the order of the hashes matters
+FORCEINLINE UInt64 HashCombine(UInt64 Seed, UInt64 Hash) noexcept
+{
+    return _HashImpl::Mix(Seed ^ _HashImpl::Secret[0], Hash ^ _HashImpl::Secret[1]);
+}
+
+// HashBytes - wyhash, reads 16 bytes per step and 48 bytes per step with three independent lanes for large inputs
+inline UInt64 HashBytes(const void* Data, UInt64 Size, UInt64 Seed = 0) noexcept
+{
+    const UInt64* Secret = _HashImpl::Secret;
+    const Byte*   Bytes  = reinterpret_cast<const Byte*>(Data);
+
+    Seed ^= _HashImpl::Mix(Seed ^ Secret[0], Secret[1]);
+
+    UInt64 Lhs;
+    UInt64 Rhs;
+    if (Size <= 16)
+    {
+        // Overlapping reads cover all sizes without a loop
+        if (Size >= 4)
+        {
+            const UInt64 Offset = (Size >> 3) << 2;
+            Lhs = (_HashImpl::Read4(Bytes) << 32) | _HashImpl::Read4(Bytes + Offset);
+            Rhs = (_HashImpl::Read4(Bytes + Size - 4) << 32) | _HashImpl::Read4(Bytes + Size - 4 - Offset);
+        }
+        else if (Size > 0)
+        {
+            Lhs = _HashImpl::Read3(Bytes, Size);
+            Rhs = 0;
+        }
+        else
+        {
+            Lhs = 0;
+            Rhs = 0;
+        }
+    }
+    else
+    {
+        UInt64 Remaining = Size;
+        if (Remaining > 48)
+        {
+            UInt64 Seed1 = Seed;
+            UInt64 Seed2 = Seed;
+            do
+            {
+                Seed  = _HashImpl::Mix(_HashImpl::Read8(Bytes) ^ Secret[1], _HashImpl::Read8(Bytes + 8) ^ Seed);
+                Seed1 = _HashImpl::Mix(_HashImpl::Read8(Bytes + 16) ^ Secret[2], _HashImpl::Read8(Bytes + 24) ^ Seed1);
+                Seed2 = _HashImpl::Mix(_HashImpl::Read8(Bytes + 32) ^ Secret[3], _HashImpl::Read8(Bytes + 40) ^ Seed2);
+                Bytes     += 48;
+                Remaining -= 48;
+            } while (Remaining > 48);
+
+            Seed ^= Seed1 ^ Seed2;
+        }
+
+        while (Remaining > 16)
+        {
+            Seed = _HashImpl::Mix(_HashImpl::Read8(Bytes) ^ Secret[1], _HashImpl::Read8(Bytes + 8) ^ Seed);
+            Bytes     += 16;
+            Remaining -= 16;
+        }
+
+        // The last 16 bytes, which may overlap the bytes that were already hashed
+        Lhs = _HashImpl::Read8(Bytes + Remaining - 16);
+        Rhs = _HashImpl::Read8(Bytes + Remaining - 8);
+    }
+
+    Lhs ^= Secret[1];
+    Rhs ^= Seed;
+    _HashImpl::Multiply(Lhs, Rhs);
+    return _HashImpl::Mix(Lhs ^ Secret[0] ^ Size, Rhs ^ Secret[1]);
+}
+
+// THash - Falls back to std::hash, which is the identity for integers in most standard libraries, so it is mixed again
+template<typename T, typename = Void>
+struct THash
+{
+    UInt64 operator()(const T& Value) const noexcept
+    {
+        return HashInteger(UInt64(std::hash<T>()(Value)));
+    }
+};
+
+template<typename T>
+struct THash<T, TEnableIf<std::is_integral<T>::value || std::is_enum<T>::value>>
+{
+    constexpr UInt64 operator()(T Value) const noexcept
+    {
+        return HashInteger(UInt64(Value));
+    }
+};
+
+// Zero and negative zero compare equal, so they must hash the same
+template<typename T>
+struct THash<T, TEnableIf<std::is_floating_point<T>::value>>
+{
+    UInt64 operator()(T Value) const noexcept
+    {
+        if (Value == T(0))
+        {
+            return HashInteger(0);
+        }
+
+        if constexpr (sizeof(T) == sizeof(UInt32))
+        {
+            UInt32 Bits;
+            ::memcpy(&Bits, &Value, sizeof(Bits));
+            return HashInteger(Bits);
+        }
+        else if constexpr (sizeof(T) == sizeof(UInt64))
+        {
+            UInt64 Bits;
+            ::memcpy(&Bits, &Value, sizeof(Bits));
+            return HashInteger(Bits);
+        }
+        else
+        {
+            return HashInteger(UInt64(std::hash<T>()(Value)));
+        }
+    }
+};
+
+template<typename T>
+struct THash<T*>
+{
+    UInt64 operator()(const T* Value) const noexcept
+    {
+        return HashInteger(UInt64(reinterpret_cast<size_t>(Value)));
+    }
+};
+
+// Strings hash their characters, std::string_view and string literals hash the same so they can be used for lookups
+template<>
+struct THash<std::string_view>
+{
+    UInt64 operator()(std::string_view String) const noexcept
+    {
+        return HashBytes(String.data(), String.size());
+    }
+};
+
+template<>
+struct THash<std::string> : public THash<std::string_view>
+{
+};
+
+// HashValues - Combines the hashes of several values, for composite keys
+template<typename... TArgs>
+inline UInt64 HashValues(const TArgs&... Values) noexcept
+{
+    UInt64 Hash = 0;
+    ((Hash = HashCombine(Hash, THash<TArgs>()(Values))), ...);
+    return Hash;
+}
+
+// HashRange - Hashes the elements of a contiguous range, in bulk when the bytes of the elements are their value
+template<typename T>
+inline UInt64 HashRange(const T* Data, UInt64 Size) noexcept
+{
+    if constexpr (std::has_unique_object_representations<T>::value)
+    {
+        return HashBytes(Data, Size * sizeof(T));
+    }
+    else
+    {
+        UInt64 Hash = HashInteger(Size);
+        for (UInt64 Index = 0; Index < Size; Index++)
+        {
+            Hash = HashCombine(Hash, THash<T>()(Data[Index]));
+        }
+
+        return Hash;
+    }
+}
+
+template<typename T, typename TAllocator, typename TGrowthPolicy>
+struct THash<TArray<T, TAllocator, TGrowthPolicy>>
+{
+    UInt64 operator()(const TArray<T, TAllocator, TGrowthPolicy>& Array) const noexcept
+    {
+        return HashRange(Array.Data(), Array.Size());
+    }
+};
+
+template<typename T, typename TSizeType>
+struct THash<TArrayView<T, TSizeType>>
+{
+    UInt64 operator()(const TArrayView<T, TSizeType>& View) const noexcept
+    {
+        return HashRange<std::remove_const_t<T>>(View.Data(), View.Size());
+    }
+};
+
+template<typename T, Int32 N>
+struct THash<TStaticArray<T, N>>
+{
+    UInt64 operator()(const TStaticArray<T, N>& Array) const noexcept
+    {
+        return HashRange(Array.Data(), Array.Size());
+    }
+};
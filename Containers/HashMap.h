@@ -0,0 +1,726 @@
+#pragma once
+#include "Utilities.h"
+#include "Allocator.h"
+#include "Hash.h"
+
+#include <cstring>
+#include <limits>
+
+// Define HASHMAP_USE_SSE2 as 0 to use the scalar groups on platforms with SSE2
+#ifndef HASHMAP_USE_SSE2
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define HASHMAP_USE_SSE2 1
+#else
+    #define HASHMAP_USE_SSE2 0
+#endif
+#endif
+
+#if HASHMAP_USE_SSE2
+    #include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+/*
+ * Hash table groups - Every slot has a control byte that is either Empty or the top 7 bits of the hash of its key.
+ * Lookups load a group of control bytes starting at the probe position and compare all of them with the hash at
+ * once, so the keys are only touched for slots that are likely to match. The first bytes of the control array are
+ * mirrored after its end, so that a group can be loaded from any position without wrapping.
+ */
+
+struct _HashGroup
+{
+    static constexpr UInt8 Empty = 0x80;
+
+    // Mask with one or more bits per control byte that is iterated from the lowest bit
+    struct BitMask
+    {
+        UInt64 Mask;
+
+        explicit operator Bool() const noexcept { return (Mask != 0); }
+
+        UInt32 LowestIndex() const noexcept
+        {
+#if defined(_MSC_VER)
+            unsigned long Index;
+            _BitScanForward64(&Index, Mask);
+            return UInt32(Index) >> Shift;
+#else
+            return UInt32(__builtin_ctzll(Mask)) >> Shift;
+#endif
+        }
+
+        void ClearLowest() noexcept { Mask &= (Mask - 1); }
+    };
+
+#if HASHMAP_USE_SSE2
+    static constexpr UInt32 Width = 16;
+    static constexpr UInt32 Shift = 0;
+
+    explicit _HashGroup(const UInt8* Control) noexcept
+        : mControl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Control)))
+    {
+    }
+
+    BitMask Match(UInt8 Hash) const noexcept
+    {
+        return BitMask{ UInt64(UInt32(_mm_movemask_epi8(_mm_cmpeq_epi8(mControl, _mm_set1_epi8(Char(Hash)))))) };
+    }
+
+    // Empty is the only control byte with the high bit set
+    BitMask MatchEmpty() const noexcept
+    {
+        return BitMask{ UInt64(UInt32(_mm_movemask_epi8(mControl))) };
+    }
+
+private:
+    __m128i mControl;
+#else
+    // Scalar fallback that works on 8 control bytes in a 64-bit integer, with the high bit of each byte as result
+    static constexpr UInt32 Width = 8;
+    static constexpr UInt32 Shift = 3;
+
+    static constexpr UInt64 LowBits  = 0x0101010101010101ull;
+    static constexpr UInt64 HighBits = 0x8080808080808080ull;
+
+    explicit _HashGroup(const UInt8* Control) noexcept
+    {
+        ::memcpy(&mControl, Control, sizeof(mControl));
+    }
+
+    // May report false positives for bytes above a real match, which are rejected by the key comparison
+    BitMask Match(UInt8 Hash) const noexcept
+    {
+        const UInt64 Bytes = mControl ^ (LowBits * Hash);
+        return BitMask{ (Bytes - LowBits) & ~Bytes & HighBits };
+    }
+
+    BitMask MatchEmpty() const noexcept
+    {
+        return BitMask{ mControl & HighBits };
+    }
+
+private:
+    UInt64 mControl;
+#endif
+};
+
+/*
+ * _THashTable - Open addressing hash table with linear probing that THashMap and THashSet are built on. The slots are
+ * stored in one allocation together with the control bytes, and each slot has a Key member that is hashed with
+ * THasher. Removing a key shifts the following keys of its probe sequence back instead of leaving a tombstone, so
+ * lookups never slow down after many removals.
+ */
+
+template<typename TSlot, typename THasher, typename TAllocator>
+class _THashTable
+{
+    // Growing relocates the slots into a new block, which cannot be the same block as the old one
+    static_assert(THasInlineStorage<TAllocator> == false, "Hash containers do not support allocators with inline storage");
+
+public:
+    typedef TAllocatorSizeType<TAllocator> SizeType;
+
+    static constexpr SizeType MinCapacity  = _HashGroup::Width;
+    static constexpr SizeType InvalidIndex = std::numeric_limits<SizeType>::max();
+
+    _THashTable(const TAllocator& InAllocator, const THasher& InHasher) noexcept
+        : mControl(nullptr)
+        , mSlots(nullptr)
+        , mSize(0)
+        , mCapacity(0)
+        , mHasher(InHasher)
+        , mAllocator(InAllocator)
+    {
+    }
+
+    _THashTable(const _THashTable& Other) noexcept
+        : mControl(nullptr)
+        , mSlots(nullptr)
+        , mSize(0)
+        , mCapacity(0)
+        , mHasher(Other.mHasher)
+        , mAllocator(Other.mAllocator)
+    {
+        InternalCopy(Other);
+    }
+
+    _THashTable(_THashTable&& Other) noexcept
+        : mControl(Other.mControl)
+        , mSlots(Other.mSlots)
+        , mSize(Other.mSize)
+        , mCapacity(Other.mCapacity)
+        , mHasher(::Move(Other.mHasher))
+        , mAllocator(::Move(Other.mAllocator))
+    {
+        Other.mControl  = nullptr;
+        Other.mSlots    = nullptr;
+        Other.mSize     = 0;
+        Other.mCapacity = 0;
+    }
+
+    ~_THashTable()
+    {
+        Clear();
+        InternalReleaseData();
+    }
+
+    template<typename TKeyArg>
+    UInt64 Hash(const TKeyArg& Key) const noexcept
+    {
+        return mHasher(Key);
+    }
+
+    // Index of the slot with the key or InvalidIndex
+    template<typename TKeyArg>
+    SizeType Find(const TKeyArg& Key, UInt64 Hash) const noexcept
+    {
+        if (mSize == 0)
+        {
+            return InvalidIndex;
+        }
+
+        const UInt8 ControlHash = GetControlHash(Hash);
+        SizeType    Index       = GetHomeIndex(Hash);
+        for (;;)
+        {
+            const _HashGroup Group(mControl + Index);
+            for (_HashGroup::BitMask Match = Group.Match(ControlHash); Match; Match.ClearLowest())
+            {
+                const SizeType SlotIndex = (Index + Match.LowestIndex()) & (mCapacity - 1);
+                if (mSlots[SlotIndex].Key == Key)
+                {
+                    return SlotIndex;
+                }
+            }
+
+            // The key would have been placed in the first empty slot of its probe sequence
+            if (Group.MatchEmpty())
+            {
+                return InvalidIndex;
+            }
+
+            Index = (Index + _HashGroup::Width) & (mCapacity - 1);
+        }
+    }
+
+    // Returns an uninitialized slot for a key that is not in the table, the caller constructs the slot
+    TSlot* InsertSlot(UInt64 Hash) noexcept
+    {
+        if (mSize >= GetMaxLoad(mCapacity))
+        {
+            InternalRehash((mCapacity == 0) ? MinCapacity : mCapacity * 2);
+        }
+
+        const SizeType Index = InternalFindEmpty(Hash);
+        InternalSetControl(Index, GetControlHash(Hash));
+        mSize++;
+        return mSlots + Index;
+    }
+
+    // Backward shift deletion, the slots after the removed slot move back until one is empty or in its home slot
+    void RemoveAt(SizeType Index) noexcept
+    {
+        VALIDATE(Index < mCapacity && IsOccupied(Index));
+
+        const SizeType Mask = mCapacity - 1;
+        mSlots[Index].~TSlot();
+
+        SizeType Hole = Index;
+        for (SizeType Next = (Hole + 1) & Mask; IsOccupied(Next); Next = (Next + 1) & Mask)
+        {
+            // A slot can fill the hole if the hole is between its home slot and itself
+            const SizeType Home = GetHomeIndex(mHasher(mSlots[Next].Key));
+            if (((Next - Home) & Mask) >= ((Next - Hole) & Mask))
+            {
+                InternalRelocateSlot(mSlots + Next, mSlots + Hole);
+                InternalSetControl(Hole, mControl[Next]);
+                Hole = Next;
+            }
+        }
+
+        InternalSetControl(Hole, _HashGroup::Empty);
+        mSize--;
+    }
+
+    // Makes room for Count elements, so that adding them does not rehash
+    void Reserve(SizeType Count) noexcept
+    {
+        const SizeType NewCapacity = InternalGetCapacityFor(Count);
+        if (NewCapacity > mCapacity)
+        {
+            InternalRehash(NewCapacity);
+        }
+    }
+
+    // Destroys the elements but keeps the memory
+    void Clear() noexcept
+    {
+        if (mSize > 0)
+        {
+            if constexpr (!std::is_trivially_destructible<TSlot>())
+            {
+                for (SizeType Index = 0; Index < mCapacity; Index++)
+                {
+                    if (IsOccupied(Index))
+                    {
+                        mSlots[Index].~TSlot();
+                    }
+                }
+            }
+
+            ::memset(mControl, _HashGroup::Empty, InternalGetControlSize(mCapacity));
+            mSize = 0;
+        }
+    }
+
+    Bool IsOccupied(SizeType Index) const noexcept { return (mControl[Index] & _HashGroup::Empty) == 0; }
+
+    TSlot& GetSlot(SizeType Index) noexcept { return mSlots[Index]; }
+    const TSlot& GetSlot(SizeType Index) const noexcept { return mSlots[Index]; }
+
+    TAllocator& GetAllocator() noexcept { return mAllocator; }
+    const TAllocator& GetAllocator() const noexcept { return mAllocator; }
+
+    SizeType Size() const noexcept { return mSize; }
+    SizeType Capacity() const noexcept { return mCapacity; }
+
+    _THashTable& operator=(const _THashTable& Other) noexcept
+    {
+        if (this != std::addressof(Other))
+        {
+            Clear();
+            mHasher = Other.mHasher;
+            InternalCopy(Other);
+        }
+
+        return *this;
+    }
+
+    _THashTable& operator=(_THashTable&& Other) noexcept
+    {
+        if (this != std::addressof(Other))
+        {
+            Clear();
+            InternalReleaseData();
+
+            mControl   = Other.mControl;
+            mSlots     = Other.mSlots;
+            mSize      = Other.mSize;
+            mCapacity  = Other.mCapacity;
+            mHasher    = ::Move(Other.mHasher);
+            mAllocator = ::Move(Other.mAllocator);
+
+            Other.mControl  = nullptr;
+            Other.mSlots    = nullptr;
+            Other.mSize     = 0;
+            Other.mCapacity = 0;
+        }
+
+        return *this;
+    }
+
+private:
+    // The home slot comes from the low bits of the hash and the control byte from the top 7 bits
+    static FORCEINLINE UInt8 GetControlHash(UInt64 Hash) noexcept { return UInt8(Hash >> 57); }
+    FORCEINLINE SizeType GetHomeIndex(UInt64 Hash) const noexcept { return SizeType(Hash) & (mCapacity - 1); }
+
+    // Keeps the probe sequences short, linear probing degrades quickly above a load of 7/8
+    static constexpr SizeType GetMaxLoad(SizeType Capacity) noexcept { return Capacity - (Capacity / 8); }
+
+    static constexpr UInt64 InternalGetControlSize(SizeType Capacity) noexcept
+    {
+        return UInt64(Capacity) + _HashGroup::Width - 1;
+    }
+
+    // The slots follow the control bytes in the same block
+    static constexpr UInt64 InternalGetSlotOffset(SizeType Capacity) noexcept
+    {
+        return (InternalGetControlSize(Capacity) + alignof(TSlot) - 1) & ~UInt64(alignof(TSlot) - 1);
+    }
+
+    static constexpr UInt64 InternalGetAlignment() noexcept
+    {
+        return (alignof(TSlot) > alignof(UInt64)) ? alignof(TSlot) : alignof(UInt64);
+    }
+
+    static SizeType InternalGetCapacityFor(SizeType Count) noexcept
+    {
+        SizeType Capacity = MinCapacity;
+        while (GetMaxLoad(Capacity) < Count)
+        {
+            VALIDATE(Capacity <= std::numeric_limits<SizeType>::max() / 2);
+            Capacity *= 2;
+        }
+
+        return Capacity;
+    }
+
+    SizeType InternalFindEmpty(UInt64 Hash) const noexcept
+    {
+        SizeType Index = GetHomeIndex(Hash);
+        for (;;)
+        {
+            const _HashGroup::BitMask Empty = _HashGroup(mControl + Index).MatchEmpty();
+            if (Empty)
+            {
+                return (Index + Empty.LowestIndex()) & (mCapacity - 1);
+            }
+
+            Index = (Index + _HashGroup::Width) & (mCapacity - 1);
+        }
+    }
+
+    FORCEINLINE void InternalSetControl(SizeType Index, UInt8 Control) noexcept
+    {
+        mControl[Index] = Control;
+
+        // The first bytes are mirrored after the end for groups that are loaded across the end
+        if (Index < _HashGroup::Width - 1)
+        {
+            mControl[mCapacity + Index] = Control;
+        }
+    }
+
+    void InternalRelocateSlot(TSlot* Source, TSlot* Dest) noexcept
+    {
+        if constexpr (TSlot::IsRelocatable)
+        {
+            ::memcpy(reinterpret_cast<void*>(Dest), reinterpret_cast<const void*>(Source), sizeof(TSlot));
+        }
+        else
+        {
+            new(reinterpret_cast<void*>(Dest)) TSlot(::Move(*Source));
+            Source->~TSlot();
+        }
+    }
+
+    void InternalAllocData(SizeType Capacity) noexcept
+    {
+        VALIDATE((Capacity & (Capacity - 1)) == 0 && Capacity >= MinCapacity);
+
+        const UInt64 SlotOffset = InternalGetSlotOffset(Capacity);
+        Byte* Block = reinterpret_cast<Byte*>(mAllocator.Allocate(SlotOffset + UInt64(Capacity) * sizeof(TSlot), InternalGetAlignment()));
+        VALIDATE(Block != nullptr);
+
+        mControl  = Block;
+        mSlots    = reinterpret_cast<TSlot*>(Block + SlotOffset);
+        mCapacity = Capacity;
+        ::memset(mControl, _HashGroup::Empty, InternalGetControlSize(Capacity));
+    }
+
+    void InternalReleaseData() noexcept
+    {
+        if (mControl)
+        {
+            mAllocator.Free(reinterpret_cast<void*>(mControl), InternalGetAlignment());
+            mControl  = nullptr;
+            mSlots    = nullptr;
+            mCapacity = 0;
+        }
+    }
+
+    void InternalRehash(SizeType NewCapacity) noexcept
+    {
+        UInt8*         OldControl  = mControl;
+        TSlot*         OldSlots    = mSlots;
+        const SizeType OldCapacity = mCapacity;
+
+        InternalAllocData(NewCapacity);
+        for (SizeType Index = 0; Index < OldCapacity; Index++)
+        {
+            if ((OldControl[Index] & _HashGroup::Empty) == 0)
+            {
+                const UInt64   Hash     = mHasher(OldSlots[Index].Key);
+                const SizeType NewIndex = InternalFindEmpty(Hash);
+                InternalSetControl(NewIndex, GetControlHash(Hash));
+                InternalRelocateSlot(OldSlots + Index, mSlots + NewIndex);
+            }
+        }
+
+        if (OldControl)
+        {
+            mAllocator.Free(reinterpret_cast<void*>(OldControl), InternalGetAlignment());
+        }
+    }
+
+    // Copies into the same slots, so that nothing is rehashed
+    void InternalCopy(const _THashTable& Other) noexcept
+    {
+        if (Other.mSize == 0)
+        {
+            return;
+        }
+
+        if (mCapacity != Other.mCapacity)
+        {
+            InternalReleaseData();
+            InternalAllocData(Other.mCapacity);
+        }
+
+        ::memcpy(mControl, Other.mControl, InternalGetControlSize(mCapacity));
+        for (SizeType Index = 0; Index < mCapacity; Index++)
+        {
+            if (IsOccupied(Index))
+            {
+                new(reinterpret_cast<void*>(mSlots + Index)) TSlot(Other.mSlots[Index]);
+            }
+        }
+
+        mSize = Other.mSize;
+    }
+
+    UInt8*     mControl;
+    TSlot*     mSlots;
+    SizeType   mSize;
+    SizeType   mCapacity;
+    THasher    mHasher;
+    TAllocator mAllocator;
+};
+
+template<typename TSlot, typename THasher, typename TAllocator>
+struct _TIsTriviallyRelocatable<_THashTable<TSlot, THasher, TAllocator>>
+{
+    static constexpr Bool Value = TIsTriviallyRelocatable<THasher> && TIsTriviallyRelocatable<TAllocator>;
+};
+
+// THashMapIterator - Iterates the occupied slots of a THashMap
+
+template<typename TMapType, typename TKey, typename TValue>
+class THashMapIterator
+{
+public:
+    typedef typename TMapType::SizeType SizeType;
+
+    struct Reference
+    {
+        const TKey& Key;
+        TValue&     Value;
+    };
+
+    THashMapIterator(TMapType* InMap, SizeType InIndex) noexcept
+        : mMap(InMap)
+        , mIndex(InIndex)
+    {
+        SkipEmpty();
+    }
+
+    SizeType GetIndex() const noexcept { return mIndex; }
+
+    Reference operator*() const noexcept { return Reference{ mMap->KeyAt(mIndex), mMap->ValueAt(mIndex) }; }
+
+    THashMapIterator& operator++() noexcept
+    {
+        mIndex++;
+        SkipEmpty();
+        return *this;
+    }
+
+    THashMapIterator operator++(Int32) noexcept
+    {
+        THashMapIterator Temp = *this;
+        ++(*this);
+        return Temp;
+    }
+
+    Bool operator==(const THashMapIterator& Other) const noexcept { return (mIndex == Other.mIndex); }
+    Bool operator!=(const THashMapIterator& Other) const noexcept { return (mIndex != Other.mIndex); }
+
+private:
+    void SkipEmpty() noexcept
+    {
+        while (mIndex < mMap->Capacity() && !mMap->IsOccupied(mIndex))
+        {
+            mIndex++;
+        }
+    }
+
+    TMapType* mMap;
+    SizeType  mIndex;
+};
+
+/*
+ * THashMap - Hash map that stores the keys and values inline in a _THashTable. Lookups accept any type that THasher
+ * can hash and that compares equal to the key with operator==, as long as it hashes the same as the equal key.
+ * Adding or removing keys invalidates iterators and pointers to values.
+ */
+
+template<typename TKey, typename TValue, typename THasher = THash<TKey>, typename TAllocator = Mallocator>
+class THashMap
+{
+    struct Slot
+    {
+        static constexpr Bool IsRelocatable = TIsTriviallyRelocatable<TKey> && TIsTriviallyRelocatable<TValue>;
+
+        TKey   Key;
+        TValue Value;
+    };
+
+    typedef _THashTable<Slot, THasher, TAllocator> TableType;
+
+public:
+    typedef typename TableType::SizeType SizeType;
+
+    typedef THashMapIterator<THashMap, TKey, TValue>             Iterator;
+    typedef THashMapIterator<const THashMap, TKey, const TValue> ConstIterator;
+
+    THashMap() noexcept
+        : mTable(TAllocator(), THasher())
+    {
+    }
+
+    explicit THashMap(const TAllocator& InAllocator, const THasher& InHasher = THasher()) noexcept
+        : mTable(InAllocator, InHasher)
+    {
+    }
+
+    THashMap(const THashMap& Other) = default;
+    THashMap(THashMap&& Other) = default;
+
+    ~THashMap() = default;
+
+    template<typename TKeyArg>
+    TValue* Find(const TKeyArg& Key) noexcept
+    {
+        const SizeType Index = mTable.Find(Key, mTable.Hash(Key));
+        return (Index != TableType::InvalidIndex) ? std::addressof(mTable.GetSlot(Index).Value) : nullptr;
+    }
+
+    template<typename TKeyArg>
+    const TValue* Find(const TKeyArg& Key) const noexcept
+    {
+        const SizeType Index = mTable.Find(Key, mTable.Hash(Key));
+        return (Index != TableType::InvalidIndex) ? std::addressof(mTable.GetSlot(Index).Value) : nullptr;
+    }
+
+    template<typename TKeyArg>
+    Bool Contains(const TKeyArg& Key) const noexcept
+    {
+        return (mTable.Find(Key, mTable.Hash(Key)) != TableType::InvalidIndex);
+    }
+
+    // Constructs the value if the key is not in the map, otherwise the existing value is returned unchanged
+    template<typename TKeyArg, typename... TArgs>
+    TValue& Emplace(TKeyArg&& Key, TArgs&&... Args) noexcept
+    {
+        const UInt64   Hash  = mTable.Hash(Key);
+        const SizeType Found = mTable.Find(Key, Hash);
+        if (Found != TableType::InvalidIndex)
+        {
+            return mTable.GetSlot(Found).Value;
+        }
+
+        Slot* NewSlot = mTable.InsertSlot(Hash);
+        new(reinterpret_cast<void*>(std::addressof(NewSlot->Key))) TKey(::Forward<TKeyArg>(Key));
+        new(reinterpret_cast<void*>(std::addressof(NewSlot->Value))) TValue(::Forward<TArgs>(Args)...);
+        return NewSlot->Value;
+    }
+
+    // Inserts the value or assigns it to the existing value of the key
+    template<typename TKeyArg, typename TValueArg>
+    TValue& Add(TKeyArg&& Key, TValueArg&& Value) noexcept
+    {
+        const UInt64   Hash  = mTable.Hash(Key);
+        const SizeType Found = mTable.Find(Key, Hash);
+        if (Found != TableType::InvalidIndex)
+        {
+            mTable.GetSlot(Found).Value = ::Forward<TValueArg>(Value);
+            return mTable.GetSlot(Found).Value;
+        }
+
+        Slot* NewSlot = mTable.InsertSlot(Hash);
+        new(reinterpret_cast<void*>(std::addressof(NewSlot->Key))) TKey(::Forward<TKeyArg>(Key));
+        new(reinterpret_cast<void*>(std::addressof(NewSlot->Value))) TValue(::Forward<TValueArg>(Value));
+        return NewSlot->Value;
+    }
+
+    template<typename TKeyArg>
+    Bool Remove(const TKeyArg& Key) noexcept
+    {
+        const SizeType Index = mTable.Find(Key, mTable.Hash(Key));
+        if (Index == TableType::InvalidIndex)
+        {
+            return false;
+        }
+
+        mTable.RemoveAt(Index);
+        return true;
+    }
+
+    // Makes room for Count elements, so that adding them does not rehash
+    void Reserve(SizeType Count) noexcept { mTable.Reserve(Count); }
+
+    // Destroys the elements but keeps the memory
+    void Clear() noexcept { mTable.Clear(); }
+
+    void Swap(THashMap& Other) noexcept
+    {
+        TableType Temp(::Move(mTable));
+        mTable       = ::Move(Other.mTable);
+        Other.mTable = ::Move(Temp);
+    }
+
+    Iterator Begin() noexcept { return Iterator(this, 0); }
+    Iterator End() noexcept { return Iterator(this, Capacity()); }
+
+    ConstIterator Begin() const noexcept { return ConstIterator(this, 0); }
+    ConstIterator End() const noexcept { return ConstIterator(this, Capacity()); }
+
+    // Slot access for iterators, the index must be an occupied slot
+    Bool IsOccupied(SizeType Index) const noexcept { return mTable.IsOccupied(Index); }
+    const TKey& KeyAt(SizeType Index) const noexcept { return mTable.GetSlot(Index).Key; }
+    TValue& ValueAt(SizeType Index) noexcept { return mTable.GetSlot(Index).Value; }
+    const TValue& ValueAt(SizeType Index) const noexcept { return mTable.GetSlot(Index).Value; }
+
+    TAllocator& GetAllocator() noexcept { return mTable.GetAllocator(); }
+    const TAllocator& GetAllocator() const noexcept { return mTable.GetAllocator(); }
+
+    Bool IsEmpty() const noexcept { return (mTable.Size() == 0); }
+    SizeType Size() const noexcept { return mTable.Size(); }
+    SizeType Capacity() const noexcept { return mTable.Capacity(); }
+
+    template<typename TKeyArg>
+    TValue& At(const TKeyArg& Key) noexcept
+    {
+        TValue* Value = Find(Key);
+        VALIDATE(Value != nullptr);
+        return *Value;
+    }
+
+    template<typename TKeyArg>
+    const TValue& At(const TKeyArg& Key) const noexcept
+    {
+        const TValue* Value = Find(Key);
+        VALIDATE(Value != nullptr);
+        return *Value;
+    }
+
+    THashMap& operator=(const THashMap& Other) = default;
+    THashMap& operator=(THashMap&& Other) = default;
+
+    // Default constructs the value if the key is not in the map
+    template<typename TKeyArg>
+    TValue& operator[](TKeyArg&& Key) noexcept
+    {
+        return Emplace(::Forward<TKeyArg>(Key));
+    }
+
+    // STL iterator functions - Enables Range-based for-loops
+public:
+    Iterator begin() noexcept { return Begin(); }
+    Iterator end() noexcept { return End(); }
+
+    ConstIterator begin() const noexcept { return Begin(); }
+    ConstIterator end() const noexcept { return End(); }
+
+private:
+    TableType mTable;
+};
+
+template<typename TKey, typename TValue, typename THasher, typename TAllocator>
+struct _TIsTriviallyRelocatable<THashMap<TKey, TValue, THasher, TAllocator>>
+{
+    static constexpr Bool Value = TIsTriviallyRelocatable<THasher> && TIsTriviallyRelocatable<TAllocator>;
+};
@@ -0,0 +1,194 @@
+#pragma once
+#include "HashMap.h"
+
+#include <initializer_list>
+#include <iterator>
+
+// THashSetIterator - Iterates the occupied slots of a THashSet
+
+template<typename TSetType, typename TKey>
+class THashSetIterator
+{
+public:
+    typedef typename TSetType::SizeType SizeType;
+
+    typedef std::forward_iterator_tag iterator_category;
+    typedef TKey                      value_type;
+    typedef Int64                     difference_type;
+    typedef const TKey*               pointer;
+    typedef const TKey&               reference;
+
+    THashSetIterator(const TSetType* InSet, SizeType InIndex) noexcept
+        : mSet(InSet)
+        , mIndex(InIndex)
+    {
+        SkipEmpty();
+    }
+
+    SizeType GetIndex() const noexcept { return mIndex; }
+
+    const TKey& operator*() const noexcept { return mSet->KeyAt(mIndex); }
+    const TKey* operator->() const noexcept { return std::addressof(mSet->KeyAt(mIndex)); }
+
+    THashSetIterator& operator++() noexcept
+    {
+        mIndex++;
+        SkipEmpty();
+        return *this;
+    }
+
+    THashSetIterator operator++(Int32) noexcept
+    {
+        THashSetIterator Temp = *this;
+        ++(*this);
+        return Temp;
+    }
+
+    Bool operator==(const THashSetIterator& Other) const noexcept { return (mIndex == Other.mIndex); }
+    Bool operator!=(const THashSetIterator& Other) const noexcept { return (mIndex != Other.mIndex); }
+
+private:
+    void SkipEmpty() noexcept
+    {
+        while (mIndex < mSet->Capacity() && !mSet->IsOccupied(mIndex))
+        {
+            mIndex++;
+        }
+    }
+
+    const TSetType* mSet;
+    SizeType        mIndex;
+};
+
+/*
+ * THashSet - Hash set of unique keys stored inline in a _THashTable, see THashMap
+ */
+
+template<typename TKey, typename THasher = THash<TKey>, typename TAllocator = Mallocator>
+class THashSet
+{
+    struct Slot
+    {
+        static constexpr Bool IsRelocatable = TIsTriviallyRelocatable<TKey>;
+
+        TKey Key;
+    };
+
+    typedef _THashTable<Slot, THasher, TAllocator> TableType;
+
+public:
+    typedef typename TableType::SizeType SizeType;
+
+    typedef THashSetIterator<THashSet, TKey> Iterator;
+    typedef THashSetIterator<THashSet, TKey> ConstIterator;
+
+    THashSet() noexcept
+        : mTable(TAllocator(), THasher())
+    {
+    }
+
+    explicit THashSet(const TAllocator& InAllocator, const THasher& InHasher = THasher()) noexcept
+        : mTable(InAllocator, InHasher)
+    {
+    }
+
+    THashSet(std::initializer_list<TKey> List, const TAllocator& InAllocator = TAllocator()) noexcept
+        : mTable(InAllocator, THasher())
+    {
+        mTable.Reserve(SizeType(List.size()));
+        for (const TKey& Key : List)
+        {
+            Add(Key);
+        }
+    }
+
+    THashSet(const THashSet& Other) = default;
+    THashSet(THashSet&& Other) = default;
+
+    ~THashSet() = default;
+
+    template<typename TKeyArg>
+    const TKey* Find(const TKeyArg& Key) const noexcept
+    {
+        const SizeType Index = mTable.Find(Key, mTable.Hash(Key));
+        return (Index != TableType::InvalidIndex) ? std::addressof(mTable.GetSlot(Index).Key) : nullptr;
+    }
+
+    template<typename TKeyArg>
+    Bool Contains(const TKeyArg& Key) const noexcept
+    {
+        return (mTable.Find(Key, mTable.Hash(Key)) != TableType::InvalidIndex);
+    }
+
+    // Returns false if the key was already in the set
+    template<typename TKeyArg>
+    Bool Add(TKeyArg&& Key) noexcept
+    {
+        const UInt64 Hash = mTable.Hash(Key);
+        if (mTable.Find(Key, Hash) != TableType::InvalidIndex)
+        {
+            return false;
+        }
+
+        Slot* NewSlot = mTable.InsertSlot(Hash);
+        new(reinterpret_cast<void*>(std::addressof(NewSlot->Key))) TKey(::Forward<TKeyArg>(Key));
+        return true;
+    }
+
+    template<typename TKeyArg>
+    Bool Remove(const TKeyArg& Key) noexcept
+    {
+        const SizeType Index = mTable.Find(Key, mTable.Hash(Key));
+        if (Index == TableType::InvalidIndex)
+        {
+            return false;
+        }
+
+        mTable.RemoveAt(Index);
+        return true;
+    }
+
+    // Makes room for Count elements, so that adding them does not rehash
+    void Reserve(SizeType Count) noexcept { mTable.Reserve(Count); }
+
+    // Destroys the elements but keeps the memory
+    void Clear() noexcept { mTable.Clear(); }
+
+    void Swap(THashSet& Other) noexcept
+    {
+        TableType Temp(::Move(mTable));
+        mTable       = ::Move(Other.mTable);
+        Other.mTable = ::Move(Temp);
+    }
+
+    ConstIterator Begin() const noexcept { return ConstIterator(this, 0); }
+    ConstIterator End() const noexcept { return ConstIterator(this, Capacity()); }
+
+    // Slot access for iterators, the index must be an occupied slot
+    Bool IsOccupied(SizeType Index) const noexcept { return mTable.IsOccupied(Index); }
+    const TKey& KeyAt(SizeType Index) const noexcept { return mTable.GetSlot(Index).Key; }
+
+    TAllocator& GetAllocator() noexcept { return mTable.GetAllocator(); }
+    const TAllocator& GetAllocator() const noexcept { return mTable.GetAllocator(); }
+
+    Bool IsEmpty() const noexcept { return (mTable.Size() == 0); }
+    SizeType Size() const noexcept { return mTable.Size(); }
+    SizeType Capacity() const noexcept { return mTable.Capacity(); }
+
+    THashSet& operator=(const THashSet& Other) = default;
+    THashSet& operator=(THashSet&& Other) = default;
+
+    // STL iterator functions - Enables Range-based for-loops
+public:
+    ConstIterator begin() const noexcept { return Begin(); }
+    ConstIterator end() const noexcept { return End(); }
+
+private:
+    TableType mTable;
+};
+
+template<typename TKey, typename THasher, typename TAllocator>
+struct _TIsTriviallyRelocatable<THashSet<TKey, THasher, TAllocator>>
+{
+    static constexpr Bool Value = TIsTriviallyRelocatable<THasher> && TIsTriviallyRelocatable<TAllocator>;
+};
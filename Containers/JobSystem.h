@@ -0,0 +1,500 @@
+#pragma once
+#include "Utilities.h"
+#include "Array.h"
+#include "Function.h"
+#include "PoolAllocator.h"
+#include "UniquePtr.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #include <emmintrin.h>
+    #define JOBSYSTEM_PAUSE() _mm_pause()
+#else
+    #define JOBSYSTEM_PAUSE() std::this_thread::yield()
+#endif
+
+/*
+ * TWorkStealingQueue - Chase-Lev deque of pointers with a fixed capacity. The owning thread pushes and pops at the
+ * bottom, any other thread steals from the top. The memory orders follow "Correct and Efficient Work-Stealing for Weak
+ * Memory Models" by Le, Pop, Cohen and Zappa Nardelli.
+ */
+
+template<typename T, UInt32 Capacity>
+class TWorkStealingQueue
+{
+    static_assert((Capacity > 0) && ((Capacity & (Capacity - 1)) == 0), "Capacity must be a power of two");
+
+    static constexpr Int64 Mask = Int64(Capacity) - 1;
+
+public:
+    TWorkStealingQueue() noexcept
+        : mTop(0)
+        , mBottom(0)
+        , mElements()
+    {
+    }
+
+    TWorkStealingQueue(const TWorkStealingQueue&) = delete;
+    TWorkStealingQueue& operator=(const TWorkStealingQueue&) = delete;
+
+    // Owner only, returns false when the queue is full
+    Bool Push(T* Element) noexcept
+    {
+        const Int64 Bottom = mBottom.load(std::memory_order_relaxed);
+        const Int64 Top    = mTop.load(std::memory_order_acquire);
+        if (Bottom - Top >= Int64(Capacity))
+        {
+            return false;
+        }
+
+        mElements[Bottom & Mask].store(Element, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        mBottom.store(Bottom + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Owner only, returns the most recently pushed element or nullptr when the queue is empty
+    T* Pop() noexcept
+    {
+        const Int64 Bottom = mBottom.load(std::memory_order_relaxed) - 1;
+        mBottom.store(Bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        Int64 Top = mTop.load(std::memory_order_relaxed);
+        if (Top > Bottom)
+        {
+            mBottom.store(Bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T* Element = mElements[Bottom & Mask].load(std::memory_order_relaxed);
+        if (Top == Bottom)
+        {
+            // The last element can be stolen at the same time, whoever moves the top first gets it
+            if (!mTop.compare_exchange_strong(Top, Top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                Element = nullptr;
+            }
+
+            mBottom.store(Bottom + 1, std::memory_order_relaxed);
+        }
+
+        return Element;
+    }
+
+    // Any thread, returns the oldest element or nullptr when the queue is empty or another thread took it first
+    T* Steal() noexcept
+    {
+        Int64 Top = mTop.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const Int64 Bottom = mBottom.load(std::memory_order_acquire);
+        if (Top >= Bottom)
+        {
+            return nullptr;
+        }
+
+        T* Element = mElements[Top & Mask].load(std::memory_order_relaxed);
+        if (!mTop.compare_exchange_strong(Top, Top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+
+        return Element;
+    }
+
+    // Only a snapshot when other threads use the queue
+    Int64 Size() const noexcept
+    {
+        const Int64 Bottom = mBottom.load(std::memory_order_relaxed);
+        const Int64 Top    = mTop.load(std::memory_order_relaxed);
+        return (Bottom > Top) ? Bottom - Top : 0;
+    }
+
+private:
+    // The owner writes the bottom and the thieves write the top, so they are kept on separate cache lines
+    alignas(64) std::atomic<Int64> mTop;
+    alignas(64) std::atomic<Int64> mBottom;
+    alignas(64) std::atomic<T*>    mElements[Capacity];
+};
+
+/*
+ * JobCounter - Counts the unfinished jobs that were started with it. A job that depends on other jobs waits for their
+ * counter with JobSystem::Wait, which runs other jobs in the meantime.
+ */
+
+class JobCounter
+{
+    friend class JobSystem;
+
+public:
+    JobCounter() noexcept
+        : mCount(0)
+    {
+    }
+
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    Bool IsDone() const noexcept
+    {
+        return (mCount.load(std::memory_order_acquire) == 0);
+    }
+
+    UInt32 GetCount() const noexcept
+    {
+        return mCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<UInt32> mCount;
+};
+
+/*
+ * JobSystem - Runs jobs on a fixed set of threads. Every thread has its own TWorkStealingQueue, new jobs are pushed to
+ * the queue of the thread that starts them and idle threads steal from a random victim. The thread that creates the
+ * system is one of its threads, jobs can be started from that thread and from other jobs. Waiting runs other jobs on the
+ * same stack, so a job must not wait for a job that can in turn wait for it.
+ */
+
+class JobSystem
+{
+public:
+    static constexpr UInt32 QueueCapacity = 4096;
+
+    // Captures of up to 32 bytes are stored inside the job, which makes a job one cache line
+    typedef TFunction<void(), 47> JobFunction;
+
+    // NumThreads includes the calling thread, zero uses one thread per hardware thread
+    explicit JobSystem(UInt32 NumThreads = 0) noexcept
+        : mWorkers()
+        , mNumQueuedJobs(0)
+        , mNumSleeping(0)
+        , mIsStopping(false)
+        , mMutex()
+        , mWakeCondition()
+        , mPreviousContext(GetThreadContext())
+    {
+        if (NumThreads == 0)
+        {
+            NumThreads = std::thread::hardware_concurrency();
+        }
+
+        if (NumThreads == 0)
+        {
+            NumThreads = 1;
+        }
+
+        mWorkers.Reserve(NumThreads);
+        for (UInt32 Index = 0; Index < NumThreads; Index++)
+        {
+            mWorkers.EmplaceBack(MakeUnique<WorkerData>(Index));
+        }
+
+        GetThreadContext() = ThreadContext{ this, 0 };
+
+        // The threads are started once all queues exist, since they steal from each other
+        for (UInt32 Index = 1; Index < NumThreads; Index++)
+        {
+            mWorkers[Index]->Thread = std::thread(&JobSystem::WorkerMain, this, Index);
+        }
+    }
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Finishes all jobs that are still queued
+    ~JobSystem()
+    {
+        WorkerData& Worker = GetCurrentWorker();
+
+        UInt32 NumSpins = 0;
+        while (mNumQueuedJobs.load(std::memory_order_acquire) > 0)
+        {
+            if (TryRunJob(Worker))
+            {
+                NumSpins = 0;
+            }
+            else
+            {
+                Backoff(NumSpins);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> Lock(mMutex);
+            mIsStopping.store(true, std::memory_order_release);
+        }
+
+        mWakeCondition.notify_all();
+        for (UInt32 Index = 1; Index < mWorkers.Size(); Index++)
+        {
+            mWorkers[Index]->Thread.join();
+        }
+
+        GetThreadContext() = mPreviousContext;
+    }
+
+    // Starts a job, Counter is incremented now and decremented once the job has finished
+    template<typename F>
+    void Run(F&& Function, JobCounter* Counter = nullptr) noexcept
+    {
+        WorkerData& Worker = GetCurrentWorker();
+        if (Counter)
+        {
+            Counter->mCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void* Memory = PoolAllocator().Allocate(sizeof(Job), alignof(Job));
+        VALIDATE(Memory != nullptr);
+
+        Job* NewJob = new(Memory) Job(::Forward<F>(Function), Counter);
+
+        mNumQueuedJobs.fetch_add(1, std::memory_order_seq_cst);
+        if (!Worker.Queue.Push(NewJob))
+        {
+            // The queue is full, so the job runs right away like a function call would
+            mNumQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            Execute(NewJob);
+            return;
+        }
+
+        // Pairs with the increment of mNumSleeping in WorkerMain, either this thread sees the sleeper or the sleeper sees the job
+        if (mNumSleeping.load(std::memory_order_seq_cst) > 0)
+        {
+            std::lock_guard<std::mutex> Lock(mMutex);
+            mWakeCondition.notify_one();
+        }
+    }
+
+    // Runs queued jobs until all jobs started with Counter have finished
+    void Wait(const JobCounter& Counter) noexcept
+    {
+        WorkerData& Worker = GetCurrentWorker();
+
+        UInt32 NumSpins = 0;
+        while (!Counter.IsDone())
+        {
+            if (TryRunJob(Worker))
+            {
+                NumSpins = 0;
+            }
+            else
+            {
+                Backoff(NumSpins);
+            }
+        }
+    }
+
+    UInt32 GetNumThreads() const noexcept
+    {
+        return mWorkers.Size();
+    }
+
+    // The system that the calling thread belongs to, or nullptr
+    static JobSystem* GetCurrent() noexcept
+    {
+        return GetThreadContext().System;
+    }
+
+    // Index of the calling thread in this system, the creating thread is zero
+    UInt32 GetThreadIndex() const noexcept
+    {
+        VALIDATE(GetThreadContext().System == this);
+        return GetThreadContext().Index;
+    }
+
+    UInt64 GetNumStolenJobs() const noexcept
+    {
+        UInt64 NumStolen = 0;
+        for (const TUniquePtr<WorkerData>& Worker : mWorkers)
+        {
+            NumStolen += Worker->NumStolen.load(std::memory_order_relaxed);
+        }
+
+        return NumStolen;
+    }
+
+private:
+    struct Job
+    {
+        template<typename F>
+        Job(F&& InFunction, JobCounter* InCounter) noexcept
+            : Function(::Forward<F>(InFunction))
+            , Counter(InCounter)
+        {
+        }
+
+        JobFunction Function;
+        JobCounter* Counter;
+    };
+
+    struct WorkerData
+    {
+        explicit WorkerData(UInt32 InIndex) noexcept
+            : Queue()
+            , Thread()
+            , Index(InIndex)
+            , RandomState((InIndex + 1) * 0x9E3779B9u)
+            , NumStolen(0)
+        {
+        }
+
+        TWorkStealingQueue<Job, QueueCapacity> Queue;
+
+        std::thread         Thread;
+        UInt32              Index;
+        UInt32              RandomState;
+        std::atomic<UInt64> NumStolen;
+    };
+
+    struct ThreadContext
+    {
+        JobSystem* System = nullptr;
+        UInt32     Index  = 0;
+    };
+
+    // Spins this many times before a thread without work goes to sleep
+    static constexpr UInt32 SpinCount = 1024;
+
+    static ThreadContext& GetThreadContext() noexcept
+    {
+        static thread_local ThreadContext Context;
+        return Context;
+    }
+
+    // Pauses for the first iterations and then gives the core to other threads
+    static void Backoff(UInt32& NumSpins) noexcept
+    {
+        if (NumSpins < 64)
+        {
+            JOBSYSTEM_PAUSE();
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+
+        NumSpins++;
+    }
+
+    WorkerData& GetCurrentWorker() const noexcept
+    {
+        const ThreadContext& Context = GetThreadContext();
+        VALIDATE(Context.System == this);
+        return *mWorkers[Context.Index];
+    }
+
+    Job* StealJob(WorkerData& Worker) noexcept
+    {
+        const UInt32 NumWorkers = mWorkers.Size();
+
+        // Xorshift, which is enough to spread the thieves over the victims
+        Worker.RandomState ^= Worker.RandomState << 13;
+        Worker.RandomState ^= Worker.RandomState >> 17;
+        Worker.RandomState ^= Worker.RandomState << 5;
+
+        UInt32 Victim = Worker.RandomState % NumWorkers;
+        for (UInt32 Attempt = 0; Attempt < NumWorkers; Attempt++)
+        {
+            if (Victim != Worker.Index)
+            {
+                if (Job* StolenJob = mWorkers[Victim]->Queue.Steal())
+                {
+                    Worker.NumStolen.fetch_add(1, std::memory_order_relaxed);
+                    return StolenJob;
+                }
+            }
+
+            Victim = (Victim + 1 == NumWorkers) ? 0 : Victim + 1;
+        }
+
+        return nullptr;
+    }
+
+    Bool TryRunJob(WorkerData& Worker) noexcept
+    {
+        Job* NextJob = Worker.Queue.Pop();
+        if (!NextJob)
+        {
+            NextJob = StealJob(Worker);
+            if (!NextJob)
+            {
+                return false;
+            }
+        }
+
+        mNumQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        Execute(NextJob);
+        return true;
+    }
+
+    static void Execute(Job* InJob) noexcept
+    {
+        InJob->Function();
+
+        // The job is released before the counter is decremented, so nothing refers to the waiting thread afterwards
+        JobCounter* Counter = InJob->Counter;
+        InJob->~Job();
+        PoolAllocator().Free(reinterpret_cast<void*>(InJob), sizeof(Job), alignof(Job));
+
+        if (Counter)
+        {
+            Counter->mCount.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    void WorkerMain(UInt32 Index) noexcept
+    {
+        GetThreadContext() = ThreadContext{ this, Index };
+        WorkerData& Worker = *mWorkers[Index];
+
+        UInt32 NumSpins = 0;
+        while (true)
+        {
+            if (TryRunJob(Worker))
+            {
+                NumSpins = 0;
+                continue;
+            }
+
+            if (mIsStopping.load(std::memory_order_acquire) && (mNumQueuedJobs.load(std::memory_order_acquire) == 0))
+            {
+                break;
+            }
+
+            if (NumSpins < SpinCount)
+            {
+                Backoff(NumSpins);
+                continue;
+            }
+
+            NumSpins = 0;
+
+            std::unique_lock<std::mutex> Lock(mMutex);
+            mNumSleeping.fetch_add(1, std::memory_order_seq_cst);
+            mWakeCondition.wait(Lock, [this]()
+            {
+                return (mNumQueuedJobs.load(std::memory_order_seq_cst) > 0) || mIsStopping.load(std::memory_order_acquire);
+            });
+
+            mNumSleeping.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        GetThreadContext() = ThreadContext();
+    }
+
+    TArray<TUniquePtr<WorkerData>> mWorkers;
+
+    // Jobs that are in a queue, which is what sleeping threads wait for
+    alignas(64) std::atomic<UInt32> mNumQueuedJobs;
+    alignas(64) std::atomic<UInt32> mNumSleeping;
+    std::atomic<Bool>               mIsStopping;
+
+    std::mutex              mMutex;
+    std::condition_variable mWakeCondition;
+    ThreadContext           mPreviousContext;
+};
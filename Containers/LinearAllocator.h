@@ -0,0 +1,223 @@
+#pragma once
+#include "Utilities.h"
+#include "Allocator.h"
+
+/*
+ * TLinearArena - Hands out memory by bumping an offset into large chunks that are requested from the backing
+ * allocator. Single allocations are never freed, instead the arena is rewound to a marker or reset as a whole,
+ * and the chunks are kept and reused for the next allocations. Not thread-safe.
+ */
+
+template<typename TBackingAllocator = Mallocator>
+class TLinearArena
+{
+    struct ChunkHeader
+    {
+        ChunkHeader* Next;
+        UInt64       Size;
+        UInt64       Offset;
+    };
+
+    static constexpr UInt64 ChunkAlignment = alignof(std::max_align_t);
+    static constexpr UInt64 HeaderSize     = (sizeof(ChunkHeader) + (ChunkAlignment - 1)) & ~(ChunkAlignment - 1);
+
+public:
+    // Position in the arena that can be rewound to, all allocations made after it are released
+    struct Marker
+    {
+        ChunkHeader* Chunk;
+        UInt64       Offset;
+    };
+
+    explicit TLinearArena(UInt64 InChunkSize = 64 * 1024) noexcept
+        : mFirstChunk(nullptr)
+        , mCurrentChunk(nullptr)
+        , mChunkSize(InChunkSize)
+        , mBackingAllocator()
+    {
+    }
+
+    TLinearArena(const TLinearArena&) = delete;
+    TLinearArena& operator=(const TLinearArena&) = delete;
+
+    ~TLinearArena()
+    {
+        ChunkHeader* Chunk = mFirstChunk;
+        while (Chunk)
+        {
+            ChunkHeader* Next = Chunk->Next;
+            mBackingAllocator.Free(reinterpret_cast<void*>(Chunk), ChunkAlignment);
+            Chunk = Next;
+        }
+    }
+
+    void* Allocate(UInt64 Size, UInt64 Alignment) noexcept
+    {
+        if (mCurrentChunk)
+        {
+            void* Ptr = InternalAllocateFromChunk(mCurrentChunk, Size, Alignment);
+            if (Ptr)
+            {
+                return Ptr;
+            }
+        }
+
+        ChunkHeader* Chunk = InternalGetNextChunk(Size, Alignment);
+        if (!Chunk)
+        {
+            return nullptr;
+        }
+
+        mCurrentChunk = Chunk;
+        return InternalAllocateFromChunk(Chunk, Size, Alignment);
+    }
+
+    Marker GetMarker() const noexcept
+    {
+        return Marker{ mCurrentChunk, mCurrentChunk ? mCurrentChunk->Offset : 0 };
+    }
+
+    void Rewind(const Marker& InMarker) noexcept
+    {
+        if (InMarker.Chunk)
+        {
+            mCurrentChunk         = InMarker.Chunk;
+            mCurrentChunk->Offset = InMarker.Offset;
+        }
+        else
+        {
+            Reset();
+        }
+    }
+
+    void Reset() noexcept
+    {
+        mCurrentChunk = mFirstChunk;
+        if (mCurrentChunk)
+        {
+            mCurrentChunk->Offset = 0;
+        }
+    }
+
+    UInt64 GetChunkSize() const noexcept { return mChunkSize; }
+
+private:
+    static void* InternalAllocateFromChunk(ChunkHeader* Chunk, UInt64 Size, UInt64 Alignment) noexcept
+    {
+        Byte*        ChunkData = reinterpret_cast<Byte*>(Chunk) + HeaderSize;
+        const UInt64 Address   = reinterpret_cast<UInt64>(ChunkData + Chunk->Offset);
+        const UInt64 Aligned   = (Address + (Alignment - 1)) & ~(Alignment - 1);
+        const UInt64 Offset    = Chunk->Offset + (Aligned - Address);
+        if (Offset > Chunk->Size || Size > (Chunk->Size - Offset))
+        {
+            return nullptr;
+        }
+
+        Chunk->Offset = Offset + Size;
+        return reinterpret_cast<void*>(ChunkData + Offset);
+    }
+
+    // Reuses the chunk after the current one if it is large enough, otherwise a new chunk is linked in after it
+    ChunkHeader* InternalGetNextChunk(UInt64 Size, UInt64 Alignment) noexcept
+    {
+        const UInt64 RequiredSize = Size + ((Alignment > ChunkAlignment) ? Alignment : 0);
+
+        ChunkHeader* Next = mCurrentChunk ? mCurrentChunk->Next : mFirstChunk;
+        if (Next && Next->Size >= RequiredSize)
+        {
+            Next->Offset = 0;
+            return Next;
+        }
+
+        const UInt64 ChunkSize = (RequiredSize > mChunkSize) ? RequiredSize : mChunkSize;
+        ChunkHeader* Chunk     = reinterpret_cast<ChunkHeader*>(mBackingAllocator.Allocate(HeaderSize + ChunkSize, ChunkAlignment));
+        if (!Chunk)
+        {
+            return nullptr;
+        }
+
+        Chunk->Next   = Next;
+        Chunk->Size   = ChunkSize;
+        Chunk->Offset = 0;
+
+        if (mCurrentChunk)
+        {
+            mCurrentChunk->Next = Chunk;
+        }
+        else
+        {
+            mFirstChunk = Chunk;
+        }
+
+        return Chunk;
+    }
+
+    ChunkHeader* mFirstChunk;
+    ChunkHeader* mCurrentChunk;
+    UInt64       mChunkSize;
+    TBackingAllocator mBackingAllocator;
+};
+
+/*
+ * TLinearArenaScope - Rewinds the arena to the position it had when the scope was entered. Containers that
+ * allocated from the arena inside the scope must be destroyed before the scope ends.
+ */
+
+template<typename TBackingAllocator = Mallocator>
+class TLinearArenaScope
+{
+public:
+    explicit TLinearArenaScope(TLinearArena<TBackingAllocator>& InArena) noexcept
+        : mArena(InArena)
+        , mMarker(InArena.GetMarker())
+    {
+    }
+
+    TLinearArenaScope(const TLinearArenaScope&) = delete;
+    TLinearArenaScope& operator=(const TLinearArenaScope&) = delete;
+
+    ~TLinearArenaScope()
+    {
+        mArena.Rewind(mMarker);
+    }
+
+private:
+    TLinearArena<TBackingAllocator>& mArena;
+    typename TLinearArena<TBackingAllocator>::Marker mMarker;
+};
+
+/*
+ * TLinearAllocator - Allocator that refers to a TLinearArena, Free does nothing since the memory is released when
+ * the arena is rewound or reset. Pass it, or the arena, to the constructor of the container.
+ */
+
+template<typename TBackingAllocator = Mallocator>
+struct TLinearAllocator
+{
+    TLinearAllocator() noexcept
+        : mArena(nullptr)
+    {
+    }
+
+    TLinearAllocator(TLinearArena<TBackingAllocator>& InArena) noexcept
+        : mArena(&InArena)
+    {
+    }
+
+    void* Allocate(UInt64 Size, UInt64 Alignment) noexcept
+    {
+        VALIDATE(mArena != nullptr);
+        return mArena->Allocate(Size, Alignment);
+    }
+
+    void Free(void* Ptr, UInt64 Alignment) noexcept
+    {
+        UNREFERENCED_VARIABLE(Ptr);
+        UNREFERENCED_VARIABLE(Alignment);
+    }
+
+    TLinearArena<TBackingAllocator>* GetArena() const noexcept { return mArena; }
+
+private:
+    TLinearArena<TBackingAllocator>* mArena;
+};
@@ -0,0 +1,236 @@
+#pragma once
+#include "Utilities.h"
+#include "Array.h"
+#include "ArrayView.h"
+#include "JobSystem.h"
+
+#include <atomic>
+
+/*
+ * ParallelFor, ParallelReduce and ParallelTransform - Split a view into chunks that start on a cache line and run the
+ * body on the threads of a JobSystem. The chunks are claimed from a shared counter, so threads that finish early take
+ * more chunks. The body is a template parameter that is inlined into the loop over a chunk, only starting a thread
+ * goes through a TFunction. Without a JobSystem, the system of the calling thread is used. Jobs can only be pushed
+ * by the threads of a JobSystem, so threads that do not belong to the system run the body themselves.
+ */
+
+struct _ParallelImpl
+{
+    static constexpr UInt64 LineSize = 64;
+
+    // Chunks are at least this large so that claiming a chunk costs little compared to processing it
+    static constexpr UInt64 MinChunkBytes = 16 * 1024;
+
+    // More chunks than threads, so that a slow thread does not hold up the others
+    static constexpr UInt64 ChunksPerThread = 8;
+
+    static constexpr UInt64 GreatestCommonDivisor(UInt64 Lhs, UInt64 Rhs) noexcept
+    {
+        return (Rhs == 0) ? Lhs : GreatestCommonDivisor(Rhs, Lhs % Rhs);
+    }
+
+    // Chunk 0 also holds the elements before the first element that starts a cache line
+    struct Partition
+    {
+        UInt64 Size;
+        UInt64 HeadSize;
+        UInt64 ChunkSize;
+        UInt64 NumChunks;
+
+        UInt64 GetBegin(UInt64 Chunk) const noexcept
+        {
+            return (Chunk == 0) ? 0 : HeadSize + Chunk * ChunkSize;
+        }
+
+        UInt64 GetEnd(UInt64 Chunk) const noexcept
+        {
+            const UInt64 End = HeadSize + (Chunk + 1) * ChunkSize;
+            return (End < Size) ? End : Size;
+        }
+    };
+
+    template<typename T>
+    static Partition MakePartition(const T* Data, UInt64 Size, UInt32 NumThreads) noexcept
+    {
+        // Every LineElements elements the address is at the same offset within a cache line
+        constexpr UInt64 LineElements = LineSize / GreatestCommonDivisor(sizeof(T), LineSize);
+
+        const UInt64 Address  = UInt64(reinterpret_cast<size_t>(Data));
+        UInt64       HeadSize = 0;
+        while ((HeadSize < LineElements) && (((Address + HeadSize * sizeof(T)) % LineSize) != 0))
+        {
+            HeadSize++;
+        }
+
+        // Elements that are less aligned than their size never start a cache line
+        if (HeadSize == LineElements)
+        {
+            HeadSize = 0;
+        }
+
+        const UInt64 MinChunkSize    = (MinChunkBytes + sizeof(T) - 1) / sizeof(T);
+        const UInt64 TargetChunkSize = (Size + (UInt64(NumThreads) * ChunksPerThread) - 1) / (UInt64(NumThreads) * ChunksPerThread);
+
+        UInt64 ChunkSize = (TargetChunkSize > MinChunkSize) ? TargetChunkSize : MinChunkSize;
+        ChunkSize = ((ChunkSize + LineElements - 1) / LineElements) * LineElements;
+
+        Partition Result;
+        Result.Size      = Size;
+        Result.HeadSize  = HeadSize;
+        Result.ChunkSize = ChunkSize;
+        Result.NumChunks = (Size > HeadSize + ChunkSize) ? 1 + (Size - HeadSize - 1) / ChunkSize : 1;
+        return Result;
+    }
+
+    static JobSystem* GetJobSystem(JobSystem* Jobs) noexcept
+    {
+        return Jobs ? Jobs : JobSystem::GetCurrent();
+    }
+
+    // Calls ChunkFunction once for every chunk, on as many threads as there are chunks
+    template<typename TChunkFunction>
+    static void Run(JobSystem* Jobs, UInt64 NumChunks, TChunkFunction& ChunkFunction) noexcept
+    {
+        // The deques of a JobSystem are owned by its threads, other threads would race with them when pushing
+        if (!Jobs || (JobSystem::GetCurrent() != Jobs) || (NumChunks < 2) || (Jobs->GetNumThreads() < 2))
+        {
+            for (UInt64 Chunk = 0; Chunk < NumChunks; Chunk++)
+            {
+                ChunkFunction(Chunk);
+            }
+
+            return;
+        }
+
+        std::atomic<UInt64> NextChunk(0);
+        auto Worker = [&NextChunk, &ChunkFunction, NumChunks]()
+        {
+            UInt64 Chunk = NextChunk.fetch_add(1, std::memory_order_relaxed);
+            while (Chunk < NumChunks)
+            {
+                ChunkFunction(Chunk);
+                Chunk = NextChunk.fetch_add(1, std::memory_order_relaxed);
+            }
+        };
+
+        const UInt64 NumThreads = (UInt64(Jobs->GetNumThreads()) < NumChunks) ? UInt64(Jobs->GetNumThreads()) : NumChunks;
+
+        JobCounter Counter;
+        for (UInt64 Index = 1; Index < NumThreads; Index++)
+        {
+            Jobs->Run(Worker, &Counter);
+        }
+
+        Worker();
+        Jobs->Wait(Counter);
+    }
+};
+
+// ParallelFor - Calls Body(Element) for every element
+template<typename T, typename TSizeType, typename TBody>
+inline void ParallelFor(TArrayView<T, TSizeType> View, TBody Body, JobSystem* Jobs = nullptr) noexcept
+{
+    Jobs = _ParallelImpl::GetJobSystem(Jobs);
+
+    T* Data = View.Data();
+    const _ParallelImpl::Partition Partition = _ParallelImpl::MakePartition(Data, UInt64(View.Size()), Jobs ? Jobs->GetNumThreads() : 1);
+
+    auto ChunkFunction = [Data, &Partition, &Body](UInt64 Chunk)
+    {
+        const UInt64 End = Partition.GetEnd(Chunk);
+        for (UInt64 Index = Partition.GetBegin(Chunk); Index < End; Index++)
+        {
+            Body(Data[Index]);
+        }
+    };
+
+    _ParallelImpl::Run(Jobs, Partition.NumChunks, ChunkFunction);
+}
+
+/*
+ * ParallelReduce - Accumulates every chunk with Accumulate(Result, Element), starting at Identity, and combines the
+ * results of the chunks in order with Combine(Lhs, Rhs). The chunks depend on the size and the number of threads, so
+ * floating point results can differ between thread counts.
+ */
+
+template<typename T, typename TSizeType, typename TResult, typename TAccumulate, typename TCombine>
+inline TResult ParallelReduce(TArrayView<T, TSizeType> View, TResult Identity, TAccumulate Accumulate, TCombine Combine, JobSystem* Jobs = nullptr) noexcept
+{
+    Jobs = _ParallelImpl::GetJobSystem(Jobs);
+
+    const T* Data = View.Data();
+    const _ParallelImpl::Partition Partition = _ParallelImpl::MakePartition(Data, UInt64(View.Size()), Jobs ? Jobs->GetNumThreads() : 1);
+
+    TArray<TResult> Results(static_cast<UInt32>(Partition.NumChunks), Identity);
+    auto ChunkFunction = [Data, &Partition, &Accumulate, &Results](UInt64 Chunk)
+    {
+        TResult Result = Results[UInt32(Chunk)];
+
+        const UInt64 End = Partition.GetEnd(Chunk);
+        for (UInt64 Index = Partition.GetBegin(Chunk); Index < End; Index++)
+        {
+            Result = Accumulate(Result, Data[Index]);
+        }
+
+        Results[UInt32(Chunk)] = ::Move(Result);
+    };
+
+    _ParallelImpl::Run(Jobs, Partition.NumChunks, ChunkFunction);
+
+    TResult Result = ::Move(Results[0]);
+    for (UInt64 Chunk = 1; Chunk < Partition.NumChunks; Chunk++)
+    {
+        Result = Combine(Result, Results[UInt32(Chunk)]);
+    }
+
+    return Result;
+}
+
+// ParallelTransform - Writes Transform(Input[i]) to Output[i], the views must have the same size and may be the same view
+template<typename TInput, typename TInputSizeType, typename TOutput, typename TOutputSizeType, typename TTransform>
+inline void ParallelTransform(TArrayView<TInput, TInputSizeType> Input, TArrayView<TOutput, TOutputSizeType> Output, TTransform Transform, JobSystem* Jobs = nullptr) noexcept
+{
+    VALIDATE(UInt64(Input.Size()) == UInt64(Output.Size()));
+    Jobs = _ParallelImpl::GetJobSystem(Jobs);
+
+    // The chunks start on the cache lines of the output, which is what the threads write
+    const TInput* InputData  = Input.Data();
+    TOutput*      OutputData = Output.Data();
+    const _ParallelImpl::Partition Partition = _ParallelImpl::MakePartition(OutputData, UInt64(Output.Size()), Jobs ? Jobs->GetNumThreads() : 1);
+
+    auto ChunkFunction = [InputData, OutputData, &Partition, &Transform](UInt64 Chunk)
+    {
+        const UInt64 End = Partition.GetEnd(Chunk);
+        for (UInt64 Index = Partition.GetBegin(Chunk); Index < End; Index++)
+        {
+            OutputData[Index] = Transform(InputData[Index]);
+        }
+    };
+
+    _ParallelImpl::Run(Jobs, Partition.NumChunks, ChunkFunction);
+}
+
+/*
+ * TArray overloads
+ */
+
+template<typename T, typename TAllocator, typename TGrowthPolicy, typename... TArgs>
+inline void ParallelFor(TArray<T, TAllocator, TGrowthPolicy>& Array, TArgs&&... Args) noexcept
+{
+    ParallelFor(TArrayView<T, typename TArray<T, TAllocator, TGrowthPolicy>::SizeType>(Array), ::Forward<TArgs>(Args)...);
+}
+
+template<typename T, typename TAllocator, typename TGrowthPolicy, typename... TArgs>
+inline auto ParallelReduce(const TArray<T, TAllocator, TGrowthPolicy>& Array, TArgs&&... Args) noexcept
+{
+    return ParallelReduce(TArrayView<const T, typename TArray<T, TAllocator, TGrowthPolicy>::SizeType>(Array), ::Forward<TArgs>(Args)...);
+}
+
+template<typename TInput, typename TInputAllocator, typename TInputGrowthPolicy, typename TOutput, typename TOutputAllocator, typename TOutputGrowthPolicy, typename... TArgs>
+inline void ParallelTransform(const TArray<TInput, TInputAllocator, TInputGrowthPolicy>& Input, TArray<TOutput, TOutputAllocator, TOutputGrowthPolicy>& Output, TArgs&&... Args) noexcept
+{
+    ParallelTransform(
+        TArrayView<const TInput, typename TArray<TInput, TInputAllocator, TInputGrowthPolicy>::SizeType>(Input),
+        TArrayView<TOutput, typename TArray<TOutput, TOutputAllocator, TOutputGrowthPolicy>::SizeType>(Output),
+        ::Forward<TArgs>(Args)...);
+}
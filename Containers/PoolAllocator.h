@@ -0,0 +1,288 @@
+#pragma once
+#include "Utilities.h"
+#include "Allocator.h"
+
+#include <atomic>
+#include <mutex>
+
+/*
+ * SizeClassPool - Process-wide pool for small fixed-size blocks. Sizes are rounded up to a multiple of
+ * BlockAlignment, and each size class carves its blocks from slabs and keeps the freed blocks in a free-list.
+ * Slabs are never returned to the backing allocator, the blocks are reused by later allocations of the same class.
+ */
+
+class SizeClassPool
+{
+public:
+    static constexpr UInt64 BlockAlignment = 16;
+    static constexpr UInt64 MaxBlockSize   = 256;
+    static constexpr UInt32 NumSizeClasses = UInt32(MaxBlockSize / BlockAlignment);
+    static constexpr UInt64 SlabSize       = 64 * 1024;
+
+    struct FreeBlock
+    {
+        FreeBlock* Next;
+    };
+
+    static SizeClassPool& Get() noexcept
+    {
+        // Never destroyed, blocks may still be released by static objects during shutdown
+        static SizeClassPool* Pool = new SizeClassPool();
+        return *Pool;
+    }
+
+    static constexpr UInt32 GetSizeClass(UInt64 Size) noexcept
+    {
+        return (Size > 0) ? UInt32((Size - 1) / BlockAlignment) : 0;
+    }
+
+    static constexpr UInt64 GetBlockSize(UInt32 SizeClass) noexcept
+    {
+        return (UInt64(SizeClass) + 1) * BlockAlignment;
+    }
+
+    // Returns a list of up to Count blocks and the number of blocks in it
+    UInt32 AllocateBatch(UInt32 SizeClass, FreeBlock*& OutList, UInt32 Count) noexcept
+    {
+        VALIDATE(SizeClass < NumSizeClasses);
+
+        SizeClassData& Data = mSizeClasses[SizeClass];
+        std::lock_guard<std::mutex> Lock(Data.Mutex);
+
+        FreeBlock* List     = nullptr;
+        UInt32     NumAdded = 0;
+        while (NumAdded < Count && Data.FreeList)
+        {
+            FreeBlock* Block = Data.FreeList;
+            Data.FreeList = Block->Next;
+            Block->Next   = List;
+            List = Block;
+            NumAdded++;
+        }
+
+        const UInt64 BlockSize = GetBlockSize(SizeClass);
+        while (NumAdded < Count)
+        {
+            if (UInt64(Data.SlabEnd - Data.SlabCursor) < BlockSize)
+            {
+                Byte* Slab = reinterpret_cast<Byte*>(mBackingAllocator.Allocate(SlabSize, BlockAlignment));
+                if (!Slab)
+                {
+                    break;
+                }
+
+                Data.SlabCursor = Slab;
+                Data.SlabEnd    = Slab + SlabSize;
+                mReservedBytes.fetch_add(SlabSize, std::memory_order_relaxed);
+            }
+
+            FreeBlock* Block = reinterpret_cast<FreeBlock*>(Data.SlabCursor);
+            Data.SlabCursor += BlockSize;
+            Block->Next = List;
+            List = Block;
+            NumAdded++;
+        }
+
+        OutList = List;
+        return NumAdded;
+    }
+
+    // Returns a list of blocks, Last->Next is overwritten
+    void FreeBatch(UInt32 SizeClass, FreeBlock* First, FreeBlock* Last) noexcept
+    {
+        VALIDATE(SizeClass < NumSizeClasses);
+
+        SizeClassData& Data = mSizeClasses[SizeClass];
+        std::lock_guard<std::mutex> Lock(Data.Mutex);
+
+        Last->Next    = Data.FreeList;
+        Data.FreeList = First;
+    }
+
+    // Number of bytes that the pool has requested from the backing allocator
+    UInt64 GetReservedBytes() const noexcept
+    {
+        return mReservedBytes.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct SizeClassData
+    {
+        std::mutex Mutex;
+        FreeBlock* FreeList   = nullptr;
+        Byte*      SlabCursor = nullptr;
+        Byte*      SlabEnd    = nullptr;
+    };
+
+    SizeClassPool() noexcept
+        : mSizeClasses()
+        , mReservedBytes(0)
+        , mBackingAllocator()
+    {
+    }
+
+    SizeClassData       mSizeClasses[NumSizeClasses];
+    std::atomic<UInt64> mReservedBytes;
+    Mallocator          mBackingAllocator;
+};
+
+/*
+ * PoolThreadCache - Per-thread free-lists in front of the SizeClassPool, so that most allocations do not need to
+ * take a lock. Blocks are fetched from and returned to the pool in batches, and all cached blocks are returned when
+ * the thread exits.
+ */
+
+class PoolThreadCache
+{
+    typedef SizeClassPool::FreeBlock FreeBlock;
+
+public:
+    static constexpr UInt32 BatchSize = 32;
+
+    // Returns nullptr once the cache of the calling thread has been destroyed
+    static PoolThreadCache* Get() noexcept
+    {
+        if (IsDestroyed())
+        {
+            return nullptr;
+        }
+
+        static thread_local PoolThreadCache Cache;
+        return &Cache;
+    }
+
+    PoolThreadCache(const PoolThreadCache&) = delete;
+    PoolThreadCache& operator=(const PoolThreadCache&) = delete;
+
+    ~PoolThreadCache()
+    {
+        for (UInt32 SizeClass = 0; SizeClass < SizeClassPool::NumSizeClasses; SizeClass++)
+        {
+            InternalRelease(SizeClass, mNumBlocks[SizeClass]);
+        }
+
+        IsDestroyed() = true;
+    }
+
+    void* Allocate(UInt32 SizeClass) noexcept
+    {
+        if (!mFreeLists[SizeClass])
+        {
+            mNumBlocks[SizeClass] = SizeClassPool::Get().AllocateBatch(SizeClass, mFreeLists[SizeClass], BatchSize);
+            if (!mFreeLists[SizeClass])
+            {
+                return nullptr;
+            }
+        }
+
+        FreeBlock* Block = mFreeLists[SizeClass];
+        mFreeLists[SizeClass] = Block->Next;
+        mNumBlocks[SizeClass]--;
+        return reinterpret_cast<void*>(Block);
+    }
+
+    void Free(void* Ptr, UInt32 SizeClass) noexcept
+    {
+        FreeBlock* Block = reinterpret_cast<FreeBlock*>(Ptr);
+        Block->Next = mFreeLists[SizeClass];
+        mFreeLists[SizeClass] = Block;
+
+        // Keep one batch around so that alternating allocations and frees do not go to the pool every time
+        if (++mNumBlocks[SizeClass] >= (BatchSize * 2))
+        {
+            InternalRelease(SizeClass, BatchSize);
+        }
+    }
+
+private:
+    PoolThreadCache() noexcept
+        : mFreeLists()
+        , mNumBlocks()
+    {
+    }
+
+    static Bool& IsDestroyed() noexcept
+    {
+        static thread_local Bool Destroyed = false;
+        return Destroyed;
+    }
+
+    void InternalRelease(UInt32 SizeClass, UInt32 Count) noexcept
+    {
+        if (Count == 0 || !mFreeLists[SizeClass])
+        {
+            return;
+        }
+
+        FreeBlock* First = mFreeLists[SizeClass];
+        FreeBlock* Last  = First;
+        for (UInt32 Index = 1; Index < Count && Last->Next; Index++)
+        {
+            Last = Last->Next;
+        }
+
+        mFreeLists[SizeClass] = Last->Next;
+        mNumBlocks[SizeClass] -= Count;
+        SizeClassPool::Get().FreeBatch(SizeClass, First, Last);
+    }
+
+    FreeBlock* mFreeLists[SizeClassPool::NumSizeClasses];
+    UInt32     mNumBlocks[SizeClassPool::NumSizeClasses];
+};
+
+/*
+ * PoolAllocator - Allocates small blocks from the SizeClassPool through the per-thread cache, blocks that are too
+ * large or too aligned for the pool are forwarded to Mallocator. Free must be called with the same size and alignment
+ * as Allocate, which is why it is meant for objects that know their own size, such as control blocks and functors,
+ * and not as a container allocator.
+ */
+
+struct PoolAllocator
+{
+    static constexpr Bool CanUsePool(UInt64 Size, UInt64 Alignment) noexcept
+    {
+        return (Size <= SizeClassPool::MaxBlockSize) && (Alignment <= SizeClassPool::BlockAlignment);
+    }
+
+    void* Allocate(UInt64 Size, UInt64 Alignment) noexcept
+    {
+        if (!CanUsePool(Size, Alignment))
+        {
+            return Mallocator().Allocate(Size, Alignment);
+        }
+
+        const UInt32 SizeClass = SizeClassPool::GetSizeClass(Size);
+        if (PoolThreadCache* Cache = PoolThreadCache::Get())
+        {
+            return Cache->Allocate(SizeClass);
+        }
+
+        SizeClassPool::FreeBlock* Block = nullptr;
+        SizeClassPool::Get().AllocateBatch(SizeClass, Block, 1);
+        return reinterpret_cast<void*>(Block);
+    }
+
+    void Free(void* Ptr, UInt64 Size, UInt64 Alignment) noexcept
+    {
+        if (!Ptr)
+        {
+            return;
+        }
+
+        if (!CanUsePool(Size, Alignment))
+        {
+            Mallocator().Free(Ptr, Alignment);
+            return;
+        }
+
+        const UInt32 SizeClass = SizeClassPool::GetSizeClass(Size);
+        if (PoolThreadCache* Cache = PoolThreadCache::Get())
+        {
+            Cache->Free(Ptr, SizeClass);
+            return;
+        }
+
+        SizeClassPool::FreeBlock* Block = reinterpret_cast<SizeClassPool::FreeBlock*>(Ptr);
+        SizeClassPool::Get().FreeBatch(SizeClass, Block, Block);
+    }
+};
@@ -0,0 +1,192 @@
+#pragma once
+#include "Utilities.h"
+#include "ArrayView.h"
+#include "StaticArray.h"
+
+#include <atomic>
+
+/*
+ * TSPSCQueue - Lock-free ring buffer between one producer thread and one consumer thread. Each side owns its index and
+ * keeps a cached copy of the other side's index, which it only reloads when the queue looks full or empty, so in the
+ * steady state the threads do not read each other's cache lines. The batch functions move many elements per atomic
+ * store. The elements live in a TStaticArray, so T must be default constructible, and the queue is best allocated on
+ * the heap for large capacities.
+ */
+
+template<typename T, UInt32 Capacity>
+class TSPSCQueue
+{
+    static_assert((Capacity > 0) && ((Capacity & (Capacity - 1)) == 0), "Capacity must be a power of two");
+    static_assert(Capacity <= UInt32(std::numeric_limits<Int32>::max()), "Capacity must fit into a TStaticArray");
+
+    static constexpr UInt64 Mask = UInt64(Capacity) - 1;
+
+public:
+    TSPSCQueue() noexcept
+        : mTail(0)
+        , mCachedHead(0)
+        , mHead(0)
+        , mCachedTail(0)
+        , mElements()
+    {
+    }
+
+    TSPSCQueue(const TSPSCQueue&) = delete;
+    TSPSCQueue& operator=(const TSPSCQueue&) = delete;
+
+    // Producer only, returns false when the queue is full
+    Bool Push(const T& Element) noexcept
+    {
+        const UInt64 Tail = mTail.load(std::memory_order_relaxed);
+        if (!InternalHasSpace(Tail, 1))
+        {
+            return false;
+        }
+
+        mElements[UInt32(Tail & Mask)] = Element;
+        mTail.store(Tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    Bool Push(T&& Element) noexcept
+    {
+        const UInt64 Tail = mTail.load(std::memory_order_relaxed);
+        if (!InternalHasSpace(Tail, 1))
+        {
+            return false;
+        }
+
+        mElements[UInt32(Tail & Mask)] = ::Move(Element);
+        mTail.store(Tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer only, pushes as many elements as fit and returns how many were pushed
+    template<typename TSizeType>
+    UInt32 PushBatch(TArrayView<const T, TSizeType> Elements) noexcept
+    {
+        const UInt64 Tail  = mTail.load(std::memory_order_relaxed);
+        const UInt32 Count = InternalFreeSpace(Tail, UInt64(Elements.Size()));
+        for (UInt32 Index = 0; Index < Count; Index++)
+        {
+            mElements[UInt32((Tail + Index) & Mask)] = Elements[TSizeType(Index)];
+        }
+
+        if (Count > 0)
+        {
+            mTail.store(Tail + Count, std::memory_order_release);
+        }
+
+        return Count;
+    }
+
+    template<typename TSizeType>
+    UInt32 PushBatch(TArrayView<T, TSizeType> Elements) noexcept
+    {
+        return PushBatch(TArrayView<const T, TSizeType>(Elements.Data(), Elements.Data() + Elements.Size()));
+    }
+
+    // Consumer only, returns false when the queue is empty
+    Bool Pop(T& OutElement) noexcept
+    {
+        const UInt64 Head = mHead.load(std::memory_order_relaxed);
+        if (!InternalHasElements(Head, 1))
+        {
+            return false;
+        }
+
+        OutElement = ::Move(mElements[UInt32(Head & Mask)]);
+        mHead.store(Head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only, pops up to OutElements.Size() elements and returns how many were popped
+    template<typename TSizeType>
+    UInt32 PopBatch(TArrayView<T, TSizeType> OutElements) noexcept
+    {
+        const UInt64 Head  = mHead.load(std::memory_order_relaxed);
+        const UInt32 Count = InternalAvailable(Head, UInt64(OutElements.Size()));
+        for (UInt32 Index = 0; Index < Count; Index++)
+        {
+            OutElements[TSizeType(Index)] = ::Move(mElements[UInt32((Head + Index) & Mask)]);
+        }
+
+        if (Count > 0)
+        {
+            mHead.store(Head + Count, std::memory_order_release);
+        }
+
+        return Count;
+    }
+
+    // Only a snapshot when the other thread uses the queue
+    UInt32 Size() const noexcept
+    {
+        const UInt64 Head = mHead.load(std::memory_order_acquire);
+        const UInt64 Tail = mTail.load(std::memory_order_acquire);
+        return (Tail > Head) ? UInt32(Tail - Head) : 0;
+    }
+
+    Bool IsEmpty() const noexcept
+    {
+        return (Size() == 0);
+    }
+
+    static constexpr UInt32 GetCapacity() noexcept
+    {
+        return Capacity;
+    }
+
+private:
+    Bool InternalHasSpace(UInt64 Tail, UInt64 Count) noexcept
+    {
+        if (Tail - mCachedHead + Count <= Capacity)
+        {
+            return true;
+        }
+
+        mCachedHead = mHead.load(std::memory_order_acquire);
+        return (Tail - mCachedHead + Count <= Capacity);
+    }
+
+    UInt32 InternalFreeSpace(UInt64 Tail, UInt64 Count) noexcept
+    {
+        if (!InternalHasSpace(Tail, Count))
+        {
+            Count = Capacity - (Tail - mCachedHead);
+        }
+
+        return UInt32(Count);
+    }
+
+    Bool InternalHasElements(UInt64 Head, UInt64 Count) noexcept
+    {
+        if (mCachedTail - Head >= Count)
+        {
+            return true;
+        }
+
+        mCachedTail = mTail.load(std::memory_order_acquire);
+        return (mCachedTail - Head >= Count);
+    }
+
+    UInt32 InternalAvailable(UInt64 Head, UInt64 Count) noexcept
+    {
+        if (!InternalHasElements(Head, Count))
+        {
+            Count = mCachedTail - Head;
+        }
+
+        return UInt32(Count);
+    }
+
+    // Written by the producer
+    alignas(64) std::atomic<UInt64> mTail;
+    UInt64                          mCachedHead;
+
+    // Written by the consumer
+    alignas(64) std::atomic<UInt64> mHead;
+    UInt64                          mCachedTail;
+
+    alignas(64) TStaticArray<T, Int32(Capacity)> mElements;
+};
@@ -1,33 +1,183 @@
 #pragma once
 #include "UniquePtr.h"
+#include "PoolAllocator.h"
+#include "TrackingAllocator.h"
 
-// PtrControlBlock - Counting references in TWeak- and TSharedPtr
+#include <atomic>
+#include <new>
 
-struct PtrControlBlock
+// ControlBlockAllocator - Allocator for all control blocks, tracked under ControlBlockMemory when memory tracking is enabled
+
+#if ENABLE_MEMORY_TRACKING
+DECLARE_MEMORY_TAG(ControlBlockMemory);
+typedef TTrackingAllocator<PoolAllocator, ControlBlockMemory> ControlBlockAllocator;
+#else
+typedef PoolAllocator ControlBlockAllocator;
+#endif
+
+// RefCounter - Counts references without synchronization, for pointers that are only used on a single thread
+
+struct RefCounter
 {
 public:
     typedef UInt32 RefType;
 
-     PtrControlBlock() noexcept
-        : mWeakRefs(0)
+    RefCounter(RefType InCount) noexcept
+        : mCount(InCount)
+    {
+    }
+
+    // All functions that modify the count returns the previous value
+    RefType Increment() noexcept { return mCount++; }
+    RefType Decrement() noexcept { return mCount--; }
+
+    RefType IncrementIfNotZero() noexcept
+    {
+        return (mCount > 0) ? mCount++ : 0;
+    }
+
+    RefType Load() const noexcept { return mCount; }
+
+private:
+    RefType mCount;
+};
+
+// ThreadSafeRefCounter - Counts references atomically, for pointers that are copied and released on multiple threads
+
+struct ThreadSafeRefCounter
+{
+public:
+    typedef UInt32 RefType;
+
+    ThreadSafeRefCounter(RefType InCount) noexcept
+        : mCount(InCount)
+    {
+    }
+
+    // Taking a new reference does not need to synchronize, since the caller already owns a reference
+    RefType Increment() noexcept { return mCount.fetch_add(1, std::memory_order_relaxed); }
+
+    // Releasing must be visible before the object is destroyed, the last owner acquires all the previous releases
+    RefType Decrement() noexcept
+    {
+        const RefType OldCount = mCount.fetch_sub(1, std::memory_order_release);
+        if (OldCount == 1)
+        {
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+
+        return OldCount;
+    }
+
+    RefType IncrementIfNotZero() noexcept
+    {
+        RefType OldCount = mCount.load(std::memory_order_relaxed);
+        while (OldCount > 0)
+        {
+            if (mCount.compare_exchange_weak(OldCount, OldCount + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+
+        return OldCount;
+    }
+
+    RefType Load() const noexcept { return mCount.load(std::memory_order_acquire); }
+
+private:
+    std::atomic<RefType> mCount;
+};
+
+// TPtrControlBlock - Counting references in TWeak- and TSharedPtr, and owns the lifetime of the object
+
+template<typename TRefCounter>
+struct TPtrControlBlock
+{
+public:
+    typedef typename TRefCounter::RefType RefType;
+
+    // All strong references share one weak reference, this keeps the block alive until the last strong reference is released
+    TPtrControlBlock() noexcept
+        : mWeakRefs(1)
         , mStrongRefs(0)
     {
     }
 
-    RefType AddWeakRef() noexcept { return mWeakRefs++; }
-    RefType AddStrongRef() noexcept { return mStrongRefs++; }
+    virtual ~TPtrControlBlock() = default;
 
-    RefType ReleaseWeakRef() noexcept { return mWeakRefs--; }
-    RefType ReleaseStrongRef() noexcept { return mStrongRefs--; }
+    // Control blocks are small and allocated for every shared object, so they come from the pool. The blocks are
+    // deleted through the virtual destructor, which passes the size of the actual block to operator delete.
+    static void* operator new(size_t Size)
+    {
+        return InternalAllocate(Size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+    }
 
-    RefType GetWeakReferences() const noexcept { return mWeakRefs; }
-    RefType GetStrongReferences() const noexcept { return mStrongRefs; }
+    static void* operator new(size_t Size, std::align_val_t Alignment)
+    {
+        return InternalAllocate(Size, static_cast<UInt64>(Alignment));
+    }
+
+    static void operator delete(void* Ptr, size_t Size) noexcept
+    {
+        ControlBlockAllocator().Free(Ptr, Size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+    }
+
+    static void operator delete(void* Ptr, size_t Size, std::align_val_t Alignment) noexcept
+    {
+        ControlBlockAllocator().Free(Ptr, Size, static_cast<UInt64>(Alignment));
+    }
+
+    // Placement new for blocks that manage their own memory
+    static void* operator new(size_t Size, void* Memory) noexcept
+    {
+        UNREFERENCED_VARIABLE(Size);
+        return Memory;
+    }
+
+    // Called when the last strong reference is released
+    virtual void DestroyObject() noexcept = 0;
+
+    // Called when the last weak reference is released, the object is already destroyed at this point
+    virtual void DestroyBlock() noexcept = 0;
+
+    RefType AddWeakRef() noexcept { return mWeakRefs.Increment(); }
+    RefType AddStrongRef() noexcept { return mStrongRefs.Increment(); }
+
+    // Fails and returns zero when the object already has been destroyed
+    RefType TryAddStrongRef() noexcept { return mStrongRefs.IncrementIfNotZero(); }
+
+    RefType ReleaseWeakRef() noexcept { return mWeakRefs.Decrement(); }
+    RefType ReleaseStrongRef() noexcept { return mStrongRefs.Decrement(); }
+
+    RefType GetWeakReferences() const noexcept
+    {
+        const RefType StrongRefs = mStrongRefs.Load();
+        const RefType WeakRefs   = mWeakRefs.Load();
+        return (StrongRefs > 0 && WeakRefs > 0) ? (WeakRefs - 1) : WeakRefs;
+    }
+
+    RefType GetStrongReferences() const noexcept { return mStrongRefs.Load(); }
+
+protected:
+    static void* InternalAllocate(UInt64 Size, UInt64 Alignment)
+    {
+        void* Memory = ControlBlockAllocator().Allocate(Size, Alignment);
+        if (!Memory)
+        {
+            throw std::bad_alloc();
+        }
+
+        return Memory;
+    }
 
 private:
-    RefType mWeakRefs;
-    RefType mStrongRefs;
+    TRefCounter mWeakRefs;
+    TRefCounter mStrongRefs;
 };
 
+typedef TPtrControlBlock<RefCounter> PtrControlBlock;
+
 // TDelete
 
 template<typename T>
@@ -52,24 +202,156 @@ struct TDelete<T[]>
     }
 };
 
+// TDeleterPtrControlBlock - Control block for objects that are allocated separately and destroyed with a deleter
+
+template<typename T, typename D, typename TRefCounter>
+class TDeleterPtrControlBlock : public TPtrControlBlock<TRefCounter>
+{
+public:
+    TDeleterPtrControlBlock(T* InPtr) noexcept
+        : TPtrControlBlock<TRefCounter>()
+        , mPtr(InPtr)
+        , mDeleter()
+    {
+    }
+
+    virtual void DestroyObject() noexcept override final
+    {
+        mDeleter(mPtr);
+        mPtr = nullptr;
+    }
+
+    virtual void DestroyBlock() noexcept override final
+    {
+        delete this;
+    }
+
+private:
+    T* mPtr;
+    D  mDeleter;
+};
+
+// TInlinePtrControlBlock - Control block that stores the object, so that both are created with a single allocation.
+// The storage stays allocated until the last weak reference is released.
+
+template<typename T, typename TRefCounter>
+class TInlinePtrControlBlock : public TPtrControlBlock<TRefCounter>
+{
+public:
+    template<typename... TArgs>
+    TInlinePtrControlBlock(TArgs&&... Args) noexcept
+        : TPtrControlBlock<TRefCounter>()
+    {
+        ::new(static_cast<void*>(mStorage)) T(::Forward<TArgs>(Args)...);
+    }
+
+    T* GetObject() noexcept { return reinterpret_cast<T*>(mStorage); }
+
+    virtual void DestroyObject() noexcept override final
+    {
+        GetObject()->~T();
+    }
+
+    virtual void DestroyBlock() noexcept override final
+    {
+        delete this;
+    }
+
+private:
+    alignas(T) Byte mStorage[sizeof(T)];
+};
+
+// TInlineArrayPtrControlBlock - Control block that stores the elements of an array directly after itself
+
+template<typename T, typename TRefCounter>
+class TInlineArrayPtrControlBlock : public TPtrControlBlock<TRefCounter>
+{
+public:
+    static TInlineArrayPtrControlBlock* Create(UInt32 NumElements)
+    {
+        void* Memory = TPtrControlBlock<TRefCounter>::InternalAllocate(GetBlockSize(NumElements), GetBlockAlignment());
+        TInlineArrayPtrControlBlock* Block = new(Memory) TInlineArrayPtrControlBlock(NumElements);
+
+        T* Elements = Block->GetElements();
+        for (UInt32 i = 0; i < NumElements; i++)
+        {
+            ::new(static_cast<void*>(Elements + i)) T;
+        }
+
+        return Block;
+    }
+
+    T* GetElements() noexcept
+    {
+        return reinterpret_cast<T*>(reinterpret_cast<Byte*>(this) + GetElementsOffset());
+    }
+
+    virtual void DestroyObject() noexcept override final
+    {
+        if constexpr (std::is_trivially_destructible<T>() == false)
+        {
+            T* Elements = GetElements();
+            for (UInt32 i = mNumElements; i > 0; i--)
+            {
+                Elements[i - 1].~T();
+            }
+        }
+    }
+
+    virtual void DestroyBlock() noexcept override final
+    {
+        const UInt64 BlockSize = GetBlockSize(mNumElements);
+        this->~TInlineArrayPtrControlBlock();
+
+        ControlBlockAllocator().Free(reinterpret_cast<void*>(this), BlockSize, GetBlockAlignment());
+    }
+
+private:
+    TInlineArrayPtrControlBlock(UInt32 InNumElements) noexcept
+        : TPtrControlBlock<TRefCounter>()
+        , mNumElements(InNumElements)
+    {
+    }
+
+    static constexpr UInt64 GetBlockAlignment() noexcept
+    {
+        return alignof(T) > alignof(TInlineArrayPtrControlBlock) ? alignof(T) : alignof(TInlineArrayPtrControlBlock);
+    }
+
+    static constexpr UInt64 GetElementsOffset() noexcept
+    {
+        return (sizeof(TInlineArrayPtrControlBlock) + alignof(T) - 1) & ~(UInt64(alignof(T)) - 1);
+    }
+
+    static constexpr UInt64 GetBlockSize(UInt32 NumElements) noexcept
+    {
+        return GetElementsOffset() + (UInt64(NumElements) * sizeof(T));
+    }
+
+    UInt32 mNumElements;
+};
+
 // TPtrBase - Base class for TWeak- and TSharedPtr
 
-template<typename T, typename D>
+template<typename T, typename D, typename TRefCounter>
 class TPtrBase
 {
 public:
-    template<typename TOther, typename DOther>
+    typedef TPtrControlBlock<TRefCounter>     ControlBlockType;
+    typedef typename ControlBlockType::RefType RefType;
+
+    template<typename TOther, typename DOther, typename TOtherRefCounter>
     friend class TPtrBase;
 
     T* Get() const noexcept { return mPtr; }
     T* const* GetAddressOf() const noexcept { return &mPtr; }
 
-    PtrControlBlock::RefType GetStrongReferences() const noexcept
+    RefType GetStrongReferences() const noexcept
     {
         return mCounter ? mCounter->GetStrongReferences() : 0;
     }
 
-    PtrControlBlock::RefType GetWeakReferences() const noexcept
+    RefType GetWeakReferences() const noexcept
     {
         return mCounter ? mCounter->GetWeakReferences() : 0;
     }
@@ -116,17 +398,13 @@ protected:
         if (mPtr)
         {
             VALIDATE(mCounter != nullptr);
-            mCounter->ReleaseStrongRef();
 
-            // When releasing the last strong reference we can destroy the pointer and counter
-            if (mCounter->GetStrongReferences() <= 0)
+            // Only the owner of the last strong reference destroys the object, and then releases the weak reference
+            // that the strong references shared
+            if (mCounter->ReleaseStrongRef() == 1)
             {
-                if (mCounter->GetWeakReferences() <= 0)
-                {
-                    delete mCounter;
-                }
-                
-                mDeleter(mPtr);
+                mCounter->DestroyObject();
+                InternalReleaseControlBlock();
                 InternalClear();
             }
         }
@@ -138,21 +416,22 @@ protected:
         if (mPtr)
         {
             VALIDATE(mCounter != nullptr);
-            mCounter->ReleaseWeakRef();
-            
-            PtrControlBlock::RefType StrongRefs = mCounter->GetStrongReferences();
-            PtrControlBlock::RefType WeakRefs   = mCounter->GetWeakReferences();
-            if (WeakRefs <= 0 && StrongRefs <= 0)
-            {
-                delete mCounter;
-            }
+            InternalReleaseControlBlock();
+        }
+    }
+
+    void InternalReleaseControlBlock() noexcept
+    {
+        if (mCounter->ReleaseWeakRef() == 1)
+        {
+            mCounter->DestroyBlock();
         }
     }
 
     void InternalSwap(TPtrBase& Other) noexcept
     {
         T* TempPtr = mPtr;
-        PtrControlBlock* TempBlock = mCounter;
+        ControlBlockType* TempBlock = mCounter;
 
         mPtr     = Other.mPtr;
         mCounter = Other.mCounter;
@@ -171,7 +450,7 @@ protected:
     }
 
     template<typename TOther, typename DOther>
-    void InternalMove(TPtrBase<TOther, DOther>&& Other) noexcept
+    void InternalMove(TPtrBase<TOther, DOther, TRefCounter>&& Other) noexcept
     {
         static_assert(std::is_convertible<TOther*, T*>());
 
@@ -185,7 +464,7 @@ protected:
     void InternalConstructStrong(T* Ptr) noexcept
     {
         mPtr     = Ptr;
-        mCounter = new PtrControlBlock();
+        mCounter = Ptr ? new TDeleterPtrControlBlock<T, D, TRefCounter>(Ptr) : nullptr;
         InternalAddStrongRef();
     }
 
@@ -195,7 +474,15 @@ protected:
         static_assert(std::is_convertible<TOther*, T*>());
 
         mPtr     = static_cast<T*>(Ptr);
-        mCounter = new PtrControlBlock();
+        mCounter = Ptr ? new TDeleterPtrControlBlock<TOther, DOther, TRefCounter>(Ptr) : nullptr;
+        InternalAddStrongRef();
+    }
+
+    // The control block already stores the object
+    void InternalConstructStrong(T* Ptr, ControlBlockType* ControlBlock) noexcept
+    {
+        mPtr     = Ptr;
+        mCounter = ControlBlock;
         InternalAddStrongRef();
     }
 
@@ -207,7 +494,7 @@ protected:
     }
 
     template<typename TOther, typename DOther>
-    void InternalConstructStrong(const TPtrBase<TOther, DOther>& Other) noexcept
+    void InternalConstructStrong(const TPtrBase<TOther, DOther, TRefCounter>& Other) noexcept
     {
         static_assert(std::is_convertible<TOther*, T*>());
 
@@ -217,7 +504,7 @@ protected:
     }
     
     template<typename TOther, typename DOther>
-    void InternalConstructStrong(const TPtrBase<TOther, DOther>& Other, T* Ptr) noexcept
+    void InternalConstructStrong(const TPtrBase<TOther, DOther, TRefCounter>& Other, T* Ptr) noexcept
     {
         mPtr     = Ptr;
         mCounter = Other.mCounter;
@@ -225,7 +512,7 @@ protected:
     }
     
     template<typename TOther, typename DOther>
-    void InternalConstructStrong(TPtrBase<TOther, DOther>&& Other, T* Ptr) noexcept
+    void InternalConstructStrong(TPtrBase<TOther, DOther, TRefCounter>&& Other, T* Ptr) noexcept
     {
         mPtr     = Ptr;
         mCounter = Other.mCounter;
@@ -234,11 +521,24 @@ protected:
         Other.mCounter = nullptr;
     }
 
+    // Another thread can release the last strong reference at the same time, in that case this pointer stays empty
+    template<typename TOther, typename DOther>
+    void InternalConstructStrongFromWeak(const TPtrBase<TOther, DOther, TRefCounter>& Other) noexcept
+    {
+        static_assert(std::is_convertible<TOther*, T*>());
+
+        if (Other.mCounter && Other.mCounter->TryAddStrongRef() > 0)
+        {
+            mPtr     = static_cast<T*>(Other.mPtr);
+            mCounter = Other.mCounter;
+        }
+    }
+
+    // The weak reference that a new control block starts with belongs to this pointer
     void InternalConstructWeak(T* Ptr) noexcept
     {
-        mPtr		= Ptr;
-        mCounter	= new PtrControlBlock();
-        InternalAddWeakRef();
+        mPtr     = Ptr;
+        mCounter = Ptr ? new TDeleterPtrControlBlock<T, D, TRefCounter>(Ptr) : nullptr;
     }
 
     template<typename TOther>
@@ -247,8 +547,7 @@ protected:
         static_assert(std::is_convertible<TOther*, T*>());
 
         mPtr     = static_cast<T*>(Ptr);
-        mCounter = new PtrControlBlock();
-        InternalAddWeakRef();
+        mCounter = Ptr ? new TDeleterPtrControlBlock<TOther, D, TRefCounter>(Ptr) : nullptr;
     }
 
     void InternalConstructWeak(const TPtrBase& Other) noexcept
@@ -259,7 +558,7 @@ protected:
     }
 
     template<typename TOther, typename DOther>
-    void InternalConstructWeak(const TPtrBase<TOther, DOther>& Other) noexcept
+    void InternalConstructWeak(const TPtrBase<TOther, DOther, TRefCounter>& Other) noexcept
     {
         static_assert(std::is_convertible<TOther*, T*>());
 
@@ -288,21 +587,20 @@ protected:
 
 protected:
     T* mPtr;
-    PtrControlBlock* mCounter;
-    D mDeleter;
+    ControlBlockType* mCounter;
 };
 
 // Forward Declarations
 
-template<typename TOther>
+template<typename T, typename TRefCounter = RefCounter>
 class TWeakPtr;
 
 // TSharedPtr - RefCounted Scalar Pointer, similar to std::shared_ptr
 
-template<typename T>
-class TSharedPtr : public TPtrBase<T, TDelete<T>>
+template<typename T, typename TRefCounter = RefCounter>
+class TSharedPtr : public TPtrBase<T, TDelete<T>, TRefCounter>
 {
-    using TBase = TPtrBase<T, TDelete<T>>;
+    using TBase = TPtrBase<T, TDelete<T>, TRefCounter>;
 
 public:
     TSharedPtr() noexcept
@@ -321,6 +619,13 @@ public:
         TBase::InternalConstructStrong(Ptr);
     }
 
+    // Takes ownership of a control block that already stores the object, used by MakeShared
+    explicit TSharedPtr(T* Ptr, typename TBase::ControlBlockType* ControlBlock) noexcept
+        : TBase()
+    {
+        TBase::InternalConstructStrong(Ptr, ControlBlock);
+    }
+
     TSharedPtr(const TSharedPtr& Other) noexcept
         : TBase()
     {
@@ -334,7 +639,7 @@ public:
     }
 
     template<typename TOther>
-    TSharedPtr(const TSharedPtr<TOther>& Other) noexcept
+    TSharedPtr(const TSharedPtr<TOther, TRefCounter>& Other) noexcept
         : TBase()
     {
         static_assert(std::is_convertible<TOther*, T*>());
@@ -342,7 +647,7 @@ public:
     }
 
     template<typename TOther>
-    TSharedPtr(TSharedPtr<TOther>&& Other) noexcept
+    TSharedPtr(TSharedPtr<TOther, TRefCounter>&& Other) noexcept
         : TBase()
     {
         static_assert(std::is_convertible<TOther*, T*>());
@@ -350,25 +655,25 @@ public:
     }
     
     template<typename TOther>
-    TSharedPtr(const TSharedPtr<TOther>& Other, T* Ptr) noexcept
+    TSharedPtr(const TSharedPtr<TOther, TRefCounter>& Other, T* Ptr) noexcept
         : TBase()
     {
         TBase::template InternalConstructStrong<TOther>(Other, Ptr);
     }
     
     template<typename TOther>
-    TSharedPtr(TSharedPtr<TOther>&& Other, T* Ptr) noexcept
+    TSharedPtr(TSharedPtr<TOther, TRefCounter>&& Other, T* Ptr) noexcept
         : TBase()
     {
         TBase::template InternalConstructStrong<TOther>(::Move(Other), Ptr);
     }
 
     template<typename TOther>
-    explicit TSharedPtr(const TWeakPtr<TOther>& Other) noexcept
+    explicit TSharedPtr(const TWeakPtr<TOther, TRefCounter>& Other) noexcept
         : TBase()
     {
         static_assert(std::is_convertible<TOther*, T*>());
-        TBase::template InternalConstructStrong<TOther>(Other);
+        TBase::template InternalConstructStrongFromWeak<TOther>(Other);
     }
 
     template<typename TOther>
@@ -411,14 +716,14 @@ public:
     }
 
     template<typename TOther>
-    TSharedPtr& operator=(const TSharedPtr<TOther>& Other) noexcept
+    TSharedPtr& operator=(const TSharedPtr<TOther, TRefCounter>& Other) noexcept
     {
         TSharedPtr(Other).Swap(*this);
         return *this;
     }
 
     template<typename TOther>
-    TSharedPtr& operator=(TSharedPtr<TOther>&& Other) noexcept
+    TSharedPtr& operator=(TSharedPtr<TOther, TRefCounter>&& Other) noexcept
     {
         TSharedPtr(::Move(Other)).Swap(*this);
         return *this;
@@ -447,10 +752,10 @@ public:
 
 // TSharedPtr - RefCounted Pointer for array types, similar to std::shared_ptr
 
-template<typename T>
-class TSharedPtr<T[]> : public TPtrBase<T, TDelete<T[]>>
+template<typename T, typename TRefCounter>
+class TSharedPtr<T[], TRefCounter> : public TPtrBase<T, TDelete<T[]>, TRefCounter>
 {
-    using TBase = TPtrBase<T, TDelete<T[]>>;
+    using TBase = TPtrBase<T, TDelete<T[]>, TRefCounter>;
 
 public:
     TSharedPtr() noexcept
@@ -469,6 +774,13 @@ public:
         TBase::InternalConstructStrong(Ptr);
     }
 
+    // Takes ownership of a control block that already stores the object, used by MakeShared
+    explicit TSharedPtr(T* Ptr, typename TBase::ControlBlockType* ControlBlock) noexcept
+        : TBase()
+    {
+        TBase::InternalConstructStrong(Ptr, ControlBlock);
+    }
+
     TSharedPtr(const TSharedPtr& Other) noexcept
         : TBase()
     {
@@ -482,7 +794,7 @@ public:
     }
 
     template<typename TOther>
-    TSharedPtr(const TSharedPtr<TOther[]>& Other) noexcept
+    TSharedPtr(const TSharedPtr<TOther[], TRefCounter>& Other) noexcept
         : TBase()
     {
         static_assert(std::is_convertible<TOther*, T*>());
@@ -490,21 +802,21 @@ public:
     }
     
     template<typename TOther>
-    TSharedPtr(const TSharedPtr<TOther[]>& Other, T* Ptr) noexcept
+    TSharedPtr(const TSharedPtr<TOther[], TRefCounter>& Other, T* Ptr) noexcept
         : TBase()
     {
         TBase::template InternalConstructStrong<TOther>(Other, Ptr);
     }
     
     template<typename TOther>
-    TSharedPtr(TSharedPtr<TOther[]>&& Other, T* Ptr) noexcept
+    TSharedPtr(TSharedPtr<TOther[], TRefCounter>&& Other, T* Ptr) noexcept
         : TBase()
     {
         TBase::template InternalConstructStrong<TOther>(::Move(Other), Ptr);
     }
 
     template<typename TOther>
-    TSharedPtr(TSharedPtr<TOther[]>&& Other) noexcept
+    TSharedPtr(TSharedPtr<TOther[], TRefCounter>&& Other) noexcept
         : TBase()
     {
         static_assert(std::is_convertible<TOther*, T*>());
@@ -512,11 +824,11 @@ public:
     }
 
     template<typename TOther>
-    explicit TSharedPtr(const TWeakPtr<TOther[]>& Other) noexcept
+    explicit TSharedPtr(const TWeakPtr<TOther[], TRefCounter>& Other) noexcept
         : TBase()
     {
         static_assert(std::is_convertible<TOther*, T*>());
-        TBase::template InternalConstructStrong<TOther>(Other);
+        TBase::template InternalConstructStrongFromWeak<TOther>(Other);
     }
 
     template<typename TOther>
@@ -557,14 +869,14 @@ public:
     }
 
     template<typename TOther>
-    TSharedPtr& operator=(const TSharedPtr<TOther[]>& Other) noexcept
+    TSharedPtr& operator=(const TSharedPtr<TOther[], TRefCounter>& Other) noexcept
     {
         TSharedPtr(Other).Swap(*this);
         return *this;
     }
 
     template<typename TOther>
-    TSharedPtr& operator=(TSharedPtr<TOther[]>&& Other) noexcept
+    TSharedPtr& operator=(TSharedPtr<TOther[], TRefCounter>&& Other) noexcept
     {
         TSharedPtr(::Move(Other)).Swap(*this);
         return *this;
@@ -593,10 +905,10 @@ public:
 
 // TWeakPtr - Weak Pointer for scalar types, similar to std::weak_ptr
 
-template<typename T>
-class TWeakPtr : public TPtrBase<T, TDelete<T>>
+template<typename T, typename TRefCounter>
+class TWeakPtr : public TPtrBase<T, TDelete<T>, TRefCounter>
 {
-    using TBase = TPtrBase<T, TDelete<T>>;
+    using TBase = TPtrBase<T, TDelete<T>, TRefCounter>;
 
 public:
     TWeakPtr() noexcept
@@ -604,14 +916,14 @@ public:
     {
     }
 
-    TWeakPtr(const TSharedPtr<T>& Other) noexcept
+    TWeakPtr(const TSharedPtr<T, TRefCounter>& Other) noexcept
         : TBase()
     {
         TBase::InternalConstructWeak(Other);
     }
 
     template<typename TOther>
-    TWeakPtr(const TSharedPtr<TOther>& Other) noexcept
+    TWeakPtr(const TSharedPtr<TOther, TRefCounter>& Other) noexcept
         : TBase()
     {
         static_assert(std::is_convertible<TOther*, T*>(), "TWeakPtr: Trying to convert non-convertable types");
@@ -631,7 +943,7 @@ public:
     }
 
     template<typename TOther>
-    TWeakPtr(const TWeakPtr<TOther>& Other) noexcept
+    TWeakPtr(const TWeakPtr<TOther, TRefCounter>& Other) noexcept
         : TBase()
     {
         static_assert(std::is_convertible<TOther*, T*>(), "TWeakPtr: Trying to convert non-convertable types");
@@ -639,7 +951,7 @@ public:
     }
 
     template<typename TOther>
-    TWeakPtr(TWeakPtr<TOther>&& Other) noexcept
+    TWeakPtr(TWeakPtr<TOther, TRefCounter>&& Other) noexcept
         : TBase()
     {
         static_assert(std::is_convertible<TOther*, T*>(), "TWeakPtr: Trying to convert non-convertable types");
@@ -657,10 +969,10 @@ public:
 
     Bool IsExpired() const noexcept { return (TBase::GetStrongReferences() < 1); }
 
-    TSharedPtr<T> MakeShared() noexcept
+    TSharedPtr<T, TRefCounter> MakeShared() noexcept
     {
         const TWeakPtr& This = *this;
-        return ::Move(TSharedPtr<T>(This));
+        return ::Move(TSharedPtr<T, TRefCounter>(This));
     }
 
     T* operator->() const noexcept { return TBase::Get(); }
@@ -684,14 +996,14 @@ public:
     }
 
     template<typename TOther>
-    TWeakPtr& operator=(const TWeakPtr<TOther>& Other) noexcept
+    TWeakPtr& operator=(const TWeakPtr<TOther, TRefCounter>& Other) noexcept
     {
         TWeakPtr(Other).Swap(*this);
         return *this;
     }
 
     template<typename TOther>
-    TWeakPtr& operator=(TWeakPtr<TOther>&& Other) noexcept
+    TWeakPtr& operator=(TWeakPtr<TOther, TRefCounter>&& Other) noexcept
     {
         TWeakPtr(::Move(Other)).Swap(*this);
         return *this;
@@ -720,10 +1032,10 @@ public:
 
 // TWeakPtr - Weak Pointer for array types, similar to std::weak_ptr
 
-template<typename T>
-class TWeakPtr<T[]> : public TPtrBase<T, TDelete<T[]>>
+template<typename T, typename TRefCounter>
+class TWeakPtr<T[], TRefCounter> : public TPtrBase<T, TDelete<T[]>, TRefCounter>
 {
-    using TBase = TPtrBase<T, TDelete<T[]>>;
+    using TBase = TPtrBase<T, TDelete<T[]>, TRefCounter>;
 
 public:
     TWeakPtr() noexcept
@@ -731,14 +1043,14 @@ public:
     {
     }
 
-    TWeakPtr(const TSharedPtr<T>& Other) noexcept
+    TWeakPtr(const TSharedPtr<T, TRefCounter>& Other) noexcept
         : TBase()
     {
         TBase::InternalConstructWeak(Other);
     }
 
     template<typename TOther>
-    TWeakPtr(const TSharedPtr<TOther[]>& Other) noexcept
+    TWeakPtr(const TSharedPtr<TOther[], TRefCounter>& Other) noexcept
         : TBase()
     {
         static_assert(std::is_convertible<TOther*, T*>(), "TWeakPtr: Trying to convert non-convertable types");
@@ -758,7 +1070,7 @@ public:
     }
 
     template<typename TOther>
-    TWeakPtr(const TWeakPtr<TOther[]>& Other) noexcept
+    TWeakPtr(const TWeakPtr<TOther[], TRefCounter>& Other) noexcept
         : TBase()
     {
         static_assert(std::is_convertible<TOther*, T*>(), "TWeakPtr: Trying to convert non-convertable types");
@@ -766,7 +1078,7 @@ public:
     }
 
     template<typename TOther>
-    TWeakPtr(TWeakPtr<TOther[]>&& Other) noexcept
+    TWeakPtr(TWeakPtr<TOther[], TRefCounter>&& Other) noexcept
         : TBase()
     {
         static_assert(std::is_convertible<TOther*, T*>(), "TWeakPtr: Trying to convert non-convertable types");
@@ -784,10 +1096,10 @@ public:
 
     Bool IsExpired() const noexcept { return (TBase::GetStrongReferences() < 1); }
 
-    TSharedPtr<T[]> MakeShared() noexcept
+    TSharedPtr<T[], TRefCounter> MakeShared() noexcept
     {
         const TWeakPtr& This = *this;
-        return ::Move(TSharedPtr<T[]>(This));
+        return ::Move(TSharedPtr<T[], TRefCounter>(This));
     }
     
     T& operator[](UInt32 Index) noexcept
@@ -809,14 +1121,14 @@ public:
     }
 
     template<typename TOther>
-    TWeakPtr& operator=(const TWeakPtr<TOther[]>& Other) noexcept
+    TWeakPtr& operator=(const TWeakPtr<TOther[], TRefCounter>& Other) noexcept
     {
         TWeakPtr(Other).Swap(*this);
         return *this;
     }
 
     template<typename TOther>
-    TWeakPtr& operator=(TWeakPtr<TOther[]>&& Other) noexcept
+    TWeakPtr& operator=(TWeakPtr<TOther[], TRefCounter>&& Other) noexcept
     {
         TWeakPtr(::Move(Other)).Swap(*this);
         return *this;
@@ -843,98 +1155,121 @@ public:
     Bool operator!=(const TWeakPtr& Other) const noexcept { return !(*this == Other); }
 };
 
+// TSharedPtr and TWeakPtr only stores pointers to the object and control block, which does not change when moved
+
+template<typename T, typename TRefCounter>
+struct _TIsTriviallyRelocatable<TSharedPtr<T, TRefCounter>>
+{
+    static constexpr Bool Value = true;
+};
+
+template<typename T, typename TRefCounter>
+struct _TIsTriviallyRelocatable<TWeakPtr<T, TRefCounter>>
+{
+    static constexpr Bool Value = true;
+};
+
+// TThreadSafeSharedPtr and TThreadSafeWeakPtr - Pointers that can be copied and released on multiple threads
+
+template<typename T>
+using TThreadSafeSharedPtr = TSharedPtr<T, ThreadSafeRefCounter>;
+
+template<typename T>
+using TThreadSafeWeakPtr = TWeakPtr<T, ThreadSafeRefCounter>;
+
 // MakeShared - Creates a new object together with a SharedPtr
 
-template<typename T, typename... TArgs>
-TEnableIf<!TIsArray<T>, TSharedPtr<T>> MakeShared(TArgs&&... Args) noexcept
+template<typename T, typename TRefCounter = RefCounter, typename... TArgs>
+TEnableIf<!TIsArray<T>, TSharedPtr<T, TRefCounter>> MakeShared(TArgs&&... Args) noexcept
 {
-    T* RefCountedPtr = new T(Forward<TArgs>(Args)...);
-    return ::Move(TSharedPtr<T>(RefCountedPtr));
+    // Object and control block shares the same allocation
+    TInlinePtrControlBlock<T, TRefCounter>* ControlBlock = new TInlinePtrControlBlock<T, TRefCounter>(::Forward<TArgs>(Args)...);
+    return ::Move(TSharedPtr<T, TRefCounter>(ControlBlock->GetObject(), ControlBlock));
 }
 
-template<typename T>
-TEnableIf<TIsArray<T>, TSharedPtr<T>> MakeShared(UInt32 Size) noexcept
+template<typename T, typename TRefCounter = RefCounter>
+TEnableIf<TIsArray<T>, TSharedPtr<T, TRefCounter>> MakeShared(UInt32 Size) noexcept
 {
     using TType = TRemoveExtent<T>;
 
-    TType* RefCountedPtr = new TType[Size];
-    return ::Move(TSharedPtr<T>(RefCountedPtr));
+    TInlineArrayPtrControlBlock<TType, TRefCounter>* ControlBlock = TInlineArrayPtrControlBlock<TType, TRefCounter>::Create(Size);
+    return ::Move(TSharedPtr<T, TRefCounter>(ControlBlock->GetElements(), ControlBlock));
 }
 
 // Casting functions
 
 // static_cast
-template<typename T0, typename T1>
-TEnableIf<TIsArray<T0> == TIsArray<T1>, TSharedPtr<T0>> StaticCast(const TSharedPtr<T1>& Pointer) noexcept
+template<typename T0, typename T1, typename TRefCounter>
+TEnableIf<TIsArray<T0> == TIsArray<T1>, TSharedPtr<T0, TRefCounter>> StaticCast(const TSharedPtr<T1, TRefCounter>& Pointer) noexcept
 {
     using TType = TRemoveExtent<T0>;
     
     TType* RawPointer = static_cast<TType*>(Pointer.Get());
-    return ::Move(TSharedPtr<T0>(Pointer, RawPointer));
+    return ::Move(TSharedPtr<T0, TRefCounter>(Pointer, RawPointer));
 }
 
-template<typename T0, typename T1>
-TEnableIf<TIsArray<T0> == TIsArray<T1>, TSharedPtr<T0>> StaticCast(TSharedPtr<T1>&& Pointer) noexcept
+template<typename T0, typename T1, typename TRefCounter>
+TEnableIf<TIsArray<T0> == TIsArray<T1>, TSharedPtr<T0, TRefCounter>> StaticCast(TSharedPtr<T1, TRefCounter>&& Pointer) noexcept
 {
     using TType = TRemoveExtent<T0>;
     
     TType* RawPointer = static_cast<TType*>(Pointer.Get());
-    return ::Move(TSharedPtr<T0>(::Move(Pointer), RawPointer));
+    return ::Move(TSharedPtr<T0, TRefCounter>(::Move(Pointer), RawPointer));
 }
 
 // const_cast
-template<typename T0, typename T1>
-TEnableIf<TIsArray<T0> == TIsArray<T1>, TSharedPtr<T0>> ConstCast(const TSharedPtr<T1>& Pointer) noexcept
+template<typename T0, typename T1, typename TRefCounter>
+TEnableIf<TIsArray<T0> == TIsArray<T1>, TSharedPtr<T0, TRefCounter>> ConstCast(const TSharedPtr<T1, TRefCounter>& Pointer) noexcept
 {
     using TType = TRemoveExtent<T0>;
     
     TType* RawPointer = const_cast<TType*>(Pointer.Get());
-    return ::Move(TSharedPtr<T0>(Pointer, RawPointer));
+    return ::Move(TSharedPtr<T0, TRefCounter>(Pointer, RawPointer));
 }
 
-template<typename T0, typename T1>
-TEnableIf<TIsArray<T0> == TIsArray<T1>, TSharedPtr<T0>> ConstCast(TSharedPtr<T1>&& Pointer) noexcept
+template<typename T0, typename T1, typename TRefCounter>
+TEnableIf<TIsArray<T0> == TIsArray<T1>, TSharedPtr<T0, TRefCounter>> ConstCast(TSharedPtr<T1, TRefCounter>&& Pointer) noexcept
 {
     using TType = TRemoveExtent<T0>;
     
     TType* RawPointer = const_cast<TType*>(Pointer.Get());
-    return ::Move(TSharedPtr<T0>(::Move(Pointer), RawPointer));
+    return ::Move(TSharedPtr<T0, TRefCounter>(::Move(Pointer), RawPointer));
 }
 
 // reinterpret_cast
-template<typename T0, typename T1>
-TEnableIf<TIsArray<T0> == TIsArray<T1>, TSharedPtr<T0>> ReinterpretCast(const TSharedPtr<T1>& Pointer) noexcept
+template<typename T0, typename T1, typename TRefCounter>
+TEnableIf<TIsArray<T0> == TIsArray<T1>, TSharedPtr<T0, TRefCounter>> ReinterpretCast(const TSharedPtr<T1, TRefCounter>& Pointer) noexcept
 {
     using TType = TRemoveExtent<T0>;
     
     TType* RawPointer = reinterpret_cast<TType*>(Pointer.Get());
-    return ::Move(TSharedPtr<T0>(Pointer, RawPointer));
+    return ::Move(TSharedPtr<T0, TRefCounter>(Pointer, RawPointer));
 }
 
-template<typename T0, typename T1>
-TEnableIf<TIsArray<T0> == TIsArray<T1>, TSharedPtr<T0>> ReinterpretCast(TSharedPtr<T1>&& Pointer) noexcept
+template<typename T0, typename T1, typename TRefCounter>
+TEnableIf<TIsArray<T0> == TIsArray<T1>, TSharedPtr<T0, TRefCounter>> ReinterpretCast(TSharedPtr<T1, TRefCounter>&& Pointer) noexcept
 {
     using TType = TRemoveExtent<T0>;
     
     TType* RawPointer = reinterpret_cast<TType*>(Pointer.Get());
-    return ::Move(TSharedPtr<T0>(::Move(Pointer), RawPointer));
+    return ::Move(TSharedPtr<T0, TRefCounter>(::Move(Pointer), RawPointer));
 }
 
 // dynamic_cast
-template<typename T0, typename T1>
-TEnableIf<TIsArray<T0> == TIsArray<T1>, TSharedPtr<T0>> DynamicCast(const TSharedPtr<T1>& Pointer) noexcept
+template<typename T0, typename T1, typename TRefCounter>
+TEnableIf<TIsArray<T0> == TIsArray<T1>, TSharedPtr<T0, TRefCounter>> DynamicCast(const TSharedPtr<T1, TRefCounter>& Pointer) noexcept
 {
     using TType = TRemoveExtent<T0>;
     
     TType* RawPointer = dynamic_cast<TType*>(Pointer.Get());
-    return ::Move(TSharedPtr<T0>(Pointer, RawPointer));
+    return ::Move(TSharedPtr<T0, TRefCounter>(Pointer, RawPointer));
 }
 
-template<typename T0, typename T1>
-TEnableIf<TIsArray<T0> == TIsArray<T1>, TSharedPtr<T0>> DynamicCast(TSharedPtr<T1>&& Pointer) noexcept
+template<typename T0, typename T1, typename TRefCounter>
+TEnableIf<TIsArray<T0> == TIsArray<T1>, TSharedPtr<T0, TRefCounter>> DynamicCast(TSharedPtr<T1, TRefCounter>&& Pointer) noexcept
 {
     using TType = TRemoveExtent<T0>;
     
     TType* RawPointer = dynamic_cast<TType*>(Pointer.Get());
-    return ::Move(TSharedPtr<T0>(::Move(Pointer), RawPointer));
+    return ::Move(TSharedPtr<T0, TRefCounter>(::Move(Pointer), RawPointer));
 }
@@ -0,0 +1,575 @@
+#pragma once
+#include "Utilities.h"
+#include "Allocator.h"
+#include "ArrayView.h"
+#include "GrowthPolicy.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+// TSoAIterator - Iterates the elements of a TSoAArray by index and returns a tuple of references to the fields
+
+template<typename TArrayType, typename TReference>
+class TSoAIterator
+{
+public:
+    typedef typename TArrayType::SizeType SizeType;
+
+    // Dereferencing returns a proxy, so there is no pointer type
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef typename TArrayType::ValueType  value_type;
+    typedef Int64                           difference_type;
+    typedef void                            pointer;
+    typedef TReference                      reference;
+
+    TSoAIterator() noexcept
+        : mArray(nullptr)
+        , mIndex(0)
+    {
+    }
+
+    TSoAIterator(TArrayType* InArray, SizeType InIndex) noexcept
+        : mArray(InArray)
+        , mIndex(InIndex)
+    {
+    }
+
+    SizeType GetIndex() const noexcept { return mIndex; }
+
+    TReference operator*() const noexcept { return (*mArray)[mIndex]; }
+    TReference operator[](Int64 Offset) const noexcept { return (*mArray)[SizeType(mIndex + Offset)]; }
+
+    TSoAIterator& operator++() noexcept
+    {
+        mIndex++;
+        return *this;
+    }
+
+    TSoAIterator operator++(Int32) noexcept
+    {
+        TSoAIterator Temp = *this;
+        mIndex++;
+        return Temp;
+    }
+
+    TSoAIterator& operator--() noexcept
+    {
+        mIndex--;
+        return *this;
+    }
+
+    TSoAIterator operator--(Int32) noexcept
+    {
+        TSoAIterator Temp = *this;
+        mIndex--;
+        return Temp;
+    }
+
+    TSoAIterator& operator+=(Int64 Offset) noexcept
+    {
+        mIndex = SizeType(mIndex + Offset);
+        return *this;
+    }
+
+    TSoAIterator& operator-=(Int64 Offset) noexcept
+    {
+        mIndex = SizeType(mIndex - Offset);
+        return *this;
+    }
+
+    TSoAIterator operator+(Int64 Offset) const noexcept { return TSoAIterator(mArray, SizeType(mIndex + Offset)); }
+    TSoAIterator operator-(Int64 Offset) const noexcept { return TSoAIterator(mArray, SizeType(mIndex - Offset)); }
+    Int64 operator-(const TSoAIterator& Other) const noexcept { return Int64(mIndex) - Int64(Other.mIndex); }
+
+    friend TSoAIterator operator+(Int64 Offset, const TSoAIterator& Iterator) noexcept { return Iterator + Offset; }
+
+    Bool operator==(const TSoAIterator& Other) const noexcept { return (mIndex == Other.mIndex); }
+    Bool operator!=(const TSoAIterator& Other) const noexcept { return (mIndex != Other.mIndex); }
+    Bool operator<(const TSoAIterator& Other) const noexcept { return (mIndex < Other.mIndex); }
+    Bool operator<=(const TSoAIterator& Other) const noexcept { return (mIndex <= Other.mIndex); }
+    Bool operator>(const TSoAIterator& Other) const noexcept { return (mIndex > Other.mIndex); }
+    Bool operator>=(const TSoAIterator& Other) const noexcept { return (mIndex >= Other.mIndex); }
+
+private:
+    TArrayType* mArray;
+    SizeType    mIndex;
+};
+
+/*
+ * TSoAArray - Dynamic array that stores each field in its own contiguous column, so that a loop over one field only
+ * reads that field. All columns live in a single allocation and grow together. The columns start at multiples of
+ * ColumnAlignment from the start of the block, so the same element has the same alignment in every column and SIMD
+ * loops over several columns through GetColumn stay in step. Elements are accessed as a tuple of references to their
+ * fields, which supports structured bindings.
+ */
+
+template<typename... TFields>
+class TSoAArray
+{
+    static_assert(sizeof...(TFields) > 0, "TSoAArray needs at least one field");
+
+    typedef Mallocator      TAllocator;
+    typedef GeometricGrowth TGrowthPolicy;
+
+public:
+    typedef TAllocatorSizeType<TAllocator>   SizeType;
+    typedef std::tuple<TFields...>           ValueType;
+    typedef std::tuple<TFields&...>          Reference;
+    typedef std::tuple<const TFields&...>    ConstReference;
+
+    typedef TSoAIterator<TSoAArray, Reference>            Iterator;
+    typedef TSoAIterator<const TSoAArray, ConstReference> ConstIterator;
+
+    template<UInt32 FieldIndex>
+    using FieldType = std::tuple_element_t<FieldIndex, std::tuple<TFields...>>;
+
+    static constexpr UInt32 NumFields       = UInt32(sizeof...(TFields));
+    static constexpr UInt64 ColumnAlignment = 64;
+
+    TSoAArray() noexcept
+        : mData(nullptr)
+        , mColumns()
+        , mSize(0)
+        , mCapacity(0)
+        , mAllocator()
+    {
+    }
+
+    explicit TSoAArray(SizeType Size) noexcept
+        : TSoAArray()
+    {
+        Resize(Size);
+    }
+
+    TSoAArray(const TSoAArray& Other) noexcept
+        : TSoAArray()
+    {
+        InternalCopy(Other);
+    }
+
+    TSoAArray(TSoAArray&& Other) noexcept
+        : mData(Other.mData)
+        , mColumns(Other.mColumns)
+        , mSize(Other.mSize)
+        , mCapacity(Other.mCapacity)
+        , mAllocator(::Move(Other.mAllocator))
+    {
+        Other.mData     = nullptr;
+        Other.mColumns  = std::tuple<TFields*...>();
+        Other.mSize     = 0;
+        Other.mCapacity = 0;
+    }
+
+    ~TSoAArray()
+    {
+        Clear();
+        InternalReleaseData();
+    }
+
+    void Clear() noexcept
+    {
+        InternalDestructRange(0, mSize, std::index_sequence_for<TFields...>());
+        mSize = 0;
+    }
+
+    void Reserve(SizeType Capacity) noexcept
+    {
+        if (Capacity > mCapacity)
+        {
+            InternalRealloc(Capacity);
+        }
+    }
+
+    void Resize(SizeType InSize) noexcept
+    {
+        if (InSize > mSize)
+        {
+            Reserve(InSize);
+            InternalDefaultConstructRange(mSize, InSize, std::index_sequence_for<TFields...>());
+        }
+        else
+        {
+            InternalDestructRange(InSize, mSize, std::index_sequence_for<TFields...>());
+        }
+
+        mSize = InSize;
+    }
+
+    // Takes one value per field, each column grows by one element
+    template<typename... TArgs>
+    Reference EmplaceBack(TArgs&&... Args) noexcept
+    {
+        static_assert(sizeof...(TArgs) == NumFields, "EmplaceBack needs one value per field");
+
+        if (mSize == mCapacity)
+        {
+            InternalRealloc(InternalGetResizeFactor());
+        }
+
+        InternalConstructAt(mSize, std::index_sequence_for<TFields...>(), ::Forward<TArgs>(Args)...);
+        return (*this)[mSize++];
+    }
+
+    void PopBack() noexcept
+    {
+        VALIDATE(mSize > 0);
+        mSize--;
+        InternalDestructRange(mSize, mSize + 1, std::index_sequence_for<TFields...>());
+    }
+
+    // Moves the last element into the removed slot, O(1) but does not keep the order
+    void RemoveAtSwap(SizeType Index) noexcept
+    {
+        VALIDATE(Index < mSize);
+
+        const SizeType LastIndex = mSize - 1;
+        if (Index != LastIndex)
+        {
+            InternalMoveAssign(LastIndex, Index, std::index_sequence_for<TFields...>());
+        }
+
+        PopBack();
+    }
+
+    void Swap(TSoAArray& Other) noexcept
+    {
+        TSoAArray Temp(::Move(*this));
+        *this = ::Move(Other);
+        Other = ::Move(Temp);
+    }
+
+    template<UInt32 FieldIndex>
+    FieldType<FieldIndex>* Data() noexcept { return std::get<FieldIndex>(mColumns); }
+
+    template<UInt32 FieldIndex>
+    const FieldType<FieldIndex>* Data() const noexcept { return std::get<FieldIndex>(mColumns); }
+
+    // One field of all elements, contiguous and at a multiple of ColumnAlignment from the first column
+    template<UInt32 FieldIndex>
+    TArrayView<FieldType<FieldIndex>, SizeType> GetColumn() noexcept
+    {
+        FieldType<FieldIndex>* Column = Data<FieldIndex>();
+        return TArrayView<FieldType<FieldIndex>, SizeType>(Column, Column + mSize);
+    }
+
+    template<UInt32 FieldIndex>
+    TArrayView<const FieldType<FieldIndex>, SizeType> GetColumn() const noexcept
+    {
+        const FieldType<FieldIndex>* Column = Data<FieldIndex>();
+        return TArrayView<const FieldType<FieldIndex>, SizeType>(Column, Column + mSize);
+    }
+
+    template<UInt32 FieldIndex>
+    FieldType<FieldIndex>& Get(SizeType Index) noexcept
+    {
+        VALIDATE(Index < mSize);
+        return Data<FieldIndex>()[Index];
+    }
+
+    template<UInt32 FieldIndex>
+    const FieldType<FieldIndex>& Get(SizeType Index) const noexcept
+    {
+        VALIDATE(Index < mSize);
+        return Data<FieldIndex>()[Index];
+    }
+
+    Iterator Begin() noexcept { return Iterator(this, 0); }
+    Iterator End() noexcept { return Iterator(this, mSize); }
+
+    ConstIterator Begin() const noexcept { return ConstIterator(this, 0); }
+    ConstIterator End() const noexcept { return ConstIterator(this, mSize); }
+
+    Reference Front() noexcept { return (*this)[0]; }
+    ConstReference Front() const noexcept { return (*this)[0]; }
+
+    Reference Back() noexcept { return (*this)[mSize - 1]; }
+    ConstReference Back() const noexcept { return (*this)[mSize - 1]; }
+
+    Bool IsEmpty() const noexcept { return (mSize == 0); }
+    SizeType Size() const noexcept { return mSize; }
+    SizeType Capacity() const noexcept { return mCapacity; }
+
+    // Bytes of all columns, including the padding between them
+    UInt64 CapacityInBytes() const noexcept { return InternalGetBlockSize(mCapacity); }
+
+    static constexpr SizeType MaxSize() noexcept { return std::numeric_limits<SizeType>::max(); }
+
+    Reference At(SizeType Index) noexcept
+    {
+        VALIDATE(Index < mSize);
+        return InternalGetReference(Index, std::index_sequence_for<TFields...>());
+    }
+
+    ConstReference At(SizeType Index) const noexcept
+    {
+        VALIDATE(Index < mSize);
+        return InternalGetReference(Index, std::index_sequence_for<TFields...>());
+    }
+
+    TSoAArray& operator=(const TSoAArray& Other) noexcept
+    {
+        if (this != std::addressof(Other))
+        {
+            Clear();
+            InternalCopy(Other);
+        }
+
+        return *this;
+    }
+
+    TSoAArray& operator=(TSoAArray&& Other) noexcept
+    {
+        if (this != std::addressof(Other))
+        {
+            Clear();
+            InternalReleaseData();
+
+            mData      = Other.mData;
+            mColumns   = Other.mColumns;
+            mSize      = Other.mSize;
+            mCapacity  = Other.mCapacity;
+            mAllocator = ::Move(Other.mAllocator);
+
+            Other.mData     = nullptr;
+            Other.mColumns  = std::tuple<TFields*...>();
+            Other.mSize     = 0;
+            Other.mCapacity = 0;
+        }
+
+        return *this;
+    }
+
+    Reference operator[](SizeType Index) noexcept { return At(Index); }
+    ConstReference operator[](SizeType Index) const noexcept { return At(Index); }
+
+    // STL iterator functions - Enables Range-based for-loops
+public:
+    Iterator begin() noexcept { return Begin(); }
+    Iterator end() noexcept { return End(); }
+
+    ConstIterator begin() const noexcept { return Begin(); }
+    ConstIterator end() const noexcept { return End(); }
+
+private:
+    static constexpr Bool IsRelocatable = (TIsTriviallyRelocatable<TFields> && ...);
+
+    // The alignment of malloc, so that the allocator can grow the block with realloc
+    static constexpr UInt64 BlockAlignment = std::max({ UInt64(alignof(TFields))..., UInt64(Mallocator::DefaultAlignment) });
+
+    static constexpr UInt64 InternalAlignColumn(UInt64 Offset) noexcept
+    {
+        return (Offset + ColumnAlignment - 1) & ~(ColumnAlignment - 1);
+    }
+
+    // Columns follow each other in the order of the fields
+    static constexpr UInt64 InternalGetBlockSize(SizeType Capacity) noexcept
+    {
+        UInt64 Offset = 0;
+        ((Offset = InternalAlignColumn(Offset) + UInt64(Capacity) * sizeof(TFields)), ...);
+        return Offset;
+    }
+
+    SizeType InternalGetResizeFactor() const noexcept
+    {
+        VALIDATE(mSize < MaxSize());
+
+        const UInt64 NumElements = UInt64(mSize) + 1;
+        const UInt64 NewCapacity = TGrowthPolicy::GetCapacity(NumElements, mCapacity, InternalGetBlockSize(1));
+        return (NewCapacity >= NumElements && NewCapacity <= MaxSize()) ? SizeType(NewCapacity) : MaxSize();
+    }
+
+    template<size_t... Indices>
+    void InternalSetColumns(Byte* Block, SizeType Capacity, std::index_sequence<Indices...>) noexcept
+    {
+        UInt64 Offset = 0;
+        ((std::get<Indices>(mColumns) = reinterpret_cast<FieldType<Indices>*>(Block + InternalAlignColumn(Offset)),
+          Offset = InternalAlignColumn(Offset) + UInt64(Capacity) * sizeof(FieldType<Indices>)), ...);
+    }
+
+    template<typename T>
+    static void InternalRelocateColumn(T* Source, T* Dest, SizeType Count) noexcept
+    {
+        if constexpr (TIsTriviallyRelocatable<T>)
+        {
+            if (Count > 0)
+            {
+                ::memcpy(reinterpret_cast<void*>(Dest), reinterpret_cast<const void*>(Source), UInt64(Count) * sizeof(T));
+            }
+        }
+        else
+        {
+            for (SizeType Index = 0; Index < Count; Index++)
+            {
+                new(reinterpret_cast<void*>(Dest + Index)) T(::Move(Source[Index]));
+                Source[Index].~T();
+            }
+        }
+    }
+
+    void InternalRealloc(SizeType Capacity) noexcept
+    {
+        VALIDATE(Capacity >= mCapacity);
+
+        // The allocator may be able to grow the block in place, then the columns are moved apart from the last one,
+        // since every column moves to a higher offset
+        if constexpr (IsRelocatable && THasReallocate<TAllocator>)
+        {
+            if (mData)
+            {
+                const std::tuple<TFields*...> OldColumns = mColumns;
+                Byte* NewData = reinterpret_cast<Byte*>(mAllocator.Reallocate(reinterpret_cast<void*>(mData), InternalGetBlockSize(Capacity), BlockAlignment));
+                VALIDATE(NewData != nullptr);
+
+                InternalSetColumns(NewData, Capacity, std::index_sequence_for<TFields...>());
+                InternalMoveColumnsBackwards(OldColumns, NewData, std::make_index_sequence<NumFields>());
+
+                mData     = NewData;
+                mCapacity = Capacity;
+                return;
+            }
+        }
+
+        Byte* NewData = reinterpret_cast<Byte*>(mAllocator.Allocate(InternalGetBlockSize(Capacity), BlockAlignment));
+        VALIDATE(NewData != nullptr);
+
+        const std::tuple<TFields*...> OldColumns = mColumns;
+        InternalSetColumns(NewData, Capacity, std::index_sequence_for<TFields...>());
+        InternalRelocateColumns(OldColumns, std::index_sequence_for<TFields...>());
+
+        InternalReleaseData();
+        mData     = NewData;
+        mCapacity = Capacity;
+    }
+
+    template<size_t... Indices>
+    void InternalRelocateColumns(const std::tuple<TFields*...>& OldColumns, std::index_sequence<Indices...>) noexcept
+    {
+        (InternalRelocateColumn(std::get<Indices>(OldColumns), std::get<Indices>(mColumns), mSize), ...);
+    }
+
+    // The old columns are at the same offsets in the reallocated block
+    template<size_t... Indices>
+    void InternalMoveColumnsBackwards(const std::tuple<TFields*...>& OldColumns, Byte* NewData, std::index_sequence<Indices...>) noexcept
+    {
+        const Byte* OldData = reinterpret_cast<const Byte*>(std::get<0>(OldColumns));
+        ((InternalMoveColumn<NumFields - 1 - Indices>(NewData + (reinterpret_cast<const Byte*>(std::get<NumFields - 1 - Indices>(OldColumns)) - OldData))), ...);
+    }
+
+    template<size_t FieldIndex>
+    void InternalMoveColumn(Byte* OldColumn) noexcept
+    {
+        Byte* NewColumn = reinterpret_cast<Byte*>(std::get<FieldIndex>(mColumns));
+        if (NewColumn != OldColumn && mSize > 0)
+        {
+            ::memmove(NewColumn, OldColumn, UInt64(mSize) * sizeof(FieldType<FieldIndex>));
+        }
+    }
+
+    void InternalReleaseData() noexcept
+    {
+        if (mData)
+        {
+            mAllocator.Free(reinterpret_cast<void*>(mData), BlockAlignment);
+            mData = nullptr;
+        }
+    }
+
+    void InternalCopy(const TSoAArray& Other) noexcept
+    {
+        Reserve(Other.mSize);
+        InternalCopyColumns(Other, std::index_sequence_for<TFields...>());
+        mSize = Other.mSize;
+    }
+
+    template<size_t... Indices>
+    void InternalCopyColumns(const TSoAArray& Other, std::index_sequence<Indices...>) noexcept
+    {
+        (InternalCopyColumn(std::get<Indices>(Other.mColumns), std::get<Indices>(mColumns), Other.mSize), ...);
+    }
+
+    template<typename T>
+    static void InternalCopyColumn(const T* Source, T* Dest, SizeType Count) noexcept
+    {
+        if constexpr (std::is_trivially_copy_constructible<T>())
+        {
+            if (Count > 0)
+            {
+                ::memcpy(reinterpret_cast<void*>(Dest), reinterpret_cast<const void*>(Source), UInt64(Count) * sizeof(T));
+            }
+        }
+        else
+        {
+            for (SizeType Index = 0; Index < Count; Index++)
+            {
+                new(reinterpret_cast<void*>(Dest + Index)) T(Source[Index]);
+            }
+        }
+    }
+
+    template<size_t... Indices, typename... TArgs>
+    void InternalConstructAt(SizeType Index, std::index_sequence<Indices...>, TArgs&&... Args) noexcept
+    {
+        (new(reinterpret_cast<void*>(std::get<Indices>(mColumns) + Index)) FieldType<Indices>(::Forward<TArgs>(Args)), ...);
+    }
+
+    template<size_t... Indices>
+    void InternalDefaultConstructRange(SizeType First, SizeType Last, std::index_sequence<Indices...>) noexcept
+    {
+        for (SizeType Index = First; Index < Last; Index++)
+        {
+            (new(reinterpret_cast<void*>(std::get<Indices>(mColumns) + Index)) FieldType<Indices>(), ...);
+        }
+    }
+
+    template<size_t... Indices>
+    void InternalDestructRange(SizeType First, SizeType Last, std::index_sequence<Indices...>) noexcept
+    {
+        (InternalDestructColumn(std::get<Indices>(mColumns), First, Last), ...);
+    }
+
+    template<typename T>
+    static void InternalDestructColumn(T* Column, SizeType First, SizeType Last) noexcept
+    {
+        if constexpr (!std::is_trivially_destructible<T>())
+        {
+            for (SizeType Index = First; Index < Last; Index++)
+            {
+                Column[Index].~T();
+            }
+        }
+    }
+
+    template<size_t... Indices>
+    void InternalMoveAssign(SizeType Source, SizeType Dest, std::index_sequence<Indices...>) noexcept
+    {
+        ((std::get<Indices>(mColumns)[Dest] = ::Move(std::get<Indices>(mColumns)[Source])), ...);
+    }
+
+    template<size_t... Indices>
+    Reference InternalGetReference(SizeType Index, std::index_sequence<Indices...>) noexcept
+    {
+        return Reference(std::get<Indices>(mColumns)[Index]...);
+    }
+
+    template<size_t... Indices>
+    ConstReference InternalGetReference(SizeType Index, std::index_sequence<Indices...>) const noexcept
+    {
+        return ConstReference(std::get<Indices>(mColumns)[Index]...);
+    }
+
+    Byte*                   mData;
+    std::tuple<TFields*...> mColumns;
+    SizeType                mSize;
+    SizeType                mCapacity;
+    TAllocator              mAllocator;
+};
+
+template<typename... TFields>
+struct _TIsTriviallyRelocatable<TSoAArray<TFields...>>
+{
+    static constexpr Bool Value = true;
+};
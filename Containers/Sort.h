@@ -0,0 +1,760 @@
+#pragma once
+#include "Utilities.h"
+#include "Allocator.h"
+#include "Array.h"
+#include "ArrayView.h"
+
+#include <cstring>
+#include <thread>
+
+/*
+ * Sorting - In-place sorting of the elements in a TArrayView, TArrays can be passed directly. Sort is an introsort in
+ * the style of pdqsort, RadixSort is a stable LSD radix sort for integer and floating point keys, and ParallelSort
+ * sorts chunks on separate threads and merges them. The By-variants take a projection that returns the sort key.
+ */
+
+// LessThan - Default comparison of Sort
+
+struct LessThan
+{
+    template<typename T0, typename T1>
+    constexpr Bool operator()(const T0& Lhs, const T1& Rhs) const noexcept
+    {
+        return (Lhs < Rhs);
+    }
+};
+
+// _SortImpl - Implementation of the sorting algorithms on raw pointer ranges
+
+struct _SortImpl
+{
+    static constexpr UInt64 InsertionSortThreshold = 24;
+    static constexpr UInt64 NintherThreshold       = 128;
+    static constexpr UInt64 PartialInsertionLimit  = 8;
+
+    // Below this size ParallelSort sorts on the calling thread
+    static constexpr UInt64 ParallelThreshold = 64 * 1024;
+
+    template<typename T>
+    static FORCEINLINE void Swap(T& Lhs, T& Rhs) noexcept
+    {
+        T Temp(::Move(Lhs));
+        Lhs = ::Move(Rhs);
+        Rhs = ::Move(Temp);
+    }
+
+    template<typename T, typename TLess>
+    static FORCEINLINE void Sort2(T* A, T* B, TLess& Less) noexcept
+    {
+        if (Less(*B, *A))
+        {
+            Swap(*A, *B);
+        }
+    }
+
+    template<typename T, typename TLess>
+    static FORCEINLINE void Sort3(T* A, T* B, T* C, TLess& Less) noexcept
+    {
+        Sort2(A, B, Less);
+        Sort2(B, C, Less);
+        Sort2(A, B, Less);
+    }
+
+    template<typename T, typename TLess>
+    static void InsertionSort(T* Begin, T* End, TLess& Less) noexcept
+    {
+        if (Begin == End)
+        {
+            return;
+        }
+
+        for (T* Current = Begin + 1; Current != End; Current++)
+        {
+            T* Sift     = Current;
+            T* Previous = Current - 1;
+            if (Less(*Sift, *Previous))
+            {
+                T Temp(::Move(*Sift));
+                do
+                {
+                    *Sift-- = ::Move(*Previous);
+                } while (Sift != Begin && Less(Temp, *--Previous));
+
+                *Sift = ::Move(Temp);
+            }
+        }
+    }
+
+    // The element before Begin must not be greater than any element in the range, so the bounds check can be skipped
+    template<typename T, typename TLess>
+    static void UnguardedInsertionSort(T* Begin, T* End, TLess& Less) noexcept
+    {
+        if (Begin == End)
+        {
+            return;
+        }
+
+        for (T* Current = Begin + 1; Current != End; Current++)
+        {
+            T* Sift     = Current;
+            T* Previous = Current - 1;
+            if (Less(*Sift, *Previous))
+            {
+                T Temp(::Move(*Sift));
+                do
+                {
+                    *Sift-- = ::Move(*Previous);
+                } while (Less(Temp, *--Previous));
+
+                *Sift = ::Move(Temp);
+            }
+        }
+    }
+
+    // Insertion sort that gives up after moving a few elements, returns true if the range was sorted
+    template<typename T, typename TLess>
+    static Bool PartialInsertionSort(T* Begin, T* End, TLess& Less) noexcept
+    {
+        if (Begin == End)
+        {
+            return true;
+        }
+
+        UInt64 NumMoved = 0;
+        for (T* Current = Begin + 1; Current != End; Current++)
+        {
+            T* Sift     = Current;
+            T* Previous = Current - 1;
+            if (Less(*Sift, *Previous))
+            {
+                T Temp(::Move(*Sift));
+                do
+                {
+                    *Sift-- = ::Move(*Previous);
+                } while (Sift != Begin && Less(Temp, *--Previous));
+
+                *Sift = ::Move(Temp);
+                NumMoved += UInt64(Current - Sift);
+            }
+
+            if (NumMoved > PartialInsertionLimit)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    template<typename T, typename TLess>
+    static void SiftDown(T* Begin, UInt64 Index, UInt64 Size, TLess& Less) noexcept
+    {
+        T Temp(::Move(Begin[Index]));
+        while (true)
+        {
+            UInt64 Child = (Index * 2) + 1;
+            if (Child >= Size)
+            {
+                break;
+            }
+
+            if ((Child + 1) < Size && Less(Begin[Child], Begin[Child + 1]))
+            {
+                Child++;
+            }
+
+            if (!Less(Temp, Begin[Child]))
+            {
+                break;
+            }
+
+            Begin[Index] = ::Move(Begin[Child]);
+            Index = Child;
+        }
+
+        Begin[Index] = ::Move(Temp);
+    }
+
+    template<typename T, typename TLess>
+    static void HeapSort(T* Begin, T* End, TLess& Less) noexcept
+    {
+        const UInt64 Size = UInt64(End - Begin);
+        for (UInt64 Index = Size / 2; Index > 0; Index--)
+        {
+            SiftDown(Begin, Index - 1, Size, Less);
+        }
+
+        for (UInt64 Last = Size; Last > 1; Last--)
+        {
+            Swap(Begin[0], Begin[Last - 1]);
+            SiftDown(Begin, 0, Last - 1, Less);
+        }
+    }
+
+    // Partitions around the pivot in Begin, elements equal to the pivot go to the right. Returns the position of the
+    // pivot, and sets AlreadyPartitioned if no elements had to be swapped.
+    template<typename T, typename TLess>
+    static T* PartitionRight(T* Begin, T* End, TLess& Less, Bool& OutAlreadyPartitioned) noexcept
+    {
+        T Pivot(::Move(*Begin));
+
+        T* First = Begin;
+        T* Last  = End;
+
+        // The median of three guarantees that there is an element that is not less than the pivot
+        while (Less(*++First, Pivot))
+        {
+        }
+
+        if (First - 1 == Begin)
+        {
+            while (First < Last && !Less(*--Last, Pivot))
+            {
+            }
+        }
+        else
+        {
+            while (!Less(*--Last, Pivot))
+            {
+            }
+        }
+
+        OutAlreadyPartitioned = (First >= Last);
+
+        while (First < Last)
+        {
+            Swap(*First, *Last);
+            while (Less(*++First, Pivot))
+            {
+            }
+
+            while (!Less(*--Last, Pivot))
+            {
+            }
+        }
+
+        T* PivotPos = First - 1;
+        *Begin    = ::Move(*PivotPos);
+        *PivotPos = ::Move(Pivot);
+        return PivotPos;
+    }
+
+    // Partitions around the pivot in Begin, elements equal to the pivot go to the left. Used when the pivot is equal to
+    // the element before the range, so that runs of equal elements are not partitioned again.
+    template<typename T, typename TLess>
+    static T* PartitionLeft(T* Begin, T* End, TLess& Less) noexcept
+    {
+        T Pivot(::Move(*Begin));
+
+        T* First = Begin;
+        T* Last  = End;
+        while (Less(Pivot, *--Last))
+        {
+        }
+
+        if (Last + 1 == End)
+        {
+            while (First < Last && !Less(Pivot, *++First))
+            {
+            }
+        }
+        else
+        {
+            while (!Less(Pivot, *++First))
+            {
+            }
+        }
+
+        while (First < Last)
+        {
+            Swap(*First, *Last);
+            while (Less(Pivot, *--Last))
+            {
+            }
+
+            while (!Less(Pivot, *++First))
+            {
+            }
+        }
+
+        T* PivotPos = Last;
+        *Begin    = ::Move(*PivotPos);
+        *PivotPos = ::Move(Pivot);
+        return PivotPos;
+    }
+
+    template<typename T, typename TLess>
+    static void PatternDefeatingSort(T* Begin, T* End, TLess& Less, Int32 BadAllowed, Bool IsLeftMost) noexcept
+    {
+        while (true)
+        {
+            const UInt64 Size = UInt64(End - Begin);
+            if (Size < InsertionSortThreshold)
+            {
+                if (IsLeftMost)
+                {
+                    InsertionSort(Begin, End, Less);
+                }
+                else
+                {
+                    UnguardedInsertionSort(Begin, End, Less);
+                }
+
+                return;
+            }
+
+            // Median of three, or the pseudomedian of nine for larger ranges, is moved to Begin
+            const UInt64 Half = Size / 2;
+            if (Size > NintherThreshold)
+            {
+                Sort3(Begin, Begin + Half, End - 1, Less);
+                Sort3(Begin + 1, Begin + (Half - 1), End - 2, Less);
+                Sort3(Begin + 2, Begin + (Half + 1), End - 3, Less);
+                Sort3(Begin + (Half - 1), Begin + Half, Begin + (Half + 1), Less);
+                Swap(*Begin, *(Begin + Half));
+            }
+            else
+            {
+                Sort3(Begin + Half, Begin, End - 1, Less);
+            }
+
+            // The pivot equals the element before the range, so all elements equal to it are already in place
+            if (!IsLeftMost && !Less(*(Begin - 1), *Begin))
+            {
+                Begin = PartitionLeft(Begin, End, Less) + 1;
+                continue;
+            }
+
+            Bool AlreadyPartitioned = false;
+            T* PivotPos = PartitionRight(Begin, End, Less, AlreadyPartitioned);
+
+            const UInt64 LeftSize  = UInt64(PivotPos - Begin);
+            const UInt64 RightSize = UInt64(End - (PivotPos + 1));
+            if (LeftSize < (Size / 8) || RightSize < (Size / 8))
+            {
+                // Too many unbalanced partitions, fall back to heap sort to guarantee O(n log n)
+                if (--BadAllowed == 0)
+                {
+                    HeapSort(Begin, End, Less);
+                    return;
+                }
+
+                // Swap elements around to break up patterns that cause bad pivots
+                if (LeftSize >= InsertionSortThreshold)
+                {
+                    Swap(Begin[0], Begin[LeftSize / 4]);
+                    Swap(PivotPos[-1], PivotPos[-Int64(LeftSize / 4)]);
+                    if (LeftSize > NintherThreshold)
+                    {
+                        Swap(Begin[1], Begin[LeftSize / 4 + 1]);
+                        Swap(Begin[2], Begin[LeftSize / 4 + 2]);
+                        Swap(PivotPos[-2], PivotPos[-Int64(LeftSize / 4 + 1)]);
+                        Swap(PivotPos[-3], PivotPos[-Int64(LeftSize / 4 + 2)]);
+                    }
+                }
+
+                if (RightSize >= InsertionSortThreshold)
+                {
+                    Swap(PivotPos[1], PivotPos[1 + RightSize / 4]);
+                    Swap(End[-1], End[-Int64(RightSize / 4)]);
+                    if (RightSize > NintherThreshold)
+                    {
+                        Swap(PivotPos[2], PivotPos[2 + RightSize / 4]);
+                        Swap(PivotPos[3], PivotPos[3 + RightSize / 4]);
+                        Swap(End[-2], End[-Int64(1 + RightSize / 4)]);
+                        Swap(End[-3], End[-Int64(2 + RightSize / 4)]);
+                    }
+                }
+            }
+            else if (AlreadyPartitioned && PartialInsertionSort(Begin, PivotPos, Less) && PartialInsertionSort(PivotPos + 1, End, Less))
+            {
+                // The range was most likely sorted already
+                return;
+            }
+
+            // Recurse into the left side and loop on the right side
+            PatternDefeatingSort(Begin, PivotPos, Less, BadAllowed, IsLeftMost);
+            Begin      = PivotPos + 1;
+            IsLeftMost = false;
+        }
+    }
+
+    template<typename T, typename TLess>
+    static void Sort(T* Begin, T* End, TLess& Less) noexcept
+    {
+        const UInt64 Size = UInt64(End - Begin);
+        if (Size < 2)
+        {
+            return;
+        }
+
+        Int32 Log2 = 0;
+        for (UInt64 Temp = Size; Temp > 1; Temp >>= 1)
+        {
+            Log2++;
+        }
+
+        PatternDefeatingSort(Begin, End, Less, Log2, true);
+    }
+
+    /*
+     * Radix sort
+     */
+
+    // Maps a key to an unsigned integer with the same ordering
+    template<typename TKey>
+    static FORCEINLINE auto GetRadixKey(TKey Key) noexcept
+    {
+        static_assert(std::is_arithmetic<TKey>(), "RadixSort requires integer or floating point keys");
+
+        if constexpr (std::is_floating_point<TKey>())
+        {
+            typedef std::conditional_t<sizeof(TKey) == 8, UInt64, UInt32> TBits;
+            constexpr TBits SignBit = TBits(1) << (sizeof(TBits) * 8 - 1);
+
+            // Negative numbers are flipped completely so that they order in reverse, positive numbers get the sign bit set
+            TBits Bits;
+            ::memcpy(&Bits, &Key, sizeof(TBits));
+            return (Bits & SignBit) ? TBits(~Bits) : TBits(Bits | SignBit);
+        }
+        else
+        {
+            typedef std::make_unsigned_t<TKey> TBits;
+            if constexpr (std::is_signed<TKey>())
+            {
+                constexpr TBits SignBit = TBits(TBits(1) << (sizeof(TBits) * 8 - 1));
+                return TBits(TBits(Key) ^ SignBit);
+            }
+            else
+            {
+                return TBits(Key);
+            }
+        }
+    }
+
+    template<typename T, typename TProjection>
+    static void RadixSort(T* Begin, T* End, TProjection& Projection) noexcept
+    {
+        static_assert(std::is_trivially_copyable<T>(), "RadixSort copies the elements with memcpy and requires trivially copyable types");
+
+        typedef decltype(GetRadixKey(Projection(*Begin))) TBits;
+        constexpr UInt32 NumPasses = sizeof(TBits);
+
+        const UInt64 Size = UInt64(End - Begin);
+        if (Size < InsertionSortThreshold)
+        {
+            auto Less = [&Projection](const T& Lhs, const T& Rhs)
+            {
+                return GetRadixKey(Projection(Lhs)) < GetRadixKey(Projection(Rhs));
+            };
+
+            InsertionSort(Begin, End, Less);
+            return;
+        }
+
+        // Count all digits in a single pass
+        UInt64 Counts[NumPasses][256];
+        ::memset(Counts, 0, sizeof(Counts));
+        for (T* It = Begin; It != End; It++)
+        {
+            const TBits Key = GetRadixKey(Projection(*It));
+            for (UInt32 Pass = 0; Pass < NumPasses; Pass++)
+            {
+                Counts[Pass][(Key >> (Pass * 8)) & 0xff]++;
+            }
+        }
+
+        T* Scratch = reinterpret_cast<T*>(Mallocator().Allocate(Size * sizeof(T), alignof(T)));
+        VALIDATE(Scratch != nullptr);
+
+        T* Source      = Begin;
+        T* Destination = Scratch;
+        for (UInt32 Pass = 0; Pass < NumPasses; Pass++)
+        {
+            UInt64* PassCounts = Counts[Pass];
+
+            // All keys have the same digit, the pass would not move anything
+            const UInt32 FirstDigit = UInt32((GetRadixKey(Projection(*Source)) >> (Pass * 8)) & 0xff);
+            if (PassCounts[FirstDigit] == Size)
+            {
+                continue;
+            }
+
+            UInt64 Offset = 0;
+            for (UInt32 Digit = 0; Digit < 256; Digit++)
+            {
+                const UInt64 Count = PassCounts[Digit];
+                PassCounts[Digit] = Offset;
+                Offset += Count;
+            }
+
+            for (UInt64 Index = 0; Index < Size; Index++)
+            {
+                const UInt32 Digit = UInt32((GetRadixKey(Projection(Source[Index])) >> (Pass * 8)) & 0xff);
+                ::memcpy(reinterpret_cast<void*>(Destination + PassCounts[Digit]++), reinterpret_cast<const void*>(Source + Index), sizeof(T));
+            }
+
+            T* Temp     = Source;
+            Source      = Destination;
+            Destination = Temp;
+        }
+
+        if (Source != Begin)
+        {
+            ::memcpy(reinterpret_cast<void*>(Begin), reinterpret_cast<const void*>(Source), Size * sizeof(T));
+        }
+
+        Mallocator().Free(reinterpret_cast<void*>(Scratch), alignof(T));
+    }
+
+    /*
+     * Parallel sort
+     */
+
+    // Merges two sorted runs into uninitialized memory, the elements are relocated so the runs are left uninitialized
+    template<typename T, typename TLess>
+    static void RelocatingMerge(T* First, T* FirstEnd, T* Second, T* SecondEnd, T* Destination, TLess& Less) noexcept
+    {
+        auto Relocate = [](T*& Source, T*& Dest)
+        {
+            new(reinterpret_cast<void*>(Dest)) T(::Move(*Source));
+            Source->~T();
+            Source++;
+            Dest++;
+        };
+
+        while (First != FirstEnd && Second != SecondEnd)
+        {
+            if (Less(*Second, *First))
+            {
+                Relocate(Second, Destination);
+            }
+            else
+            {
+                Relocate(First, Destination);
+            }
+        }
+
+        while (First != FirstEnd)
+        {
+            Relocate(First, Destination);
+        }
+
+        while (Second != SecondEnd)
+        {
+            Relocate(Second, Destination);
+        }
+    }
+
+    template<typename T, typename TLess>
+    static void ParallelSort(T* Begin, T* End, TLess& Less, UInt32 NumThreads) noexcept
+    {
+        const UInt64 Size = UInt64(End - Begin);
+        if (NumThreads == 0)
+        {
+            NumThreads = std::thread::hardware_concurrency();
+        }
+
+        if (Size < ParallelThreshold || NumThreads < 2)
+        {
+            Sort(Begin, End, Less);
+            return;
+        }
+
+        // Sort one run per thread
+        TArray<UInt64> Bounds;
+        Bounds.Reserve(NumThreads + 1);
+        for (UInt32 Index = 0; Index <= NumThreads; Index++)
+        {
+            Bounds.PushBack((Size * Index) / NumThreads);
+        }
+
+        {
+            TArray<std::thread> Threads;
+            Threads.Reserve(NumThreads - 1);
+            for (UInt32 Index = 1; Index < NumThreads; Index++)
+            {
+                Threads.EmplaceBack([Begin, &Bounds, &Less, Index]()
+                {
+                    TLess ThreadLess(Less);
+                    Sort(Begin + Bounds[Index], Begin + Bounds[Index + 1], ThreadLess);
+                });
+            }
+
+            Sort(Begin + Bounds[0], Begin + Bounds[1], Less);
+            for (std::thread& Thread : Threads)
+            {
+                Thread.join();
+            }
+        }
+
+        // Merge pairs of runs in parallel, back and forth between the array and the scratch buffer
+        T* Scratch = reinterpret_cast<T*>(Mallocator().Allocate(Size * sizeof(T), alignof(T)));
+        VALIDATE(Scratch != nullptr);
+
+        T* Source      = Begin;
+        T* Destination = Scratch;
+        while (Bounds.Size() > 2)
+        {
+            TArray<UInt64>      NewBounds;
+            TArray<std::thread> Threads;
+            for (UInt32 Index = 0; Index + 1 < Bounds.Size(); Index += 2)
+            {
+                const UInt64 First  = Bounds[Index];
+                const UInt64 Middle = Bounds[Index + 1];
+                const UInt64 Last   = (Index + 2 < Bounds.Size()) ? Bounds[Index + 2] : Middle;
+                NewBounds.PushBack(First);
+
+                Threads.EmplaceBack([Source, Destination, First, Middle, Last, &Less]()
+                {
+                    TLess ThreadLess(Less);
+                    RelocatingMerge(Source + First, Source + Middle, Source + Middle, Source + Last, Destination + First, ThreadLess);
+                });
+            }
+
+            NewBounds.PushBack(Size);
+            for (std::thread& Thread : Threads)
+            {
+                Thread.join();
+            }
+
+            Bounds = ::Move(NewBounds);
+
+            T* Temp     = Source;
+            Source      = Destination;
+            Destination = Temp;
+        }
+
+        if (Source != Begin)
+        {
+            RelocatingMerge(Source, Source + Size, Source + Size, Source + Size, Begin, Less);
+        }
+
+        Mallocator().Free(reinterpret_cast<void*>(Scratch), alignof(T));
+    }
+};
+
+/*
+ * Sort - Unstable introsort, O(n log n) in the worst case and close to O(n) for sorted or reversed input
+ */
+
+template<typename T, typename TSizeType, typename TLess = LessThan>
+inline void Sort(TArrayView<T, TSizeType> View, TLess Less = TLess()) noexcept
+{
+    _SortImpl::Sort(View.Data(), View.Data() + View.Size(), Less);
+}
+
+template<typename T, typename TSizeType, typename TProjection>
+inline void SortBy(TArrayView<T, TSizeType> View, TProjection Projection) noexcept
+{
+    auto Less = [&Projection](const T& Lhs, const T& Rhs)
+    {
+        return Projection(Lhs) < Projection(Rhs);
+    };
+
+    _SortImpl::Sort(View.Data(), View.Data() + View.Size(), Less);
+}
+
+/*
+ * RadixSort - Stable LSD radix sort on the bytes of an integer or floating point key, the elements must be trivially
+ * copyable. Passes where all keys have the same byte are skipped, so small keys in wide types are cheap.
+ */
+
+template<typename T, typename TSizeType>
+inline void RadixSort(TArrayView<T, TSizeType> View) noexcept
+{
+    auto Projection = [](const T& Element)
+    {
+        return Element;
+    };
+
+    _SortImpl::RadixSort(View.Data(), View.Data() + View.Size(), Projection);
+}
+
+template<typename T, typename TSizeType, typename TProjection>
+inline void RadixSortBy(TArrayView<T, TSizeType> View, TProjection Projection) noexcept
+{
+    _SortImpl::RadixSort(View.Data(), View.Data() + View.Size(), Projection);
+}
+
+/*
+ * ParallelSort - Sorts one chunk per thread and merges the chunks in parallel, NumThreads defaults to the number of
+ * hardware threads. Arrays smaller than 64K elements are sorted on the calling thread.
+ */
+
+template<typename T, typename TSizeType, typename TLess = LessThan>
+inline void ParallelSort(TArrayView<T, TSizeType> View, TLess Less = TLess(), UInt32 NumThreads = 0) noexcept
+{
+    _SortImpl::ParallelSort(View.Data(), View.Data() + View.Size(), Less, NumThreads);
+}
+
+template<typename T, typename TSizeType, typename TProjection>
+inline void ParallelSortBy(TArrayView<T, TSizeType> View, TProjection Projection, UInt32 NumThreads = 0) noexcept
+{
+    auto Less = [Projection](const T& Lhs, const T& Rhs)
+    {
+        return Projection(Lhs) < Projection(Rhs);
+    };
+
+    _SortImpl::ParallelSort(View.Data(), View.Data() + View.Size(), Less, NumThreads);
+}
+
+template<typename T, typename TSizeType, typename TLess = LessThan>
+inline Bool IsSorted(TArrayView<T, TSizeType> View, TLess Less = TLess()) noexcept
+{
+    for (TSizeType Index = 1; Index < View.Size(); Index++)
+    {
+        if (Less(View[Index], View[Index - 1]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * TArray overloads
+ */
+
+template<typename T, typename TAllocator, typename TGrowthPolicy, typename... TArgs>
+inline void Sort(TArray<T, TAllocator, TGrowthPolicy>& Array, TArgs&&... Args) noexcept
+{
+    Sort(TArrayView<T, typename TArray<T, TAllocator, TGrowthPolicy>::SizeType>(Array), ::Forward<TArgs>(Args)...);
+}
+
+template<typename T, typename TAllocator, typename TGrowthPolicy, typename TProjection>
+inline void SortBy(TArray<T, TAllocator, TGrowthPolicy>& Array, TProjection Projection) noexcept
+{
+    SortBy(TArrayView<T, typename TArray<T, TAllocator, TGrowthPolicy>::SizeType>(Array), Projection);
+}
+
+template<typename T, typename TAllocator, typename TGrowthPolicy>
+inline void RadixSort(TArray<T, TAllocator, TGrowthPolicy>& Array) noexcept
+{
+    RadixSort(TArrayView<T, typename TArray<T, TAllocator, TGrowthPolicy>::SizeType>(Array));
+}
+
+template<typename T, typename TAllocator, typename TGrowthPolicy, typename TProjection>
+inline void RadixSortBy(TArray<T, TAllocator, TGrowthPolicy>& Array, TProjection Projection) noexcept
+{
+    RadixSortBy(TArrayView<T, typename TArray<T, TAllocator, TGrowthPolicy>::SizeType>(Array), Projection);
+}
+
+template<typename T, typename TAllocator, typename TGrowthPolicy, typename... TArgs>
+inline void ParallelSort(TArray<T, TAllocator, TGrowthPolicy>& Array, TArgs&&... Args) noexcept
+{
+    ParallelSort(TArrayView<T, typename TArray<T, TAllocator, TGrowthPolicy>::SizeType>(Array), ::Forward<TArgs>(Args)...);
+}
+
+template<typename T, typename TAllocator, typename TGrowthPolicy, typename TProjection>
+inline void ParallelSortBy(TArray<T, TAllocator, TGrowthPolicy>& Array, TProjection Projection, UInt32 NumThreads = 0) noexcept
+{
+    ParallelSortBy(TArrayView<T, typename TArray<T, TAllocator, TGrowthPolicy>::SizeType>(Array), Projection, NumThreads);
+}
+
+template<typename T, typename TAllocator, typename TGrowthPolicy, typename... TArgs>
+inline Bool IsSorted(const TArray<T, TAllocator, TGrowthPolicy>& Array, TArgs&&... Args) noexcept
+{
+    return IsSorted(TArrayView<const T, typename TArray<T, TAllocator, TGrowthPolicy>::SizeType>(Array), ::Forward<TArgs>(Args)...);
+}
@@ -49,7 +49,7 @@ public:
     
     constexpr SizeType LastIndex() const noexcept { return N > 0 ? N - 1 : 0; }
     constexpr SizeType Size() const noexcept { return N; }
-    constexpr SizeType SizeInBytes() const noexcept { return N * sizeof(T); }
+    constexpr UInt64 SizeInBytes() const noexcept { return UInt64(N) * sizeof(T); }
         
     T* Data() noexcept { return Elements; }
     const T* Data() const noexcept { return Elements; }
@@ -80,3 +80,11 @@ public:
 public:
     T Elements[N];
 };
+
+// TStaticArray is relocatable when the elements are
+
+template<typename T, Int32 N>
+struct _TIsTriviallyRelocatable<TStaticArray<T, N>>
+{
+    static constexpr Bool Value = TIsTriviallyRelocatable<T>;
+};
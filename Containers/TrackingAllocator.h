@@ -0,0 +1,486 @@
+#pragma once
+#include "Utilities.h"
+#include "Allocator.h"
+
+#include <atomic>
+#include <cstdio>
+#include <typeinfo>
+
+/*
+ * Memory tracking - When enabled, the allocations of control blocks and functors are tracked with
+ * TTrackingAllocator. Containers are tracked by using TTrackingAllocator as their allocator.
+ */
+
+#ifndef ENABLE_MEMORY_TRACKING
+    #define ENABLE_MEMORY_TRACKING 0
+#endif
+
+// Declares a tag with a readable name for TTrackingAllocator
+#define DECLARE_MEMORY_TAG(TagName) struct TagName { static constexpr const Char* Name = #TagName; }
+
+/*
+ * MemoryStats - Snapshot of the counters of one tag, which is only exact when no other thread uses the tag
+ */
+
+struct MemoryStats
+{
+    UInt64 NumAllocations   = 0;
+    UInt64 NumReallocations = 0;
+    UInt64 NumFrees         = 0;
+    UInt64 TotalBytes       = 0;
+    UInt64 CurrentBytes     = 0;
+    UInt64 PeakBytes        = 0;
+};
+
+/*
+ * MemoryCounters - The counters of one thread for one tag. Only the owning thread writes them, with a load and a store
+ * instead of an atomic add, and every thread has its own cache line. The current bytes are added to the counter of
+ * the tag in batches, so the peak is exact for a single thread and off by at most a batch per thread otherwise.
+ */
+
+struct alignas(64) MemoryCounters
+{
+    static constexpr Int64 BatchBytes = 64 * 1024;
+
+    MemoryCounters(std::atomic<Int64>& InTagBytes) noexcept
+        : NumAllocations(0)
+        , NumReallocations(0)
+        , NumFrees(0)
+        , TotalBytes(0)
+        , PendingBytes(0)
+        , PeakBytes(0)
+        , IsOwned(true)
+        , Next(nullptr)
+        , mTagBytes(InTagBytes)
+        , mLastTagBytes(0)
+        , mLastBlock(nullptr)
+        , mLastBlockSize(0)
+    {
+    }
+
+    template<typename T>
+    static void Add(std::atomic<T>& Counter, T Value) noexcept
+    {
+        Counter.store(Counter.load(std::memory_order_relaxed) + Value, std::memory_order_relaxed);
+    }
+
+    // NumBytes is negative when blocks are freed
+    void AddBytes(Int64 NumBytes) noexcept
+    {
+        const Int64 NewPendingBytes = PendingBytes.load(std::memory_order_relaxed) + NumBytes;
+        PendingBytes.store(NewPendingBytes, std::memory_order_relaxed);
+
+        if ((NewPendingBytes > BatchBytes) || (NewPendingBytes < -BatchBytes))
+        {
+            Flush();
+        }
+        else if ((NumBytes > 0) && (mLastTagBytes + NewPendingBytes > PeakBytes.load(std::memory_order_relaxed)))
+        {
+            PeakBytes.store(mLastTagBytes + NewPendingBytes, std::memory_order_relaxed);
+        }
+    }
+
+    void Flush() noexcept
+    {
+        const Int64 Bytes = PendingBytes.load(std::memory_order_relaxed);
+        mLastTagBytes = mTagBytes.fetch_add(Bytes, std::memory_order_relaxed) + Bytes;
+        PendingBytes.store(0, std::memory_order_relaxed);
+
+        if (mLastTagBytes > PeakBytes.load(std::memory_order_relaxed))
+        {
+            PeakBytes.store(mLastTagBytes, std::memory_order_relaxed);
+        }
+    }
+
+    // Containers ask for the usable size right after an allocation, so the size of the last block is kept until the next call
+    void SetLastBlock(const void* Ptr, UInt64 Size) noexcept
+    {
+        mLastBlock     = Ptr;
+        mLastBlockSize = Size;
+    }
+
+    Bool TakeLastBlockSize(const void* Ptr, UInt64& OutSize) noexcept
+    {
+        const Bool IsLastBlock = (Ptr == mLastBlock);
+        OutSize    = mLastBlockSize;
+        mLastBlock = nullptr;
+        return IsLastBlock;
+    }
+
+    std::atomic<UInt64> NumAllocations;
+    std::atomic<UInt64> NumReallocations;
+    std::atomic<UInt64> NumFrees;
+    std::atomic<UInt64> TotalBytes;
+    std::atomic<Int64>  PendingBytes;
+    std::atomic<Int64>  PeakBytes;
+    std::atomic<Bool>   IsOwned;
+    MemoryCounters*     Next;
+
+private:
+    std::atomic<Int64>& mTagBytes;
+    Int64               mLastTagBytes;
+    const void*         mLastBlock;
+    UInt64              mLastBlockSize;
+};
+
+/*
+ * MemoryTag - Named entry in the MemoryTracker, which owns the counters of every thread that has used the tag. The
+ * counters are never freed, when a thread exits they are handed to the next thread that uses the tag.
+ */
+
+struct MemoryTag
+{
+    MemoryTag(const Char* InName) noexcept
+        : Name(InName)
+        , Next(nullptr)
+        , mCounters(nullptr)
+        , mCurrentBytes(0)
+    {
+    }
+
+    MemoryCounters* AcquireCounters() noexcept
+    {
+        for (MemoryCounters* Counters = mCounters.load(std::memory_order_acquire); Counters; Counters = Counters->Next)
+        {
+            Bool IsOwned = false;
+            if (!Counters->IsOwned.load(std::memory_order_relaxed) && Counters->IsOwned.compare_exchange_strong(IsOwned, true, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                return Counters;
+            }
+        }
+
+        MemoryCounters* NewCounters = new MemoryCounters(mCurrentBytes);
+
+        MemoryCounters* Head = mCounters.load(std::memory_order_relaxed);
+        do
+        {
+            NewCounters->Next = Head;
+        } while (!mCounters.compare_exchange_weak(Head, NewCounters, std::memory_order_release, std::memory_order_relaxed));
+
+        return NewCounters;
+    }
+
+    void ReleaseCounters(MemoryCounters* Counters) noexcept
+    {
+        Counters->SetLastBlock(nullptr, 0);
+        Counters->Flush();
+        Counters->IsOwned.store(false, std::memory_order_release);
+    }
+
+    MemoryStats GetStats() const noexcept
+    {
+        MemoryStats Stats;
+
+        Int64 CurrentBytes = mCurrentBytes.load(std::memory_order_relaxed);
+        Int64 PeakBytes    = 0;
+        for (const MemoryCounters* Counters = mCounters.load(std::memory_order_acquire); Counters; Counters = Counters->Next)
+        {
+            Stats.NumAllocations   += Counters->NumAllocations.load(std::memory_order_relaxed);
+            Stats.NumReallocations += Counters->NumReallocations.load(std::memory_order_relaxed);
+            Stats.NumFrees         += Counters->NumFrees.load(std::memory_order_relaxed);
+            Stats.TotalBytes       += Counters->TotalBytes.load(std::memory_order_relaxed);
+            CurrentBytes           += Counters->PendingBytes.load(std::memory_order_relaxed);
+
+            const Int64 ThreadPeakBytes = Counters->PeakBytes.load(std::memory_order_relaxed);
+            PeakBytes = (ThreadPeakBytes > PeakBytes) ? ThreadPeakBytes : PeakBytes;
+        }
+
+        PeakBytes = (CurrentBytes > PeakBytes) ? CurrentBytes : PeakBytes;
+        Stats.CurrentBytes = (CurrentBytes > 0) ? UInt64(CurrentBytes) : 0;
+        Stats.PeakBytes    = UInt64(PeakBytes);
+        return Stats;
+    }
+
+    const Char* Name;
+    MemoryTag*  Next;
+
+private:
+    std::atomic<MemoryCounters*> mCounters;
+    std::atomic<Int64>           mCurrentBytes;
+};
+
+/*
+ * MemoryTracker - Process-wide registry of all tags that have been used
+ */
+
+class MemoryTracker
+{
+public:
+    static MemoryTracker& Get() noexcept
+    {
+        static MemoryTracker Tracker;
+        return Tracker;
+    }
+
+    void Register(MemoryTag* Tag) noexcept
+    {
+        MemoryTag* Head = mHead.load(std::memory_order_relaxed);
+        do
+        {
+            Tag->Next = Head;
+        } while (!mHead.compare_exchange_weak(Head, Tag, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    template<typename TFunc>
+    void ForEach(TFunc&& Func) const noexcept
+    {
+        for (const MemoryTag* Tag = mHead.load(std::memory_order_acquire); Tag; Tag = Tag->Next)
+        {
+            Func(*Tag);
+        }
+    }
+
+    void Dump(FILE* File = stdout) const noexcept
+    {
+        std::fprintf(File, "%-32s %14s %14s %14s %14s %14s %14s\n", "Tag", "Allocations", "Reallocations", "Frees", "Current", "Peak", "Total");
+        ForEach([File](const MemoryTag& Tag)
+        {
+            const MemoryStats Stats = Tag.GetStats();
+            std::fprintf(File, "%-32s %14llu %14llu %14llu %14llu %14llu %14llu\n", Tag.Name,
+                static_cast<unsigned long long>(Stats.NumAllocations),
+                static_cast<unsigned long long>(Stats.NumReallocations),
+                static_cast<unsigned long long>(Stats.NumFrees),
+                static_cast<unsigned long long>(Stats.CurrentBytes),
+                static_cast<unsigned long long>(Stats.PeakBytes),
+                static_cast<unsigned long long>(Stats.TotalBytes));
+        });
+    }
+
+private:
+    MemoryTracker() noexcept
+        : mHead(nullptr)
+    {
+    }
+
+    std::atomic<MemoryTag*> mHead;
+};
+
+/*
+ * TGetMemoryTag - The tag for a type, which is registered the first time it is used. Types that declare a Name are
+ * listed by that name, other types, such as the element type of a container, by their type name.
+ */
+
+template<typename TTag, typename = void>
+struct _TMemoryTagName
+{
+    static const Char* Get() noexcept { return typeid(TTag).name(); }
+};
+
+template<typename TTag>
+struct _TMemoryTagName<TTag, std::void_t<decltype(TTag::Name)>>
+{
+    static const Char* Get() noexcept { return TTag::Name; }
+};
+
+template<typename TTag>
+inline MemoryTag& TGetMemoryTag() noexcept
+{
+    static MemoryTag* Tag = []()
+    {
+        // Never destroyed, so that the tag can be used by static objects during shutdown
+        MemoryTag* NewTag = new MemoryTag(_TMemoryTagName<TTag>::Get());
+        MemoryTracker::Get().Register(NewTag);
+        return NewTag;
+    }();
+
+    return *Tag;
+}
+
+/*
+ * TMemoryThreadCounters - The counters of the calling thread for TTag, which are given back to the tag when the
+ * thread exits. Threads that allocate after that, such as during shutdown, borrow counters for every call.
+ */
+
+template<typename TTag>
+class TMemoryThreadCounters
+{
+public:
+    // Returns nullptr once the counters of the calling thread have been given back
+    static MemoryCounters* Get() noexcept
+    {
+        if (IsDestroyed())
+        {
+            return nullptr;
+        }
+
+        static thread_local TMemoryThreadCounters Counters;
+        return Counters.mCounters;
+    }
+
+    template<typename TFunc>
+    static void Update(TFunc&& Func) noexcept
+    {
+        if (MemoryCounters* Counters = Get())
+        {
+            Func(*Counters);
+            return;
+        }
+
+        MemoryTag&      Tag      = TGetMemoryTag<TTag>();
+        MemoryCounters* Borrowed = Tag.AcquireCounters();
+        Func(*Borrowed);
+        Tag.ReleaseCounters(Borrowed);
+    }
+
+    TMemoryThreadCounters(const TMemoryThreadCounters&) = delete;
+    TMemoryThreadCounters& operator=(const TMemoryThreadCounters&) = delete;
+
+    ~TMemoryThreadCounters()
+    {
+        TGetMemoryTag<TTag>().ReleaseCounters(mCounters);
+        IsDestroyed() = true;
+    }
+
+private:
+    TMemoryThreadCounters() noexcept
+        : mCounters(TGetMemoryTag<TTag>().AcquireCounters())
+    {
+    }
+
+    static Bool& IsDestroyed() noexcept
+    {
+        static thread_local Bool Destroyed = false;
+        return Destroyed;
+    }
+
+    MemoryCounters* mCounters;
+};
+
+/*
+ * TTrackingAllocator - Wraps another allocator and records its allocations under TTag. Allocators with the unsized
+ * Free need GetUsableSize to know how many bytes are freed, and blocks in inline storage are not counted.
+ */
+
+template<typename TInner, typename TTag>
+struct TTrackingAllocator : public TInner
+{
+    TTrackingAllocator() noexcept = default;
+
+    TTrackingAllocator(const TInner& Inner) noexcept
+        : TInner(Inner)
+    {
+    }
+
+    void* Allocate(UInt64 Size, UInt64 Alignment)
+    {
+        void* Ptr = TInner::Allocate(Size, Alignment);
+        if (Ptr && !IsInlineBlock(Ptr))
+        {
+            const UInt64 TrackedSize = GetTrackedSize(Ptr, Size, Alignment);
+            TMemoryThreadCounters<TTag>::Update([Ptr, TrackedSize](MemoryCounters& Counters)
+            {
+                MemoryCounters::Add(Counters.NumAllocations, UInt64(1));
+                MemoryCounters::Add(Counters.TotalBytes, TrackedSize);
+                Counters.AddBytes(Int64(TrackedSize));
+                Counters.SetLastBlock(Ptr, TrackedSize);
+            });
+        }
+
+        return Ptr;
+    }
+
+    template<typename TBase = TInner, typename = std::void_t<decltype(std::declval<TBase&>().Reallocate(nullptr, 0, 0))>>
+    void* Reallocate(void* Ptr, UInt64 Size, UInt64 Alignment)
+    {
+        // Reallocating a null pointer is the first allocation of a block
+        const Bool   IsFirstAllocation = (Ptr == nullptr);
+        const UInt64 OldSize           = IsFirstAllocation ? 0 : GetUsableSize(Ptr, Alignment);
+
+        void* NewPtr = TBase::Reallocate(Ptr, Size, Alignment);
+        if (NewPtr)
+        {
+            const UInt64 NewSize = TBase::GetUsableSize(NewPtr, Alignment);
+            TMemoryThreadCounters<TTag>::Update([IsFirstAllocation, NewPtr, OldSize, NewSize](MemoryCounters& Counters)
+            {
+                MemoryCounters::Add(IsFirstAllocation ? Counters.NumAllocations : Counters.NumReallocations, UInt64(1));
+                MemoryCounters::Add(Counters.TotalBytes, NewSize);
+                Counters.AddBytes(Int64(NewSize) - Int64(OldSize));
+                Counters.SetLastBlock(NewPtr, NewSize);
+            });
+        }
+
+        return NewPtr;
+    }
+
+    // The size of a block that was just allocated on this thread is reused instead of asking the inner allocator again
+    template<typename TBase = TInner, typename = std::void_t<decltype(std::declval<const TBase&>().GetUsableSize(nullptr, 0))>>
+    UInt64 GetUsableSize(void* Ptr, UInt64 Alignment) const
+    {
+        UInt64 Size = 0;
+        MemoryCounters* Counters = TMemoryThreadCounters<TTag>::Get();
+        if (Counters && Counters->TakeLastBlockSize(Ptr, Size))
+        {
+            return Size;
+        }
+
+        return TBase::GetUsableSize(Ptr, Alignment);
+    }
+
+    template<typename TBase = TInner, typename = std::void_t<decltype(std::declval<TBase&>().Free(nullptr, 0))>>
+    void Free(void* Ptr, UInt64 Alignment)
+    {
+        static_assert(THasGetUsableSize<TBase>, "TTrackingAllocator needs GetUsableSize to track allocators with an unsized Free");
+
+        if (Ptr && !IsInlineBlock(Ptr))
+        {
+            const UInt64 Size = GetUsableSize(Ptr, Alignment);
+            TMemoryThreadCounters<TTag>::Update([Size](MemoryCounters& Counters)
+            {
+                MemoryCounters::Add(Counters.NumFrees, UInt64(1));
+                Counters.AddBytes(-Int64(Size));
+            });
+        }
+
+        TBase::Free(Ptr, Alignment);
+    }
+
+    template<typename TBase = TInner, typename = std::void_t<decltype(std::declval<TBase&>().Free(nullptr, 0, 0))>>
+    void Free(void* Ptr, UInt64 Size, UInt64 Alignment)
+    {
+        if (Ptr)
+        {
+            TMemoryThreadCounters<TTag>::Update([Size](MemoryCounters& Counters)
+            {
+                MemoryCounters::Add(Counters.NumFrees, UInt64(1));
+                Counters.AddBytes(-Int64(Size));
+            });
+        }
+
+        TBase::Free(Ptr, Size, Alignment);
+    }
+
+    static MemoryStats GetStats() noexcept
+    {
+        return TGetMemoryTag<TTag>().GetStats();
+    }
+
+private:
+    Bool IsInlineBlock(const void* Ptr) const noexcept
+    {
+        if constexpr (THasInlineStorage<TInner>)
+        {
+            return TInner::IsInlineAllocation(Ptr);
+        }
+        else
+        {
+            UNREFERENCED_VARIABLE(Ptr);
+            return false;
+        }
+    }
+
+    // Blocks are tracked with their usable size when it is known, so that the sizes match when they are freed
+    UInt64 GetTrackedSize(void* Ptr, UInt64 Size, UInt64 Alignment) const noexcept
+    {
+        if constexpr (THasGetUsableSize<TInner>)
+        {
+            UNREFERENCED_VARIABLE(Size);
+            return TInner::GetUsableSize(Ptr, Alignment);
+        }
+        else
+        {
+            UNREFERENCED_VARIABLE(Ptr);
+            UNREFERENCED_VARIABLE(Alignment);
+            return Size;
+        }
+    }
+};
@@ -122,7 +122,7 @@ public:
     Bool operator!=(const TUniquePtr& Other) const noexcept { return !(*this == Other); }
 
     Bool operator==(T* InPtr) const noexcept { return (mPtr == InPtr); }
-    Bool operator!=(T* InPtr) const noexcept { return !(*this == Other); }
+    Bool operator!=(T* InPtr) const noexcept { return !(*this == InPtr); }
 
     operator Bool() const noexcept { return (mPtr != nullptr); }
 
@@ -264,7 +264,7 @@ public:
     Bool operator!=(const TUniquePtr& Other) const noexcept { return !(*this == Other); }
 
     Bool operator==(T* InPtr) const noexcept { return (mPtr == InPtr); }
-    Bool operator!=(T* InPtr) const noexcept { return !(*this == Other); }
+    Bool operator!=(T* InPtr) const noexcept { return !(*this == InPtr); }
 
     operator Bool() const noexcept { return (mPtr != nullptr); }
 
@@ -273,7 +273,7 @@ private:
     {
         if (mPtr)
         {
-            delete mPtr;
+            delete[] mPtr;
             mPtr = nullptr;
         }
     }
@@ -298,3 +298,11 @@ TEnableIf<TIsArray<T>, TUniquePtr<T>>MakeUnique(UInt32 Size) noexcept
     TType* UniquePtr = new TType[Size];
     return ::Move(TUniquePtr<T>(UniquePtr));
 }
+
+// TUniquePtr only stores the pointer, which does not change when the TUniquePtr is moved
+
+template<typename T>
+struct _TIsTriviallyRelocatable<TUniquePtr<T>>
+{
+    static constexpr Bool Value = true;
+};
@@ -195,4 +195,19 @@ struct _TIsArray<T[N]>
 };
 
 template<typename T>
-inline constexpr Bool TIsArray = _TIsArray<T>::Value;
\ No newline at end of file
+inline constexpr Bool TIsArray = _TIsArray<T>::Value;
+
+/*
+ * TIsTriviallyRelocatable - Types that can be moved to a new address with memcpy, without calling the
+ * move-constructor on the new object and the destructor on the old. Specialize _TIsTriviallyRelocatable
+ * to opt in types that have non-trivial constructors but no pointers into themselves.
+ */
+
+template<typename T>
+struct _TIsTriviallyRelocatable
+{
+    static constexpr Bool Value = std::is_trivially_move_constructible<T>() && std::is_trivially_destructible<T>();
+};
+
+template<typename T>
+inline constexpr Bool TIsTriviallyRelocatable = _TIsTriviallyRelocatable<T>::Value;
\ No newline at end of file
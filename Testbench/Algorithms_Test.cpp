@@ -0,0 +1,361 @@
+#include "Algorithms_Test.h"
+
+#include "Clock.h"
+#include "Random.h"
+
+#include "../Containers/Algorithms.h"
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <string>
+
+static const Char* GetLevelName(ESimdLevel Level)
+{
+    switch (Level)
+    {
+        case ESimdLevel::AVX512: return "AVX512";
+        case ESimdLevel::AVX2:   return "AVX2  ";
+        case ESimdLevel::SSE2:   return "SSE2  ";
+        default:                 return "Scalar";
+    }
+}
+
+/*
+ * Benchmark
+ */
+
+template<typename TFunction>
+static void AlgorithmBenchmark(const std::string& Name, UInt32 TestCount, UInt32 RepeatCount, TFunction&& Function)
+{
+    Clock Clock;
+    Double Result = 0.0;
+    for (UInt32 i = 0; i < TestCount; i++)
+    {
+        ScopedClock ScopedClock(Clock);
+        for (UInt32 j = 0; j < RepeatCount; j++)
+        {
+            Result += Double(Function());
+        }
+    }
+
+    std::cout << Name << Clock.GetTotalDuration() / (Int64(TestCount) * RepeatCount) << "ns (Result=" << Result / (Double(TestCount) * RepeatCount) << ")" << std::endl;
+}
+
+// Runs the function once for every instruction set that the CPU supports
+template<typename TFunction>
+static void LevelBenchmark(const std::string& Name, UInt32 TestCount, UInt32 RepeatCount, TFunction&& Function)
+{
+    const ESimdLevel SupportedLevel = GetSupportedSimdLevel();
+    for (UInt8 Level = 0; Level <= UInt8(SupportedLevel); Level++)
+    {
+        SetSimdLevel(ESimdLevel(Level));
+        AlgorithmBenchmark(Name + " (" + GetLevelName(ESimdLevel(Level)) + "):", TestCount, RepeatCount, Function);
+    }
+
+    SetSimdLevel(SupportedLevel);
+}
+
+template<typename T>
+static void SearchBenchmark(const TArray<T>& Elements, UInt32 TestCount, UInt32 RepeatCount)
+{
+    // The value is not in the array, so the whole array is searched
+    const T Missing = T(-1);
+
+    AlgorithmBenchmark("Loop                :", TestCount, RepeatCount, [&]()
+    {
+        UInt32 Index = 0;
+        for (; Index < Elements.Size(); Index++)
+        {
+            if (Elements[Index] == Missing)
+            {
+                break;
+            }
+        }
+
+        return Index;
+    });
+
+    AlgorithmBenchmark("std::find           :", TestCount, RepeatCount, [&]()
+    {
+        return std::find(Elements.Begin(), Elements.End(), Missing) - Elements.Begin();
+    });
+
+    LevelBenchmark("IndexOf", TestCount, RepeatCount, [&]()
+    {
+        return IndexOf(Elements, Missing);
+    });
+
+    AlgorithmBenchmark("Count Loop          :", TestCount, RepeatCount, [&]()
+    {
+        UInt32 Count = 0;
+        for (T Element : Elements)
+        {
+            Count += (Element == T(1)) ? 1 : 0;
+        }
+
+        return Count;
+    });
+
+    AlgorithmBenchmark("std::count          :", TestCount, RepeatCount, [&]()
+    {
+        return std::count(Elements.Begin(), Elements.End(), T(1));
+    });
+
+    LevelBenchmark("Count  ", TestCount, RepeatCount, [&]()
+    {
+        return Count(Elements, T(1));
+    });
+}
+
+template<typename T>
+static void ReductionBenchmark(const TArray<T>& Elements, UInt32 TestCount, UInt32 RepeatCount)
+{
+    AlgorithmBenchmark("Min Loop            :", TestCount, RepeatCount, [&]()
+    {
+        T Result = Elements[0];
+        for (T Element : Elements)
+        {
+            Result = (Element < Result) ? Element : Result;
+        }
+
+        return Result;
+    });
+
+    AlgorithmBenchmark("std::min_element    :", TestCount, RepeatCount, [&]()
+    {
+        return *std::min_element(Elements.Begin(), Elements.End());
+    });
+
+    LevelBenchmark("Min    ", TestCount, RepeatCount, [&]()
+    {
+        return Min(Elements);
+    });
+
+    AlgorithmBenchmark("ArgMin Loop         :", TestCount, RepeatCount, [&]()
+    {
+        UInt32 Result = 0;
+        for (UInt32 Index = 1; Index < Elements.Size(); Index++)
+        {
+            Result = (Elements[Index] < Elements[Result]) ? Index : Result;
+        }
+
+        return Result;
+    });
+
+    LevelBenchmark("ArgMin ", TestCount, RepeatCount, [&]()
+    {
+        return ArgMin(Elements);
+    });
+
+    AlgorithmBenchmark("Sum Loop            :", TestCount, RepeatCount, [&]()
+    {
+        T Result = T(0);
+        for (T Element : Elements)
+        {
+            Result += Element;
+        }
+
+        return Result;
+    });
+
+    AlgorithmBenchmark("std::accumulate     :", TestCount, RepeatCount, [&]()
+    {
+        return std::accumulate(Elements.Begin(), Elements.End(), T(0));
+    });
+
+    LevelBenchmark("Sum    ", TestCount, RepeatCount, [&]()
+    {
+        return Sum(Elements);
+    });
+
+    AlgorithmBenchmark("Dot Loop            :", TestCount, RepeatCount, [&]()
+    {
+        T Result = T(0);
+        for (UInt32 Index = 0; Index < Elements.Size(); Index++)
+        {
+            Result += Elements[Index] * Elements[Index];
+        }
+
+        return Result;
+    });
+
+    AlgorithmBenchmark("std::inner_product  :", TestCount, RepeatCount, [&]()
+    {
+        return std::inner_product(Elements.Begin(), Elements.End(), Elements.Begin(), T(0));
+    });
+
+    LevelBenchmark("Dot    ", TestCount, RepeatCount, [&]()
+    {
+        return Dot(Elements, Elements);
+    });
+}
+
+void Algorithms_Benchmark()
+{
+    std::cout << std::endl << "Benchmark (Algorithms, SupportedLevel=" << GetLevelName(GetSupportedSimdLevel()) << ")" << std::endl;
+
+    UInt64 State = 0x9E3779B97F4A7C15ull;
+
+    // Large arrays are limited by the memory bandwidth and small arrays by the instructions
+    const UInt32 Sizes[]        = { 16 * 1024 * 1024, 16 * 1024 };
+    const UInt32 RepeatCounts[] = { 1, 1000 };
+    const UInt32 TestCount      = 10;
+
+    for (UInt32 i = 0; i < 2; i++)
+    {
+        const UInt32 NumElements = Sizes[i];
+
+#if 1
+        // Int32
+        {
+            std::cout << std::endl << "Int32 (Elements=" << NumElements << ", TestCount=" << TestCount << ", RepeatCount=" << RepeatCounts[i] << ")" << std::endl;
+
+            TArray<Int32> Elements;
+            Elements.Reserve(NumElements);
+            for (UInt32 j = 0; j < NumElements; j++)
+            {
+                Elements.PushBack(Int32(NextRandom(State) % 1000));
+            }
+
+            SearchBenchmark(Elements, TestCount, RepeatCounts[i]);
+            ReductionBenchmark(Elements, TestCount, RepeatCounts[i]);
+        }
+#endif
+
+#if 1
+        // Float
+        {
+            std::cout << std::endl << "Float (Elements=" << NumElements << ", TestCount=" << TestCount << ", RepeatCount=" << RepeatCounts[i] << ")" << std::endl;
+
+            TArray<Float> Elements;
+            Elements.Reserve(NumElements);
+            for (UInt32 j = 0; j < NumElements; j++)
+            {
+                Elements.PushBack(Float(NextRandom(State) % 2000) / 1000.0f);
+            }
+
+            ReductionBenchmark(Elements, TestCount, RepeatCounts[i]);
+        }
+#endif
+
+#if 1
+        // UInt8
+        {
+            std::cout << std::endl << "UInt8 (Elements=" << NumElements << ", TestCount=" << TestCount << ", RepeatCount=" << RepeatCounts[i] << ")" << std::endl;
+
+            TArray<UInt8> Elements;
+            Elements.Reserve(NumElements);
+            for (UInt32 j = 0; j < NumElements; j++)
+            {
+                Elements.PushBack(UInt8(NextRandom(State) % 200));
+            }
+
+            SearchBenchmark(Elements, TestCount, RepeatCounts[i]);
+        }
+#endif
+    }
+}
+
+/*
+ * Test
+ */
+
+// Compares every algorithm with a loop for sizes around the vector widths
+template<typename T>
+static Bool TestLevel(UInt64& State)
+{
+    Bool Passed = true;
+    for (UInt32 Size = 0; Size < 300; Size += (Size < 140) ? 1 : 37)
+    {
+        TArray<T> Elements;
+        for (UInt32 i = 0; i < Size; i++)
+        {
+            Elements.PushBack(std::is_floating_point<T>::value ? T(Int32(NextRandom(State) % 257) - 128) / T(8) : T(NextRandom(State)));
+        }
+
+        const T Value = (Size > 0) ? Elements[UInt32(NextRandom(State) % Size)] : T(1);
+        Passed = Passed && (IndexOf(Elements, Value) == UInt32(std::find(Elements.Begin(), Elements.End(), Value) - Elements.Begin()));
+        Passed = Passed && (Count(Elements, Value) == UInt32(std::count(Elements.Begin(), Elements.End(), Value)));
+
+        if (Size > 0)
+        {
+            Passed = Passed && (Min(Elements) == *std::min_element(Elements.Begin(), Elements.End()));
+            Passed = Passed && (Max(Elements) == *std::max_element(Elements.Begin(), Elements.End()));
+            Passed = Passed && (ArgMin(Elements) == UInt32(std::min_element(Elements.Begin(), Elements.End()) - Elements.Begin()));
+            Passed = Passed && (ArgMax(Elements) == UInt32(std::max_element(Elements.Begin(), Elements.End()) - Elements.Begin()));
+        }
+
+        // The values are small multiples of 1/8, so floating point sums are exact in any order
+        T ExpectedSum = T(0);
+        T ExpectedDot = T(0);
+        for (T Element : Elements)
+        {
+            ExpectedSum = _SimdImpl::Add(ExpectedSum, Element);
+            ExpectedDot = _SimdImpl::Add(ExpectedDot, _SimdImpl::Multiply(Element, Element));
+        }
+
+        Passed = Passed && (Sum(Elements) == ExpectedSum) && (Dot(Elements, Elements) == ExpectedDot);
+    }
+
+    return Passed;
+}
+
+void Algorithms_Test()
+{
+    std::cout << std::endl << "----------Algorithms----------" << std::endl << std::endl;
+
+    std::cout << "Testing Search" << std::endl;
+    {
+        TArray<Int32> Numbers = { 5, -3, 9, 1, 5, 0, -3, 7, 2, 8, 6, 4, 3, 1, 9, -10, 11, 12, 0, 5, 5, 5, 14, 13, 2, 1 };
+        std::cout << "IndexOf(9)=" << IndexOf(Numbers, 9) << " IndexOf(100)=" << IndexOf(Numbers, 100) << " Count(5)=" << Count(Numbers, 5) << " Contains(-10)=" << Contains(Numbers, -10) << std::endl;
+
+        // Only the part of the array in the view is searched
+        TArrayView<Int32> Part(Numbers.Data() + 3, Numbers.Data() + 10);
+        Int32* Found = Find(Part, 7);
+        if (Found)
+        {
+            *Found = 70;
+        }
+
+        std::cout << "Find(7)=" << ((Found != nullptr) ? *Found : 0) << " Numbers[7]=" << Numbers[7] << " Part.Contains(9)=" << Contains(Part, 9) << std::endl;
+
+        // Negative zero is equal to zero, NaN is not equal to anything
+        TArray<Float> Floats = { 1.0f, -0.0f, std::numeric_limits<Float>::quiet_NaN(), 2.0f };
+        std::cout << "IndexOf(0.0f)=" << IndexOf(Floats, 0.0f) << " Contains(NaN)=" << Contains(Floats, std::numeric_limits<Float>::quiet_NaN()) << std::endl;
+    }
+
+    std::cout << "Testing Reduction" << std::endl;
+    {
+        TArray<Int32> Numbers = { 5, -3, 9, 1, 5, 0, -3, 7, 2, 8, 6, 4, 3, 1, 9, -10, 11, 12, 0, 5, 5, 5, 14, 13, 2, 1 };
+        std::cout << "Min=" << Min(Numbers) << " Max=" << Max(Numbers) << " ArgMin=" << ArgMin(Numbers) << " ArgMax=" << ArgMax(Numbers) << " Sum=" << Sum(Numbers) << " Dot=" << Dot(Numbers, Numbers) << std::endl;
+
+        TArray<Double> Doubles = { 0.5, 1.5, -2.0, 4.0, 8.0, 0.25 };
+        std::cout << "Min=" << Min(Doubles) << " Max=" << Max(Doubles) << " Sum=" << Sum(Doubles) << " Dot=" << Dot(Doubles, Doubles) << std::endl;
+
+        // The result with NaNs is unspecified, but always the index of an element
+        TArray<Float> NaNs = { std::numeric_limits<Float>::quiet_NaN(), 1.0f, 2.0f };
+        std::cout << "NaN ArgMin<Size=" << (ArgMin(NaNs) < NaNs.Size()) << " ArgMax<Size=" << (ArgMax(NaNs) < NaNs.Size()) << std::endl;
+
+        // Types that are not vectorized use loops
+        TArray<std::string> Strings = { "Medium", "A", "Longest string", "Short" };
+        std::cout << "Min=" << Min(Strings) << " ArgMax=" << ArgMax(Strings) << " IndexOf(Short)=" << IndexOf(Strings, std::string("Short")) << " Sum=" << Sum(Strings) << std::endl;
+    }
+
+    std::cout << "Testing Levels" << std::endl;
+    {
+        const ESimdLevel SupportedLevel = GetSupportedSimdLevel();
+        for (UInt8 Level = 0; Level <= UInt8(SupportedLevel); Level++)
+        {
+            SetSimdLevel(ESimdLevel(Level));
+
+            UInt64 State   = 0x2545F4914F6CDD1Dull;
+            Bool   Passed  = TestLevel<Int8>(State) && TestLevel<UInt8>(State) && TestLevel<Int16>(State) && TestLevel<UInt16>(State);
+            Passed = Passed && TestLevel<Int32>(State) && TestLevel<UInt32>(State) && TestLevel<Int64>(State) && TestLevel<UInt64>(State);
+            Passed = Passed && TestLevel<Float>(State) && TestLevel<Double>(State);
+            std::cout << GetLevelName(ESimdLevel(Level)) << " Passed=" << Passed << std::endl;
+        }
+
+        SetSimdLevel(SupportedLevel);
+    }
+}
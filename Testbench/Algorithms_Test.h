@@ -0,0 +1,4 @@
+#pragma once
+
+void Algorithms_Benchmark();
+void Algorithms_Test();
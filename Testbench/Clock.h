@@ -0,0 +1,67 @@
+#pragma once
+#include "../Containers/Types.h"
+
+#include <chrono>
+
+/*
+* A very OO clock 
+*/
+
+struct Clock
+{
+    friend struct ScopedClock;
+
+public:
+    Clock()
+        : Duration(0)
+        , TotalDuration(0)
+    {
+    }
+
+    inline void Reset()
+    {
+        Duration = 0;
+        TotalDuration = 0;
+    }
+
+    inline Int64 GetLastDuration() const
+    {
+        return Duration;
+    }
+
+    inline Int64 GetTotalDuration() const
+    {
+        return TotalDuration;
+    }
+
+private:
+    inline void AddDuration(Int64 InDuration)
+    {
+        Duration = InDuration;
+        TotalDuration += Duration;
+    }
+
+    Int64 Duration		= 0;
+    Int64 TotalDuration	= 0;
+};
+
+struct ScopedClock
+{
+    ScopedClock(Clock& InParent)
+        : Parent(InParent)
+        , t0(std::chrono::high_resolution_clock::now())
+        , t1()
+    {
+        t0 = std::chrono::high_resolution_clock::now();
+    }
+
+    ~ScopedClock()
+    {
+        t1 = std::chrono::high_resolution_clock::now();
+        Parent.AddDuration(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+    }
+
+    Clock& Parent;
+    std::chrono::high_resolution_clock::time_point t0;
+    std::chrono::high_resolution_clock::time_point t1;
+};
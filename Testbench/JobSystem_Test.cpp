@@ -0,0 +1,309 @@
+#include "JobSystem_Test.h"
+
+#include "Clock.h"
+#include "Random.h"
+
+#include "../Containers/JobSystem.h"
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+/*
+ * Work that takes the same time on every thread
+ */
+
+static UInt64 Spin(UInt64 State, UInt32 Iterations)
+{
+    for (UInt32 i = 0; i < Iterations; i++)
+    {
+        NextRandom(State);
+    }
+
+    return State;
+}
+
+// Splits the range in halves until it is small enough, the halves run as separate jobs
+static UInt64 RecursiveSum(JobSystem& Jobs, UInt64 Begin, UInt64 End, UInt64 LeafSize)
+{
+    if (End - Begin <= LeafSize)
+    {
+        UInt64 Sum = 0;
+        for (UInt64 Index = Begin; Index < End; Index++)
+        {
+            Sum += Spin(Index + 1, 16) & 0xFF;
+        }
+
+        return Sum;
+    }
+
+    const UInt64 Middle = Begin + (End - Begin) / 2;
+
+    UInt64     LeftSum = 0;
+    JobCounter Counter;
+    Jobs.Run([&Jobs, &LeftSum, Begin, Middle, LeafSize]()
+    {
+        LeftSum = RecursiveSum(Jobs, Begin, Middle, LeafSize);
+    }, &Counter);
+
+    const UInt64 RightSum = RecursiveSum(Jobs, Middle, End, LeafSize);
+    Jobs.Wait(Counter);
+    return LeftSum + RightSum;
+}
+
+/*
+ * Benchmark
+ */
+
+void JobSystem_Benchmark()
+{
+    const UInt32 TestCount       = 10;
+    const UInt32 HardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    TArray<UInt32> ThreadCounts;
+    for (UInt32 NumThreads = 1; NumThreads < HardwareThreads; NumThreads *= 2)
+    {
+        ThreadCounts.PushBack(NumThreads);
+    }
+
+    ThreadCounts.PushBack(HardwareThreads);
+
+    std::cout << std::endl << "Benchmark (JobSystem, HardwareThreads=" << HardwareThreads << ")" << std::endl;
+
+#if 1
+    // Independent jobs started from one thread, the other threads only get work by stealing
+    {
+        const UInt32 NumJobs    = 64 * 1024;
+        const UInt32 Iterations = 4096;
+        std::cout << std::endl << "Independent jobs (Jobs=" << NumJobs << ", Iterations=" << Iterations << ", TestCount=" << TestCount << ")" << std::endl;
+
+        Int64 SingleThreadDuration = 0;
+        for (UInt32 NumThreads : ThreadCounts)
+        {
+            JobSystem Jobs(NumThreads);
+            std::atomic<UInt64> Result(0);
+
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+
+                JobCounter Counter;
+                for (UInt32 j = 0; j < NumJobs; j++)
+                {
+                    Jobs.Run([&Result, j]()
+                    {
+                        Result.fetch_add(Spin(j + 1, Iterations), std::memory_order_relaxed);
+                    }, &Counter);
+                }
+
+                Jobs.Wait(Counter);
+            }
+
+            const Int64 Duration = Clock.GetTotalDuration() / TestCount;
+            SingleThreadDuration = (NumThreads == 1) ? Duration : SingleThreadDuration;
+            std::cout << "Threads=" << NumThreads << ": " << Duration << "ns, Speedup=" << Double(SingleThreadDuration) / Double(Duration) << ", Stolen=" << Jobs.GetNumStolenJobs() / TestCount << std::endl;
+        }
+    }
+#endif
+
+#if 1
+    // Fork-join, every job starts more jobs and waits for them while helping
+    {
+        const UInt64 NumElements = 16 * 1024 * 1024;
+        const UInt64 LeafSize    = 16 * 1024;
+        std::cout << std::endl << "Fork-join (Elements=" << NumElements << ", LeafSize=" << LeafSize << ", TestCount=" << TestCount << ")" << std::endl;
+
+        Int64 SingleThreadDuration = 0;
+        for (UInt32 NumThreads : ThreadCounts)
+        {
+            JobSystem Jobs(NumThreads);
+            UInt64 Result = 0;
+
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                Result += RecursiveSum(Jobs, 0, NumElements, LeafSize);
+            }
+
+            const Int64 Duration = Clock.GetTotalDuration() / TestCount;
+            SingleThreadDuration = (NumThreads == 1) ? Duration : SingleThreadDuration;
+            std::cout << "Threads=" << NumThreads << ": " << Duration << "ns, Speedup=" << Double(SingleThreadDuration) / Double(Duration) << ", Stolen=" << Jobs.GetNumStolenJobs() / TestCount << " (Result=" << Result / TestCount << ")" << std::endl;
+        }
+    }
+#endif
+
+#if 1
+    // Cost of a job that does nothing
+    {
+        const UInt32 NumJobs = 1024 * 1024;
+        std::cout << std::endl << "Empty jobs (Jobs=" << NumJobs << ", TestCount=" << TestCount << ")" << std::endl;
+
+        for (UInt32 NumThreads : ThreadCounts)
+        {
+            JobSystem Jobs(NumThreads);
+
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+
+                JobCounter Counter;
+                for (UInt32 j = 0; j < NumJobs; j++)
+                {
+                    Jobs.Run([]() {}, &Counter);
+                }
+
+                Jobs.Wait(Counter);
+            }
+
+            std::cout << "Threads=" << NumThreads << ": " << Double(Clock.GetTotalDuration()) / (Double(TestCount) * NumJobs) << "ns per job" << std::endl;
+        }
+    }
+#endif
+}
+
+/*
+ * Test
+ */
+
+void JobSystem_Test()
+{
+    std::cout << std::endl << "----------JobSystem----------" << std::endl << std::endl;
+
+#if 1
+    std::cout << "Testing TWorkStealingQueue" << std::endl;
+    {
+        Int32 Values[] = { 1, 2, 3, 4 };
+
+        TWorkStealingQueue<Int32, 4> Queue;
+        for (Int32& Value : Values)
+        {
+            Queue.Push(&Value);
+        }
+
+        Int32 Extra = 5;
+        std::cout << "Full Push=" << Queue.Push(&Extra) << " Size=" << Queue.Size() << std::endl;
+
+        // The owner pops the newest element, thieves steal the oldest
+        std::cout << "Pop=" << *Queue.Pop() << " Steal=" << *Queue.Steal() << " Pop=" << *Queue.Pop() << " Steal=" << *Queue.Steal() << std::endl;
+        std::cout << "Empty Pop=" << (Queue.Pop() == nullptr) << " Empty Steal=" << (Queue.Steal() == nullptr) << std::endl;
+    }
+#endif
+
+#if 1
+    std::cout << std::endl << "Testing Run and Wait" << std::endl;
+    {
+        JobSystem Jobs(4);
+
+        // More jobs than fit in a queue, the rest run right away
+        const UInt32 NumJobs = 3 * JobSystem::QueueCapacity;
+
+        std::atomic<UInt32> NumFinished(0);
+        JobCounter Counter;
+        for (UInt32 i = 0; i < NumJobs; i++)
+        {
+            Jobs.Run([&NumFinished]()
+            {
+                NumFinished.fetch_add(1, std::memory_order_relaxed);
+            }, &Counter);
+        }
+
+        Jobs.Wait(Counter);
+        std::cout << "Threads=" << Jobs.GetNumThreads() << " Finished=" << NumFinished.load() << " Done=" << Counter.IsDone() << std::endl;
+    }
+#endif
+
+#if 1
+    std::cout << std::endl << "Testing dependencies" << std::endl;
+    {
+        JobSystem Jobs(4);
+
+        // The consumer waits for the producers from inside a job
+        const UInt32 NumProducers = 64;
+        UInt64 Values[NumProducers] = { };
+        UInt64 Sum = 0;
+
+        JobCounter ProducerCounter;
+        for (UInt32 Index = 0; Index < NumProducers; Index++)
+        {
+            Jobs.Run([&Values, Index]()
+            {
+                Values[Index] = UInt64(Index) * Index;
+            }, &ProducerCounter);
+        }
+
+        JobCounter ConsumerCounter;
+        Jobs.Run([&Jobs, &Values, &Sum, &ProducerCounter]()
+        {
+            Jobs.Wait(ProducerCounter);
+            for (UInt64 Value : Values)
+            {
+                Sum += Value;
+            }
+        }, &ConsumerCounter);
+
+        Jobs.Wait(ConsumerCounter);
+        std::cout << "Sum=" << Sum << " Expected=" << (NumProducers - 1) * NumProducers * (2 * NumProducers - 1) / 6 << std::endl;
+    }
+#endif
+
+#if 1
+    std::cout << std::endl << "Testing fork-join" << std::endl;
+    {
+        const UInt64 NumElements = 1024 * 1024;
+
+        UInt64 Expected = 0;
+        for (UInt64 Index = 0; Index < NumElements; Index++)
+        {
+            Expected += Spin(Index + 1, 16) & 0xFF;
+        }
+
+        Bool Passed = true;
+        for (UInt32 NumThreads = 1; NumThreads <= 4; NumThreads++)
+        {
+            JobSystem Jobs(NumThreads);
+            Passed = Passed && (RecursiveSum(Jobs, 0, NumElements, 1024) == Expected);
+        }
+
+        std::cout << "Passed=" << Passed << std::endl;
+    }
+#endif
+
+#if 1
+    std::cout << std::endl << "Testing captures" << std::endl;
+    {
+        UInt64 A = 1, B = 2, C = 3, D = 4, E = 5;
+        JobSystem::JobFunction Small = [A, B, C, D]() { std::cout << "Small=" << A + B + C + D << std::endl; };
+        JobSystem::JobFunction Large = [A, B, C, D, E]() { std::cout << "Large=" << A + B + C + D + E << std::endl; };
+        std::cout << "Small Inline=" << Small.IsStackAllocated() << " Large Inline=" << Large.IsStackAllocated() << std::endl;
+
+        JobSystem Jobs(2);
+        JobCounter Counter;
+        Jobs.Run(Small, &Counter);
+        Jobs.Wait(Counter);
+        Jobs.Run(Large, &Counter);
+        Jobs.Wait(Counter);
+    }
+#endif
+
+#if 1
+    std::cout << std::endl << "Testing destructor" << std::endl;
+    {
+        std::atomic<UInt32> NumFinished(0);
+        {
+            JobSystem Jobs(3);
+            for (UInt32 i = 0; i < 1000; i++)
+            {
+                Jobs.Run([&NumFinished]()
+                {
+                    NumFinished.fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+        }
+
+        std::cout << "Finished=" << NumFinished.load() << std::endl;
+    }
+#endif
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+void JobSystem_Benchmark();
+void JobSystem_Test();
@@ -3,6 +3,16 @@
 #include "TFunction_Test.h"
 #include "TStaticArray_Test.h"
 #include "TArrayView_Test.h"
+#include "TDeque_Test.h"
+#include "Sort_Test.h"
+#include "TFlatMap_Test.h"
+#include "THashMap_Test.h"
+#include "THashSet_Test.h"
+#include "TSoAArray_Test.h"
+#include "Algorithms_Test.h"
+#include "JobSystem_Test.h"
+#include "Parallel_Test.h"
+#include "TSPSCQueue_Test.h"
 
 // Defines
 #define RUN_TESTS     1
@@ -13,8 +23,29 @@
 #define RUN_TFUNCTION_TEST    0
 #define RUN_TSTATICARRAY_TEST 1
 #define RUN_TARRAYVIEW_TEST   0
+#define RUN_TDEQUE_TEST       0
+#define RUN_SORT_TEST         0
+#define RUN_TFLATMAP_TEST     0
+#define RUN_THASHMAP_TEST     0
+#define RUN_THASHSET_TEST     0
+#define RUN_TSOAARRAY_TEST    0
+#define RUN_ALGORITHMS_TEST   0
+#define RUN_JOBSYSTEM_TEST    0
+#define RUN_PARALLEL_TEST     0
+#define RUN_TSPSCQUEUE_TEST   0
 // Benchmark Specific defines
-#define RUN_TARRAY_BENCHMARKS 1
+#define RUN_TARRAY_BENCHMARKS     1
+#define RUN_TSHAREDPTR_BENCHMARKS 1
+#define RUN_TDEQUE_BENCHMARKS     1
+#define RUN_SORT_BENCHMARKS       1
+#define RUN_TFLATMAP_BENCHMARKS   1
+#define RUN_THASHMAP_BENCHMARKS   1
+#define RUN_THASHSET_BENCHMARKS   1
+#define RUN_TSOAARRAY_BENCHMARKS  1
+#define RUN_ALGORITHMS_BENCHMARKS 1
+#define RUN_JOBSYSTEM_BENCHMARKS  1
+#define RUN_PARALLEL_BENCHMARKS   1
+#define RUN_TSPSCQUEUE_BENCHMARKS 1
 
 // Check for memory leaks
 #ifdef _WIN32
@@ -30,6 +61,50 @@ void BenchMarks()
 #if RUN_TARRAY_BENCHMARKS
     TArray_Benchmark();
 #endif
+
+#if RUN_TSHAREDPTR_BENCHMARKS
+    TSharedPtr_Benchmark();
+#endif
+
+#if RUN_TDEQUE_BENCHMARKS
+    TDeque_Benchmark();
+#endif
+
+#if RUN_SORT_BENCHMARKS
+    Sort_Benchmark();
+#endif
+
+#if RUN_TFLATMAP_BENCHMARKS
+    TFlatMap_Benchmark();
+#endif
+
+#if RUN_THASHMAP_BENCHMARKS
+    THashMap_Benchmark();
+#endif
+
+#if RUN_THASHSET_BENCHMARKS
+    THashSet_Benchmark();
+#endif
+
+#if RUN_TSOAARRAY_BENCHMARKS
+    TSoAArray_Benchmark();
+#endif
+
+#if RUN_ALGORITHMS_BENCHMARKS
+    Algorithms_Benchmark();
+#endif
+
+#if RUN_JOBSYSTEM_BENCHMARKS
+    JobSystem_Benchmark();
+#endif
+
+#if RUN_PARALLEL_BENCHMARKS
+    Parallel_Benchmark();
+#endif
+
+#if RUN_TSPSCQUEUE_BENCHMARKS
+    TSPSCQueue_Benchmark();
+#endif
 }
 
 /*
@@ -57,6 +132,46 @@ void Tests(Int32 Argc, const Char* Argv[])
 #if RUN_TARRAYVIEW_TEST
     TArrayView_Test();
 #endif
+
+#if RUN_TDEQUE_TEST
+    TDeque_Test();
+#endif
+
+#if RUN_SORT_TEST
+    Sort_Test();
+#endif
+
+#if RUN_TFLATMAP_TEST
+    TFlatMap_Test();
+#endif
+
+#if RUN_THASHMAP_TEST
+    THashMap_Test();
+#endif
+
+#if RUN_THASHSET_TEST
+    THashSet_Test();
+#endif
+
+#if RUN_TSOAARRAY_TEST
+    TSoAArray_Test();
+#endif
+
+#if RUN_ALGORITHMS_TEST
+    Algorithms_Test();
+#endif
+
+#if RUN_JOBSYSTEM_TEST
+    JobSystem_Test();
+#endif
+
+#if RUN_PARALLEL_TEST
+    Parallel_Test();
+#endif
+
+#if RUN_TSPSCQUEUE_TEST
+    TSPSCQueue_Test();
+#endif
 }
 
 /*
@@ -0,0 +1,55 @@
+#pragma once
+#include "../Containers/Types.h"
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <Windows.h>
+    #include <psapi.h>
+#elif defined(__APPLE__)
+    #include <mach/mach.h>
+#else
+    #include <cstdio>
+    #include <unistd.h>
+#endif
+
+/*
+* Resident memory of the process in bytes, returns zero if the platform does not support it
+*/
+
+inline UInt64 GetResidentMemory()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS Counters;
+    if (::GetProcessMemoryInfo(::GetCurrentProcess(), &Counters, sizeof(Counters)))
+    {
+        return Counters.WorkingSetSize;
+    }
+
+    return 0;
+#elif defined(__APPLE__)
+    mach_task_basic_info Info;
+    mach_msg_type_number_t Count = MACH_TASK_BASIC_INFO_COUNT;
+    if (::task_info(::mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&Info), &Count) == KERN_SUCCESS)
+    {
+        return Info.resident_size;
+    }
+
+    return 0;
+#else
+    UInt64 NumPages    = 0;
+    UInt64 NumResident = 0;
+    if (FILE* File = ::fopen("/proc/self/statm", "r"))
+    {
+        if (::fscanf(File, "%llu %llu", reinterpret_cast<unsigned long long*>(&NumPages), reinterpret_cast<unsigned long long*>(&NumResident)) != 2)
+        {
+            NumResident = 0;
+        }
+
+        ::fclose(File);
+    }
+
+    return NumResident * UInt64(::sysconf(_SC_PAGESIZE));
+#endif
+}
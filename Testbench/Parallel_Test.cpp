@@ -0,0 +1,308 @@
+#include "Parallel_Test.h"
+
+#include "Clock.h"
+#include "Vec3.h"
+
+#include "../Containers/Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+/*
+ * Benchmark
+ */
+
+template<typename TFunction>
+static void ParallelBenchmark(const TArray<UInt32>& ThreadCounts, UInt32 TestCount, TFunction&& Function)
+{
+    Int64 SingleThreadDuration = 0;
+    for (UInt32 NumThreads : ThreadCounts)
+    {
+        JobSystem Jobs(NumThreads);
+
+        Clock Clock;
+        Double Result = 0.0;
+        for (UInt32 i = 0; i < TestCount; i++)
+        {
+            ScopedClock ScopedClock(Clock);
+            Result += Function(Jobs);
+        }
+
+        const Int64 Duration = Clock.GetTotalDuration() / TestCount;
+        SingleThreadDuration = (NumThreads == 1) ? Duration : SingleThreadDuration;
+        std::cout << "Threads=" << NumThreads << ": " << Duration << "ns, Speedup=" << Double(SingleThreadDuration) / Double(Duration) << " (Result=" << Result / TestCount << ")" << std::endl;
+    }
+}
+
+void Parallel_Benchmark()
+{
+    const UInt32 TestCount       = 5;
+    const UInt32 NumElements     = 100000000;
+    const UInt32 HardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const Double DeltaTime       = 1.0 / 60.0;
+
+    TArray<UInt32> ThreadCounts;
+    for (UInt32 NumThreads = 1; NumThreads < HardwareThreads; NumThreads *= 2)
+    {
+        ThreadCounts.PushBack(NumThreads);
+    }
+
+    ThreadCounts.PushBack(HardwareThreads);
+
+    std::cout << std::endl << "Benchmark (Parallel, HardwareThreads=" << HardwareThreads << ")" << std::endl;
+
+    TArray<Vec3> Vectors;
+    Vectors.Reserve(NumElements);
+    for (UInt32 i = 0; i < NumElements; i++)
+    {
+        Vectors.EmplaceBack(Double(i % 1024), 1.0, Double(i % 10));
+    }
+
+#if 1
+    // Moving every position by a constant velocity
+    {
+        std::cout << std::endl << "ParallelFor Integrate (Elements=" << NumElements << ", TestCount=" << TestCount << ")" << std::endl;
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                for (Vec3& Vector : Vectors)
+                {
+                    Vector.x += 1.0 * DeltaTime;
+                    Vector.y += 2.0 * DeltaTime;
+                    Vector.z -= 1.0 * DeltaTime;
+                }
+            }
+
+            std::cout << "Loop    : " << Clock.GetTotalDuration() / TestCount << "ns (y=" << Vectors[5].y << ")" << std::endl;
+        }
+
+        ParallelBenchmark(ThreadCounts, TestCount, [&](JobSystem& Jobs)
+        {
+            ParallelFor(Vectors, [DeltaTime](Vec3& Vector)
+            {
+                Vector.x += 1.0 * DeltaTime;
+                Vector.y += 2.0 * DeltaTime;
+                Vector.z -= 1.0 * DeltaTime;
+            }, &Jobs);
+
+            return Vectors[5].y;
+        });
+    }
+#endif
+
+#if 1
+    // Sum of the lengths
+    {
+        std::cout << std::endl << "ParallelReduce Length (Elements=" << NumElements << ", TestCount=" << TestCount << ")" << std::endl;
+
+        {
+            Clock  Clock;
+            Double Sum = 0.0;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                for (const Vec3& Vector : Vectors)
+                {
+                    Sum += std::sqrt((Vector.x * Vector.x) + (Vector.y * Vector.y) + (Vector.z * Vector.z));
+                }
+            }
+
+            std::cout << "Loop    : " << Clock.GetTotalDuration() / TestCount << "ns (Result=" << Sum / TestCount << ")" << std::endl;
+        }
+
+        ParallelBenchmark(ThreadCounts, TestCount, [&](JobSystem& Jobs)
+        {
+            return ParallelReduce(Vectors, 0.0, [](Double Sum, const Vec3& Vector)
+            {
+                return Sum + std::sqrt((Vector.x * Vector.x) + (Vector.y * Vector.y) + (Vector.z * Vector.z));
+            },
+            [](Double Lhs, Double Rhs)
+            {
+                return Lhs + Rhs;
+            }, &Jobs);
+        });
+    }
+#endif
+
+#if 1
+    // Scaling every vector in place
+    {
+        std::cout << std::endl << "ParallelTransform Scale (Elements=" << NumElements << ", TestCount=" << TestCount << ")" << std::endl;
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                for (Vec3& Vector : Vectors)
+                {
+                    Vector = Vec3(Vector.x * 0.5, Vector.y * 0.5, Vector.z * 0.5);
+                }
+            }
+
+            std::cout << "Loop    : " << Clock.GetTotalDuration() / TestCount << "ns (y=" << Vectors[5].y << ")" << std::endl;
+        }
+
+        ParallelBenchmark(ThreadCounts, TestCount, [&](JobSystem& Jobs)
+        {
+            ParallelTransform(Vectors, Vectors, [](const Vec3& Vector)
+            {
+                return Vec3(Vector.x * 0.5, Vector.y * 0.5, Vector.z * 0.5);
+            }, &Jobs);
+
+            return Vectors[5].y;
+        });
+    }
+#endif
+}
+
+/*
+ * Test
+ */
+
+void Parallel_Test()
+{
+    std::cout << std::endl << "----------Parallel----------" << std::endl << std::endl;
+
+#if 1
+    std::cout << "Testing chunks" << std::endl;
+    {
+        TArray<Vec3> Vectors(100000);
+
+        // Every chunk but the first starts a cache line, and the chunks cover the view without gaps
+        Bool IsAligned = true;
+        Bool IsCovered = true;
+        for (UInt32 Offset = 0; Offset < 8; Offset++)
+        {
+            const _ParallelImpl::Partition Partition = _ParallelImpl::MakePartition(Vectors.Data() + Offset, Vectors.Size() - Offset, 4);
+            for (UInt64 Chunk = 1; Chunk < Partition.NumChunks; Chunk++)
+            {
+                IsAligned = IsAligned && ((reinterpret_cast<size_t>(Vectors.Data() + Offset + Partition.GetBegin(Chunk)) % 64) == 0);
+                IsCovered = IsCovered && (Partition.GetBegin(Chunk) == Partition.GetEnd(Chunk - 1));
+            }
+
+            IsCovered = IsCovered && (Partition.GetEnd(Partition.NumChunks - 1) == Vectors.Size() - Offset);
+        }
+
+        std::cout << "IsAligned=" << IsAligned << " IsCovered=" << IsCovered << std::endl;
+    }
+#endif
+
+#if 1
+    std::cout << std::endl << "Testing ParallelFor" << std::endl;
+    {
+        const UInt32 Sizes[] = { 0, 1, 100, 4097, 100003 };
+
+        Bool Passed = true;
+        for (UInt32 NumThreads = 1; NumThreads <= 4; NumThreads++)
+        {
+            JobSystem Jobs(NumThreads);
+            for (UInt32 Size : Sizes)
+            {
+                TArray<UInt32> Numbers(Size, 1);
+                ParallelFor(Numbers, [](UInt32& Number) { Number *= 3; });
+
+                // Sub-views that start in the middle of a cache line
+                ParallelFor(TArrayView<UInt32>(Numbers.Begin() + (Size / 3), Numbers.End()), [](UInt32& Number) { Number += 1; }, &Jobs);
+                for (UInt32 Index = 0; Index < Size; Index++)
+                {
+                    Passed = Passed && (Numbers[Index] == ((Index < Size / 3) ? 3u : 4u));
+                }
+            }
+        }
+
+        // Without a JobSystem the calling thread runs the body
+        TArray<UInt32> Numbers = { 1, 2, 3 };
+        ParallelFor(Numbers, [](UInt32& Number) { Number *= 2; });
+        std::cout << "Numbers=" << Numbers[0] << " " << Numbers[1] << " " << Numbers[2] << std::endl;
+
+        // A thread that does not belong to the JobSystem runs the body itself instead of pushing jobs
+        {
+            JobSystem Jobs(4);
+
+            TArray<UInt32> OtherNumbers(100003u, 1u);
+            std::thread Thread([&Jobs, &OtherNumbers]()
+            {
+                ParallelFor(OtherNumbers, [](UInt32& Number) { Number += 1; }, &Jobs);
+            });
+
+            Thread.join();
+            for (UInt32 Number : OtherNumbers)
+            {
+                Passed = Passed && (Number == 2);
+            }
+        }
+
+        std::cout << "Passed=" << Passed << std::endl;
+    }
+#endif
+
+#if 1
+    std::cout << std::endl << "Testing ParallelReduce" << std::endl;
+    {
+        TArray<UInt32> Numbers;
+        for (UInt32 i = 0; i < 1000000; i++)
+        {
+            Numbers.PushBack(i % 1000);
+        }
+
+        UInt64 Expected = 0;
+        for (UInt32 Number : Numbers)
+        {
+            Expected += Number;
+        }
+
+        Bool Passed = true;
+        for (UInt32 NumThreads = 1; NumThreads <= 4; NumThreads++)
+        {
+            JobSystem Jobs(NumThreads);
+            const UInt64 Sum = ParallelReduce(Numbers, UInt64(0), [](UInt64 Sum, UInt32 Number) { return Sum + Number; }, [](UInt64 Lhs, UInt64 Rhs) { return Lhs + Rhs; });
+            const UInt32 Max = ParallelReduce(Numbers, 0u, [](UInt32 Max, UInt32 Number) { return std::max(Max, Number); }, [](UInt32 Lhs, UInt32 Rhs) { return std::max(Lhs, Rhs); });
+            Passed = Passed && (Sum == Expected) && (Max == 999);
+        }
+
+        TArray<UInt32> Empty;
+        const UInt64 EmptySum = ParallelReduce(Empty, UInt64(7), [](UInt64 Sum, UInt32 Number) { return Sum + Number; }, [](UInt64 Lhs, UInt64 Rhs) { return Lhs + Rhs; });
+        std::cout << "Sum=" << Expected << " Empty=" << EmptySum << " Passed=" << Passed << std::endl;
+    }
+#endif
+
+#if 1
+    std::cout << std::endl << "Testing ParallelTransform" << std::endl;
+    {
+        JobSystem Jobs(3);
+
+        TArray<Vec3> Vectors;
+        for (UInt32 i = 0; i < 50000; i++)
+        {
+            Vectors.EmplaceBack(Double(i), 1.0, -Double(i));
+        }
+
+        TArray<Double> Lengths(Vectors.Size());
+        ParallelTransform(Vectors, Lengths, [](const Vec3& Vector)
+        {
+            return (Vector.x * Vector.x) + (Vector.y * Vector.y) + (Vector.z * Vector.z);
+        });
+
+        // In place
+        ParallelTransform(Vectors, Vectors, [](const Vec3& Vector)
+        {
+            return Vec3(Vector.x * 2.0, Vector.y * 2.0, Vector.z * 2.0);
+        });
+
+        Bool Passed = true;
+        for (UInt32 Index = 0; Index < Vectors.Size(); Index++)
+        {
+            Passed = Passed && (Lengths[Index] == (2.0 * Double(Index) * Double(Index)) + 1.0);
+            Passed = Passed && (Vectors[Index] == Vec3(2.0 * Double(Index), 2.0, -2.0 * Double(Index)));
+        }
+
+        std::cout << "Lengths[3]=" << Lengths[3] << " Vectors[3]=" << std::string(Vectors[3]) << " Passed=" << Passed << std::endl;
+    }
+#endif
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+void Parallel_Benchmark();
+void Parallel_Test();
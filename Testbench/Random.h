@@ -0,0 +1,14 @@
+#pragma once
+#include "../Containers/Types.h"
+
+/*
+ * Random numbers that are the same on all platforms
+ */
+
+inline UInt64 NextRandom(UInt64& State)
+{
+    State ^= State << 13;
+    State ^= State >> 7;
+    State ^= State << 17;
+    return State;
+}
@@ -0,0 +1,331 @@
+#include "Sort_Test.h"
+
+#include "Clock.h"
+#include "Random.h"
+#include "Vec3.h"
+
+#include "../Containers/Sort.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+// Doubles between -1000 and 1000 with three decimals
+static Double NextRandomDouble(UInt64& State)
+{
+    return Double(NextRandom(State) % 2000000) / 1000.0 - 1000.0;
+}
+
+static Bool Vec3Less(const Vec3& Lhs, const Vec3& Rhs)
+{
+    if (Lhs.x != Rhs.x)
+    {
+        return Lhs.x < Rhs.x;
+    }
+
+    if (Lhs.y != Rhs.y)
+    {
+        return Lhs.y < Rhs.y;
+    }
+
+    return Lhs.z < Rhs.z;
+}
+
+/*
+ * Benchmark
+ */
+
+template<typename T, typename TSortFunc>
+static void SortBenchmark(const Char* Name, const TArray<T>& Source, UInt32 TestCount, TSortFunc&& SortFunc)
+{
+    Clock Clock;
+    for (UInt32 i = 0; i < TestCount; i++)
+    {
+        TArray<T> Elements(Source);
+        {
+            ScopedClock ScopedClock(Clock);
+            SortFunc(Elements);
+        }
+    }
+
+    std::cout << Name << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+}
+
+void Sort_Benchmark()
+{
+    std::cout << std::endl << "Benchmark (Sort)" << std::endl;
+    const UInt32 TestCount = 10;
+
+#if 1
+    // Vec3
+    {
+        const UInt32 NumElements = 1000000;
+        std::cout << std::endl << "Vec3 (Elements=" << NumElements << ", TestCount=" << TestCount << ")" << std::endl;
+
+        UInt64 State = 0x9E3779B97F4A7C15ull;
+        TArray<Vec3> Source;
+        Source.Reserve(NumElements);
+        for (UInt32 i = 0; i < NumElements; i++)
+        {
+            const Double x = NextRandomDouble(State);
+            const Double y = NextRandomDouble(State);
+            const Double z = NextRandomDouble(State);
+            Source.EmplaceBack(x, y, z);
+        }
+
+        SortBenchmark("std::sort     :", Source, TestCount, [](TArray<Vec3>& Elements)
+        {
+            std::sort(Elements.Begin(), Elements.End(), Vec3Less);
+        });
+
+        SortBenchmark("Sort          :", Source, TestCount, [](TArray<Vec3>& Elements)
+        {
+            Sort(Elements, Vec3Less);
+        });
+
+        SortBenchmark("ParallelSort  :", Source, TestCount, [](TArray<Vec3>& Elements)
+        {
+            ParallelSort(Elements, Vec3Less);
+        });
+
+        // Sort on a single key
+        SortBenchmark("std::sort (x) :", Source, TestCount, [](TArray<Vec3>& Elements)
+        {
+            std::sort(Elements.Begin(), Elements.End(), [](const Vec3& Lhs, const Vec3& Rhs) { return Lhs.x < Rhs.x; });
+        });
+
+        SortBenchmark("SortBy (x)    :", Source, TestCount, [](TArray<Vec3>& Elements)
+        {
+            SortBy(Elements, [](const Vec3& Element) { return Element.x; });
+        });
+
+        SortBenchmark("RadixSortBy(x):", Source, TestCount, [](TArray<Vec3>& Elements)
+        {
+            RadixSortBy(Elements, [](const Vec3& Element) { return Element.x; });
+        });
+    }
+#endif
+
+#if 1
+    // Integers
+    {
+        const UInt32 NumElements = 1000000;
+        std::cout << std::endl << "UInt32 (Elements=" << NumElements << ", TestCount=" << TestCount << ")" << std::endl;
+
+        UInt64 State = 0x2545F4914F6CDD1Dull;
+        TArray<UInt32> Source;
+        Source.Reserve(NumElements);
+        for (UInt32 i = 0; i < NumElements; i++)
+        {
+            Source.PushBack(UInt32(NextRandom(State)));
+        }
+
+        SortBenchmark("std::sort     :", Source, TestCount, [](TArray<UInt32>& Elements)
+        {
+            std::sort(Elements.Begin(), Elements.End());
+        });
+
+        SortBenchmark("Sort          :", Source, TestCount, [](TArray<UInt32>& Elements)
+        {
+            Sort(Elements);
+        });
+
+        SortBenchmark("RadixSort     :", Source, TestCount, [](TArray<UInt32>& Elements)
+        {
+            RadixSort(Elements);
+        });
+
+        SortBenchmark("ParallelSort  :", Source, TestCount, [](TArray<UInt32>& Elements)
+        {
+            ParallelSort(Elements);
+        });
+
+        // Already sorted input
+        TArray<UInt32> Sorted(Source);
+        Sort(Sorted);
+
+        SortBenchmark("std::sort (Sorted):", Sorted, TestCount, [](TArray<UInt32>& Elements)
+        {
+            std::sort(Elements.Begin(), Elements.End());
+        });
+
+        SortBenchmark("Sort (Sorted)     :", Sorted, TestCount, [](TArray<UInt32>& Elements)
+        {
+            Sort(Elements);
+        });
+    }
+#endif
+
+#if 1
+    // Strings
+    {
+        const UInt32 NumElements = 200000;
+        std::cout << std::endl << "std::string (Elements=" << NumElements << ", TestCount=" << TestCount << ")" << std::endl;
+
+        UInt64 State = 0x853C49E6748FEA9Bull;
+        TArray<std::string> Source;
+        Source.Reserve(NumElements);
+        for (UInt32 i = 0; i < NumElements; i++)
+        {
+            Source.EmplaceBack("String number " + std::to_string(NextRandom(State) % 1000000));
+        }
+
+        SortBenchmark("std::sort     :", Source, TestCount, [](TArray<std::string>& Elements)
+        {
+            std::sort(Elements.Begin(), Elements.End());
+        });
+
+        SortBenchmark("Sort          :", Source, TestCount, [](TArray<std::string>& Elements)
+        {
+            Sort(Elements);
+        });
+
+        SortBenchmark("ParallelSort  :", Source, TestCount, [](TArray<std::string>& Elements)
+        {
+            ParallelSort(Elements);
+        });
+    }
+#endif
+}
+
+/*
+ * Test
+ */
+
+void Sort_Test()
+{
+    std::cout << std::endl << "----------Sort----------" << std::endl << std::endl;
+
+    std::cout << "Testing Sort" << std::endl;
+    {
+        TArray<Int32> Numbers = { 5, -3, 9, 1, 5, 0, -3, 7, 2, 8, 6, 4, 3, 1, 9, -10, 11, 12, 0, 5, 5, 5, 14, 13, 2, 1 };
+        Sort(Numbers);
+        for (Int32 Number : Numbers)
+        {
+            std::cout << Number << " ";
+        }
+
+        std::cout << std::endl;
+
+        // Descending order with a custom comparison, on a part of the array
+        TArrayView<Int32> Part(Numbers.Data(), Numbers.Data() + 10);
+        Sort(Part, [](Int32 Lhs, Int32 Rhs) { return Lhs > Rhs; });
+        for (Int32 Number : Part)
+        {
+            std::cout << Number << " ";
+        }
+
+        std::cout << std::endl;
+    }
+
+    std::cout << "Testing Sort (Large)" << std::endl;
+    {
+        UInt64 State = 0x9E3779B97F4A7C15ull;
+
+        // Random, sorted, reversed and many equal elements
+        TArray<UInt32> Random;
+        TArray<UInt32> Reversed;
+        TArray<UInt32> FewUnique;
+        for (UInt32 i = 0; i < 100000; i++)
+        {
+            Random.PushBack(UInt32(NextRandom(State)));
+            Reversed.PushBack(100000 - i);
+            FewUnique.PushBack(UInt32(NextRandom(State) % 4));
+        }
+
+        TArray<UInt32> Expected(Random);
+        std::sort(Expected.Begin(), Expected.End());
+
+        Sort(Random);
+        Sort(Reversed);
+        Sort(FewUnique);
+
+        Bool IsEqual = true;
+        for (UInt32 i = 0; i < Random.Size(); i++)
+        {
+            IsEqual = IsEqual && (Random[i] == Expected[i]);
+        }
+
+        std::cout << "Random=" << IsEqual << " Reversed=" << IsSorted(Reversed) << " FewUnique=" << IsSorted(FewUnique) << std::endl;
+    }
+
+    std::cout << "Testing SortBy" << std::endl;
+    {
+        TArray<std::string> Strings = { "Medium", "A", "Longest string", "Short", "Longer string" };
+        SortBy(Strings, [](const std::string& String) { return String.size(); });
+        for (const std::string& String : Strings)
+        {
+            std::cout << String << std::endl;
+        }
+
+        TArray<Vec3> Vectors = { Vec3(3.0, 0.0, 0.0), Vec3(-1.0, 2.0, 0.0), Vec3(0.0, 0.0, 0.5) };
+        SortBy(Vectors, [](const Vec3& Vector) { return (Vector.x * Vector.x) + (Vector.y * Vector.y) + (Vector.z * Vector.z); });
+        for (const Vec3& Vector : Vectors)
+        {
+            std::cout << std::string(Vector) << std::endl;
+        }
+    }
+
+    std::cout << "Testing RadixSort" << std::endl;
+    {
+        TArray<Int32> Signed = { 3, -1, 2000000, -2000000, 0, 7, -7, 42, -42, 1, 100, -100, 5, 6, 8, 9, 10, 11, -11, 12, 13, -13, 14, 15, 16 };
+        RadixSort(Signed);
+        for (Int32 Number : Signed)
+        {
+            std::cout << Number << " ";
+        }
+
+        std::cout << std::endl;
+
+        TArray<Float> Floats = { 1.5f, -0.5f, 0.0f, -100.0f, 3.25f, 1e10f, -1e-10f, 2.0f };
+        RadixSort(Floats);
+        for (Float Number : Floats)
+        {
+            std::cout << Number << " ";
+        }
+
+        std::cout << std::endl;
+
+        // Stable, elements with the same key keep their order
+        TArray<Vec3> Vectors;
+        for (UInt32 i = 0; i < 40; i++)
+        {
+            Vectors.EmplaceBack(Double(i % 4), Double(i), 0.0);
+        }
+
+        RadixSortBy(Vectors, [](const Vec3& Vector) { return Vector.x; });
+
+        Bool IsStable = true;
+        for (UInt32 i = 1; i < Vectors.Size(); i++)
+        {
+            IsStable = IsStable && ((Vectors[i - 1].x < Vectors[i].x) || (Vectors[i - 1].y < Vectors[i].y));
+        }
+
+        std::cout << "Front=" << std::string(Vectors.Front()) << " Back=" << std::string(Vectors.Back()) << " IsStable=" << IsStable << std::endl;
+    }
+
+    std::cout << "Testing ParallelSort" << std::endl;
+    {
+        UInt64 State = 0x2545F4914F6CDD1Dull;
+
+        TArray<std::string> Strings;
+        for (UInt32 i = 0; i < 100000; i++)
+        {
+            Strings.EmplaceBack(std::to_string(NextRandom(State) % 100000));
+        }
+
+        // Uneven number of threads, so that one run is carried over to the next round of merges
+        TArray<std::string> Threads3(Strings);
+        ParallelSort(Threads3, LessThan(), 3);
+        ParallelSort(Strings, LessThan(), 8);
+
+        TArray<Vec3> Vectors;
+        for (UInt32 i = 0; i < 100000; i++)
+        {
+            Vectors.EmplaceBack(NextRandomDouble(State), 0.0, 0.0);
+        }
+
+        ParallelSortBy(Vectors, [](const Vec3& Vector) { return Vector.x; }, 4);
+        std::cout << "Strings=" << IsSorted(Strings) << " Size=" << Strings.Size() << " Threads3=" << IsSorted(Threads3) << " Vectors=" << IsSorted(Vectors, [](const Vec3& Lhs, const Vec3& Rhs) { return Lhs.x < Rhs.x; }) << std::endl;
+    }
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+void Sort_Benchmark();
+void Sort_Test();
@@ -79,5 +79,5 @@ void TArrayView_Test()
     PrintArrayViewRangeBased(ArrView4);
     PrintArrayViewRangeBased(ArrView5);
 
-    delete DynamicPtr;
+    delete[] DynamicPtr;
 }
\ No newline at end of file
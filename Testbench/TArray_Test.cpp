@@ -1,143 +1,263 @@
 #include "TArray_Test.h"
 
+#include "Clock.h"
+#include "Vec3.h"
+
 #include "../Containers/Array.h"
+#include "../Containers/ArrayView.h"
+#include "../Containers/LinearAllocator.h"
+#include "../Containers/TrackingAllocator.h"
 
+#include <algorithm>
+#include <iomanip>
 #include <iostream>
+#include <numeric>
 #include <string>
 #include <vector>
-#include <chrono>
 
 /*
-* A very OO clock 
-*/
+ * PrintArr
+ */
+
+template<typename T>
+void PrintArr(const TArray<T>& Arr, const std::string& Name = "")
+{
+    std::cout << Name << std::endl;
+    std::cout << "--------------------------------" << std::endl;
+
+    for (auto i : Arr)
+    {
+        std::cout << (std::string)i << std::endl;
+    }
+
+    std::cout << "Size: " << Arr.Size() << std::endl;
+    std::cout << "Capacity: " << Arr.Capacity() << std::endl;
+
+    std::cout << "--------------------------------" << std::endl << std::endl;
+}
 
-struct Clock
+template<typename T>
+void PrintArr(const std::vector<T>& Arr, const std::string& Name = "")
 {
-    friend struct ScopedClock;
+    std::cout << Name << std::endl;
+    std::cout << "--------------------------------" << std::endl;
 
-public:
-    Clock()
-        : Duration(0)
-        , TotalDuration(0)
+    for (auto i : Arr)
     {
+        std::cout << i << std::endl;
     }
 
-    inline void Reset()
+    std::cout << "Size: " << Arr.size() << std::endl;
+    std::cout << "Capacity: " << Arr.capacity() << std::endl;
+
+    std::cout << "--------------------------------" << std::endl << std::endl;
+}
+#define PrintArr(Arr) PrintArr(Arr, #Arr)
+
+/*
+ * Memory tags
+ */
+
+DECLARE_MEMORY_TAG(TestArrays);
+DECLARE_MEMORY_TAG(BenchmarkArrays);
+
+/*
+ * CopyingMallocator - Allocator without Reallocate, every growth allocates a new block and copies the elements
+ */
+
+struct CopyingMallocator
+{
+    void* Allocate(UInt64 Size, UInt64 Alignment)
     {
-        Duration = 0;
-        TotalDuration = 0;
+        return Mallocator().Allocate(Size, Alignment);
     }
 
-    inline Int64 GetLastDuration() const
+    void Free(void* Ptr, UInt64 Alignment)
     {
-        return Duration;
+        Mallocator().Free(Ptr, Alignment);
     }
+};
+
+/*
+ * StatsMallocator - Mallocator that counts allocations and keeps track of the peak number of bytes in use
+ */
 
-    inline Int64 GetTotalDuration() const
+struct StatsMallocator : public Mallocator
+{
+    void* Allocate(UInt64 Size, UInt64 Alignment)
     {
-        return TotalDuration;
+        void* Ptr = Mallocator::Allocate(Size, Alignment);
+        NumAllocations++;
+        AddBytes(Ptr, Alignment);
+        return Ptr;
     }
 
-private:
-    inline void AddDuration(Int64 InDuration)
+    void* Reallocate(void* Ptr, UInt64 Size, UInt64 Alignment)
     {
-        Duration = InDuration;
-        TotalDuration += Duration;
+        RemoveBytes(Ptr, Alignment);
+        Ptr = Mallocator::Reallocate(Ptr, Size, Alignment);
+        NumAllocations++;
+        AddBytes(Ptr, Alignment);
+        return Ptr;
     }
 
-    Int64 Duration		= 0;
-    Int64 TotalDuration	= 0;
-};
+    void Free(void* Ptr, UInt64 Alignment)
+    {
+        RemoveBytes(Ptr, Alignment);
+        Mallocator::Free(Ptr, Alignment);
+    }
 
-struct ScopedClock
-{
-    ScopedClock(Clock& InParent)
-        : Parent(InParent)
-        , t0(std::chrono::high_resolution_clock::now())
-        , t1()
+    static void ResetStats()
     {
-        t0 = std::chrono::high_resolution_clock::now();
+        NumAllocations = 0;
+        CurrentBytes   = 0;
+        PeakBytes      = 0;
     }
 
-    ~ScopedClock()
+    inline static UInt64 NumAllocations = 0;
+    inline static UInt64 CurrentBytes   = 0;
+    inline static UInt64 PeakBytes      = 0;
+
+private:
+    void AddBytes(void* Ptr, UInt64 Alignment)
     {
-        t1 = std::chrono::high_resolution_clock::now();
-        Parent.AddDuration(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+        CurrentBytes += Ptr ? GetUsableSize(Ptr, Alignment) : 0;
+        PeakBytes     = (CurrentBytes > PeakBytes) ? CurrentBytes : PeakBytes;
     }
 
-    Clock& Parent;
-    std::chrono::steady_clock::time_point t0;
-    std::chrono::steady_clock::time_point t1;
+    void RemoveBytes(void* Ptr, UInt64 Alignment)
+    {
+        CurrentBytes -= Ptr ? GetUsableSize(Ptr, Alignment) : 0;
+    }
 };
 
 /*
- * Vec3
+ * GrowthPolicyBenchmark
  */
 
-struct Vec3
+template<typename TGrowthPolicy>
+void GrowthPolicyBenchmark(const Char* PolicyName)
 {
-    Vec3()
-        : x(0.0)
-        , y(0.0)
-        , z(0.0)
+    typedef TArray<UInt64, StatsMallocator, TGrowthPolicy> LargeArrayType;
+    typedef TArray<UInt32, StatsMallocator, TGrowthPolicy> SmallArrayType;
+
+    // Bulk ingest into one large array
     {
+        const UInt32 Iterations = 16 * 1024 * 1024;
+
+        StatsMallocator::ResetStats();
+        Clock Clock;
+        {
+            LargeArrayType Numbers;
+
+            ScopedClock ScopedClock(Clock);
+            for (UInt32 j = 0; j < Iterations; j++)
+            {
+                Numbers.PushBack(j);
+            }
+        }
+
+        std::cout << PolicyName << " Large: " << Clock.GetTotalDuration() << "ns, Allocations=" << StatsMallocator::NumAllocations << ", Peak=" << StatsMallocator::PeakBytes / 1024 << "KB" << std::endl;
     }
 
-    Vec3(Double InX, Double InY, Double InZ)
-        : x(InX)
-        , y(InY)
-        , z(InZ)
+    // Many tiny arrays
     {
-    }
+        const UInt32 NumArrays = 1024 * 1024;
 
-    Double x;
-    Double y;
-    Double z;
+        StatsMallocator::ResetStats();
+        Clock Clock;
+        {
+            TArray<SmallArrayType> Arrays(NumArrays);
 
-    operator std::string() const
-    {
-        return std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z);
+            ScopedClock ScopedClock(Clock);
+            for (UInt32 j = 0; j < NumArrays; j++)
+            {
+                const UInt32 NumElements = (j % 8) + 1;
+                for (UInt32 k = 0; k < NumElements; k++)
+                {
+                    Arrays[j].PushBack(k);
+                }
+            }
+        }
+
+        std::cout << PolicyName << " Small: " << Clock.GetTotalDuration() << "ns, Allocations=" << StatsMallocator::NumAllocations << ", Peak=" << StatsMallocator::PeakBytes / 1024 << "KB" << std::endl;
     }
-};
+}
 
 /*
- * PrintArr
+ * ProcessRequest - Builds a few short-lived arrays like a typical request handler would
  */
 
-template<typename T>
-void PrintArr(const TArray<T>& Arr, const std::string& Name = "")
+template<typename TAllocator>
+UInt64 ProcessRequest(UInt32 RequestIndex, const TAllocator& Allocator)
 {
-    std::cout << Name << std::endl;
-    std::cout << "--------------------------------" << std::endl;
-
-    for (auto i : Arr)
+    TArray<TArray<UInt32, TAllocator>, TAllocator> Rows(Allocator);
+    for (UInt32 i = 0; i < 16; i++)
     {
-        std::cout << (std::string)i << std::endl;
+        TArray<UInt32, TAllocator>& Row = Rows.EmplaceBack(Allocator);
+        for (UInt32 j = 0; j < 24; j++)
+        {
+            Row.PushBack(RequestIndex + i + j);
+        }
     }
 
-    std::cout << "Size: " << Arr.Size() << std::endl;
-    std::cout << "Capacity: " << Arr.Capacity() << std::endl;
+    UInt64 Sum = 0;
+    for (const TArray<UInt32, TAllocator>& Row : Rows)
+    {
+        Sum += Row.Back();
+    }
 
-    std::cout << "--------------------------------" << std::endl << std::endl;
+    return Sum;
 }
 
+/*
+ * FillBenchmark - Fills arrays from 1KB to 1GB, reported in GB/s
+ */
+
 template<typename T>
-void PrintArr(const std::vector<T>& Arr, const std::string& Name = "")
+void FillBenchmark(const Char* TypeName, const T& Value)
 {
-    std::cout << Name << std::endl;
-    std::cout << "--------------------------------" << std::endl;
+    const UInt64 MaxBytes = 1024ull * 1024 * 1024;
+    std::cout << std::endl << "Fill (" << TypeName << ")" << std::endl;
 
-    for (auto i : Arr)
+    for (UInt64 NumBytes = 1024; NumBytes <= MaxBytes; NumBytes *= 4)
     {
-        std::cout << i << std::endl;
-    }
+        const UInt64 Count     = NumBytes / sizeof(T);
+        const UInt64 TestCount = std::max<UInt64>(2, (4 * MaxBytes) / NumBytes);
 
-    std::cout << "Size: " << Arr.size() << std::endl;
-    std::cout << "Capacity: " << Arr.capacity() << std::endl;
+        Double VectorSpeed = 0.0;
+        {
+            std::vector<T> Values(Count);
+            std::fill(Values.begin(), Values.end(), Value);
 
-    std::cout << "--------------------------------" << std::endl << std::endl;
+            Clock Clock;
+            for (UInt64 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                std::fill(Values.begin(), Values.end(), Value);
+            }
+
+            VectorSpeed = Double(NumBytes * TestCount) / Double(Clock.GetTotalDuration());
+        }
+
+        Double ArraySpeed = 0.0;
+        {
+            TArray<T> Values(static_cast<UInt32>(Count));
+            Values.Fill(Value);
+
+            Clock Clock;
+            for (UInt64 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                Values.Fill(Value);
+            }
+
+            ArraySpeed = Double(NumBytes * TestCount) / Double(Clock.GetTotalDuration());
+        }
+
+        std::cout << "Size=" << std::setw(7) << (NumBytes / 1024) << "KB std::fill:" << std::setw(6) << std::fixed << std::setprecision(2) << VectorSpeed << "GB/s TArray::Fill:" << std::setw(6) << ArraySpeed << "GB/s" << std::endl;
+    }
 }
-#define PrintArr(Arr) PrintArr(Arr, #Arr)
 
 /*
  * Benchmark
@@ -206,254 +326,874 @@ void TArray_Benchmark()
                 }
             }
 
-            std::cout << "std::vector:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+            std::cout << "std::vector:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                TArray<std::string> Strings1;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Strings1.Emplace(Strings1.begin(), "My name is jeff");
+                }
+            }
+            std::cout << "TArray     :" << Clock.GetTotalDuration() / Iterations << "ns" << std::endl;
+        }
+    }
+#endif
+
+#if 1
+    // PushBack
+    {
+        const UInt32 Iterations = 10000;
+        std::cout << std::endl << "PushBack (Iterations=" << Iterations << ", TestCount=" << TestCount << ")" << std::endl;
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                std::vector<std::string> Strings0;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Strings0.push_back("My name is jeff");
+                }
+            }
+
+            std::cout << "std::vector:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                TArray<std::string> Strings1;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Strings1.PushBack("My name is jeff");
+                }
+            }
+            std::cout << "TArray     :" << Clock.GetTotalDuration() / Iterations << "ns" << std::endl;
+        }
+    }
+#endif
+
+#if 1
+    // EmplaceBack
+    {
+        const UInt32 Iterations = 10000;
+        std::cout << std::endl << "EmplaceBack (Iterations=" << Iterations << ", TestCount=" << TestCount << ")" << std::endl;
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                std::vector<std::string> Strings0;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Strings0.emplace_back("My name is jeff");
+                }
+            }
+
+            std::cout << "std::vector:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                TArray<std::string> Strings1;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Strings1.EmplaceBack("My name is jeff");
+                }
+            }
+            std::cout << "TArray     :" << Clock.GetTotalDuration() / Iterations << "ns" << std::endl;
+        }
+    }
+#endif
+
+    std::cout << std::endl << "Benchmark (Vec3)" << std::endl;
+
+    // Insert
+#if 1
+    {
+        const UInt32 Iterations = 10000;
+        std::cout << std::endl << "Insert (Iterations=" << Iterations << ", TestCount=" << TestCount << ")" << std::endl;
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                std::vector<Vec3> Vectors0;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Vectors0.insert(Vectors0.begin(), Vec3(3.0, 5.0, -6.0));
+                }
+            }
+
+            std::cout << "std::vector:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                TArray<Vec3> Vectors1;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Vectors1.Insert(Vectors1.Begin(), Vec3(3.0, 5.0, -6.0));
+                }
+            }
+            std::cout << "TArray     :" << Clock.GetTotalDuration() / Iterations << "ns" << std::endl;
+        }
+    }
+#endif
+
+#if 1
+    // Emplace
+    {
+        const UInt32 Iterations = 10000;
+        std::cout << std::endl << "Emplace (Iterations=" << Iterations << ", TestCount=" << TestCount << ")" << std::endl;
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                std::vector<Vec3> Vectors0;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Vectors0.emplace(Vectors0.begin(), 3.0, 5.0, -6.0);
+                }
+            }
+
+            std::cout << "std::vector:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                TArray<Vec3> Vectors1;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Vectors1.Emplace(Vectors1.Begin(), double(j + 1), 5.0, -6.0);
+                }
+            }
+            std::cout << "TArray     :" << Clock.GetTotalDuration() / Iterations << "ns" << std::endl;
+        }
+    }
+#endif
+
+#if 1
+    // PushBack
+    {
+        const UInt32 Iterations = 10000;
+        std::cout << std::endl << "PushBack (Iterations=" << Iterations << ", TestCount=" << TestCount << ")" << std::endl;
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                std::vector<Vec3> Vectors0;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Vectors0.push_back(Vec3(3.0, 5.0, -6.0));
+                }
+            }
+
+            std::cout << "std::vector:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                TArray<Vec3> Vectors1;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Vectors1.PushBack(Vec3(3.0, 5.0, -6.0));
+                }
+            }
+            std::cout << "TArray     :" << Clock.GetTotalDuration() / Iterations << "ns" << std::endl;
+        }
+    }
+#endif
+
+#if 1
+    // EmplaceBack
+    {
+        const UInt32 Iterations = 10000;
+        std::cout << std::endl << "EmplaceBack (Iterations=" << Iterations << ", TestCount=" << TestCount << ")" << std::endl;
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                std::vector<Vec3> Vectors0;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Vectors0.emplace_back(3.0, 5.0, -6.0);
+                }
+            }
+
+            std::cout << "std::vector:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                TArray<Vec3> Vectors1;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Vectors1.EmplaceBack(3.0, 5.0, -6.0);
+                }
+            }
+
+            std::cout << "TArray     :" << Clock.GetTotalDuration() / Iterations << "ns" << std::endl;
+        }
+    }
+#endif
+
+    std::cout << std::endl << "Benchmark (Large TArray<UInt64>)" << std::endl;
+
+#if 1
+    // PushBack until the array is larger than 100 MB
+    {
+        const UInt32 Iterations     = 16 * 1024 * 1024;
+        const UInt32 LargeTestCount = 5;
+        std::cout << std::endl << "PushBack (Iterations=" << Iterations << ", Size=" << (Iterations * sizeof(UInt64)) / (1024 * 1024) << "MB, TestCount=" << LargeTestCount << ")" << std::endl;
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < LargeTestCount; i++)
+            {
+                std::vector<UInt64> Numbers0;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Numbers0.push_back(j);
+                }
+            }
+
+            std::cout << "std::vector           :" << Clock.GetTotalDuration() / LargeTestCount << "ns" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < LargeTestCount; i++)
+            {
+                TArray<UInt64, CopyingMallocator> Numbers1;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Numbers1.PushBack(j);
+                }
+            }
+
+            std::cout << "TArray (Copy)         :" << Clock.GetTotalDuration() / LargeTestCount << "ns" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < LargeTestCount; i++)
+            {
+                TArray<UInt64> Numbers2;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Numbers2.PushBack(j);
+                }
+            }
+
+            std::cout << "TArray (Reallocate)   :" << Clock.GetTotalDuration() / LargeTestCount << "ns" << std::endl;
+        }
+    }
+#endif
+
+    std::cout << std::endl << "Benchmark (Relocatable TArray<UInt32>)" << std::endl;
+
+#if 1
+    // Insert
+    {
+        const UInt32 Iterations = 10000;
+        std::cout << std::endl << "Insert (Iterations=" << Iterations << ", TestCount=" << TestCount << ")" << std::endl;
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                std::vector<std::vector<UInt32>> Arrays0;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Arrays0.insert(Arrays0.begin(), std::vector<UInt32>(4, j));
+                }
+            }
+
+            std::cout << "std::vector:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                TArray<TArray<UInt32>> Arrays1;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Arrays1.Insert(Arrays1.Begin(), TArray<UInt32>(4, j));
+                }
+            }
+
+            std::cout << "TArray     :" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+    }
+#endif
+
+#if 1
+    // PushBack
+    {
+        const UInt32 Iterations = 100000;
+        std::cout << std::endl << "PushBack (Iterations=" << Iterations << ", TestCount=" << TestCount << ")" << std::endl;
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                std::vector<std::vector<UInt32>> Arrays0;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Arrays0.push_back(std::vector<UInt32>(4, j));
+                }
+            }
+
+            std::cout << "std::vector:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                TArray<TArray<UInt32>> Arrays1;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Arrays1.PushBack(TArray<UInt32>(4, j));
+                }
+            }
+
+            std::cout << "TArray     :" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+    }
+#endif
+
+    std::cout << std::endl << "Benchmark (Growth policies)" << std::endl << std::endl;
+
+#if 1
+    GrowthPolicyBenchmark<GeometricGrowth>("Geometric       ");
+    GrowthPolicyBenchmark<DoublingGrowth>("Doubling        ");
+    GrowthPolicyBenchmark<TPageRoundedGrowth<>>("PageRounded     ");
+    GrowthPolicyBenchmark<SizeClassGrowth>("SizeClass       ");
+#endif
+
+    std::cout << std::endl << "Benchmark (Per-request allocation)" << std::endl;
+
+#if 1
+    {
+        const UInt32 Iterations = 100000;
+        std::cout << std::endl << "Requests (Iterations=" << Iterations << ", TestCount=" << TestCount << ")" << std::endl;
+
+        UInt64 Sum = 0;
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Sum += ProcessRequest(j, Mallocator());
+                }
+            }
+
+            std::cout << "Mallocator      :" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+
+        {
+            TLinearArena<> Arena;
+
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    TLinearArenaScope<> Scope(Arena);
+                    Sum += ProcessRequest(j, TLinearAllocator<>(Arena));
+                }
+            }
+
+            std::cout << "TLinearAllocator:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+
+        std::cout << "Checksum=" << Sum << std::endl;
+    }
+#endif
+
+    std::cout << std::endl << "Benchmark (Small TArray churn)" << std::endl;
+
+#if 1
+    // Create, fill and destroy small arrays
+    {
+        const UInt32 Iterations  = 1000000;
+        const UInt32 NumElements = 6;
+        std::cout << std::endl << "Churn (Iterations=" << Iterations << ", Elements=" << NumElements << ", TestCount=" << TestCount << ")" << std::endl;
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    TArray<UInt32> Numbers;
+                    for (UInt32 k = 0; k < NumElements; k++)
+                    {
+                        Numbers.PushBack(j + k);
+                    }
+                }
+            }
+
+            std::cout << "TArray         :" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    TInlineArray<UInt32, 8> Numbers;
+                    for (UInt32 k = 0; k < NumElements; k++)
+                    {
+                        Numbers.PushBack(j + k);
+                    }
+                }
+            }
+
+            std::cout << "TInlineArray<8>:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+    }
+#endif
+
+#if 1
+    // Move arrays that have spilled onto the heap
+    {
+        const UInt32 Iterations  = 100000;
+        const UInt32 NumElements = 64;
+        std::cout << std::endl << "Move Heap-backed (Iterations=" << Iterations << ", Elements=" << NumElements << ", TestCount=" << TestCount << ")" << std::endl;
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                TArray<TArray<UInt32>> Arrays0(Iterations, TArray<UInt32>(NumElements, 1u));
+                TArray<TArray<UInt32>> Arrays1(Iterations);
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Arrays1[j] = Move(Arrays0[j]);
+                }
+            }
+
+            std::cout << "TArray         :" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                TArray<TInlineArray<UInt32, 8>> Arrays0(Iterations, TInlineArray<UInt32, 8>(NumElements, 1u));
+                TArray<TInlineArray<UInt32, 8>> Arrays1(Iterations);
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Arrays1[j] = Move(Arrays0[j]);
+                }
+            }
+
+            std::cout << "TInlineArray<8>:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+    }
+#endif
+
+    std::cout << std::endl << "Benchmark (Uninitialized growth)" << std::endl;
+
+#if 1
+    // Refill a reused buffer from a source, as when reading from a file or socket
+    {
+        const UInt32 NumBytes  = 16 * 1024 * 1024;
+        const UInt32 ChunkSize = 64 * 1024;
+        std::cout << std::endl << "Refill (Bytes=" << NumBytes << ", TestCount=" << TestCount << ")" << std::endl;
+
+        TArray<Byte> Source(NumBytes, Byte(7));
+        TArray<Byte> Buffer;
+        Buffer.Reserve(NumBytes);
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                Buffer.Clear();
+                Buffer.Resize(NumBytes);
+                ::memcpy(Buffer.Data(), Source.Data(), NumBytes);
+            }
+
+            std::cout << "Resize             :" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                Buffer.Clear();
+                Buffer.ResizeUninitialized(NumBytes);
+                ::memcpy(Buffer.Data(), Source.Data(), NumBytes);
+            }
+
+            std::cout << "ResizeUninitialized:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
         }
 
         {
             Clock Clock;
             for (UInt32 i = 0; i < TestCount; i++)
             {
-                TArray<std::string> Strings1;
-
                 ScopedClock ScopedClock(Clock);
-                for (UInt32 j = 0; j < Iterations; j++)
+                Buffer.Clear();
+                for (UInt32 Offset = 0; Offset < NumBytes; Offset += ChunkSize)
                 {
-                    Strings1.Emplace(Strings1.begin(), "My name is jeff");
+                    TArrayView<Byte> Chunk = Buffer.AppendUninitialized(ChunkSize);
+                    ::memcpy(Chunk.Data(), Source.Data() + Offset, ChunkSize);
                 }
             }
-            std::cout << "TArray     :" << Clock.GetTotalDuration() / Iterations << "ns" << std::endl;
+
+            std::cout << "AppendUninitialized:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
         }
+
+        std::cout << "Back=" << UInt32(Buffer.Back()) << std::endl;
     }
 #endif
 
+    std::cout << std::endl << "Benchmark (Append)" << std::endl;
+
 #if 1
-    // PushBack
+    // Append ranges that are not pointers, which used to grow one element at a time
     {
-        const UInt32 Iterations = 10000;
-        std::cout << std::endl << "PushBack (Iterations=" << Iterations << ", TestCount=" << TestCount << ")" << std::endl;
+        const UInt32 Iterations  = 10000;
+        const UInt32 NumElements = 1000;
+        std::cout << std::endl << "Append Range (Iterations=" << Iterations << ", Elements=" << NumElements << ", TestCount=" << TestCount << ")" << std::endl;
+
+        std::vector<UInt64> Source(NumElements, 3);
         {
             Clock Clock;
             for (UInt32 i = 0; i < TestCount; i++)
             {
-                std::vector<std::string> Strings0;
-
                 ScopedClock ScopedClock(Clock);
                 for (UInt32 j = 0; j < Iterations; j++)
                 {
-                    Strings0.push_back("My name is jeff");
+                    TArray<UInt64> Numbers;
+                    for (UInt64 Number : Source)
+                    {
+                        Numbers.EmplaceBack(Number);
+                    }
                 }
             }
 
-            std::cout << "std::vector:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+            std::cout << "EmplaceBack:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
         }
 
         {
             Clock Clock;
             for (UInt32 i = 0; i < TestCount; i++)
             {
-                TArray<std::string> Strings1;
-
                 ScopedClock ScopedClock(Clock);
                 for (UInt32 j = 0; j < Iterations; j++)
                 {
-                    Strings1.PushBack("My name is jeff");
+                    TArray<UInt64> Numbers;
+                    Numbers.Append(Source.begin(), Source.end());
                 }
             }
-            std::cout << "TArray     :" << Clock.GetTotalDuration() / Iterations << "ns" << std::endl;
+
+            std::cout << "Append     :" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
         }
     }
 #endif
 
 #if 1
-    // EmplaceBack
+    // Gather strings from many small arrays into one
     {
-        const UInt32 Iterations = 10000;
-        std::cout << std::endl << "EmplaceBack (Iterations=" << Iterations << ", TestCount=" << TestCount << ")" << std::endl;
+        const UInt32 NumArrays   = 1000;
+        const UInt32 NumElements = 100;
+        std::cout << std::endl << "Gather (Arrays=" << NumArrays << ", Elements=" << NumElements << ", TestCount=" << TestCount << ")" << std::endl;
         {
             Clock Clock;
             for (UInt32 i = 0; i < TestCount; i++)
             {
-                std::vector<std::string> Strings0;
+                TArray<TArray<std::string>> Arrays(NumArrays, TArray<std::string>(NumElements, std::string("A string that does not fit inline")));
 
                 ScopedClock ScopedClock(Clock);
-                for (UInt32 j = 0; j < Iterations; j++)
+                TArray<std::string> Gathered;
+                for (TArray<std::string>& Array : Arrays)
                 {
-                    Strings0.emplace_back("My name is jeff");
+                    Gathered.Append(Array);
                 }
             }
 
-            std::cout << "std::vector:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+            std::cout << "Copy Append:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
         }
 
         {
             Clock Clock;
             for (UInt32 i = 0; i < TestCount; i++)
             {
-                TArray<std::string> Strings1;
+                TArray<TArray<std::string>> Arrays(NumArrays, TArray<std::string>(NumElements, std::string("A string that does not fit inline")));
 
                 ScopedClock ScopedClock(Clock);
-                for (UInt32 j = 0; j < Iterations; j++)
+                TArray<std::string> Gathered;
+                for (TArray<std::string>& Array : Arrays)
                 {
-                    Strings1.EmplaceBack("My name is jeff");
+                    Gathered.Append(Move(Array));
                 }
             }
-            std::cout << "TArray     :" << Clock.GetTotalDuration() / Iterations << "ns" << std::endl;
+
+            std::cout << "Move Append:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
         }
     }
 #endif
 
-    std::cout << std::endl << "Benchmark (Vec3)" << std::endl;
+    std::cout << std::endl << "Benchmark (Remove)" << std::endl;
 
-    // Insert
 #if 1
+    // Remove every third element, looped Erase shifts the tail once for every removed element
     {
-        const UInt32 Iterations = 10000;
-        std::cout << std::endl << "Insert (Iterations=" << Iterations << ", TestCount=" << TestCount << ")" << std::endl;
+        const UInt32 NumElements     = 50000;
+        const UInt32 RemoveTestCount = 10;
+        std::cout << std::endl << "Remove Matching (Elements=" << NumElements << ", TestCount=" << RemoveTestCount << ")" << std::endl;
+
+        TArray<std::string> Source;
+        for (UInt32 i = 0; i < NumElements; i++)
+        {
+            Source.EmplaceBack(std::to_string(i % 3) + " is a string that does not fit inline");
+        }
+
+        const std::string Match = "0 is a string that does not fit inline";
         {
             Clock Clock;
-            for (UInt32 i = 0; i < TestCount; i++)
+            for (UInt32 i = 0; i < RemoveTestCount; i++)
             {
-                std::vector<Vec3> Vectors0;
+                TArray<std::string> Strings(Source);
 
                 ScopedClock ScopedClock(Clock);
-                for (UInt32 j = 0; j < Iterations; j++)
+                for (TArray<std::string>::Iterator It = Strings.Begin(); It != Strings.End();)
                 {
-                    Vectors0.insert(Vectors0.begin(), Vec3(3.0, 5.0, -6.0));
+                    if (*It == Match)
+                    {
+                        It = Strings.Erase(It);
+                    }
+                    else
+                    {
+                        It++;
+                    }
                 }
             }
 
-            std::cout << "std::vector:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+            std::cout << "Looped Erase:" << Clock.GetTotalDuration() / RemoveTestCount << "ns" << std::endl;
         }
 
         {
             Clock Clock;
-            for (UInt32 i = 0; i < TestCount; i++)
+            for (UInt32 i = 0; i < RemoveTestCount; i++)
             {
-                TArray<Vec3> Vectors1;
+                TArray<std::string> Strings(Source);
 
                 ScopedClock ScopedClock(Clock);
-                for (UInt32 j = 0; j < Iterations; j++)
-                {
-                    Vectors1.Insert(Vectors1.Begin(), Vec3(3.0, 5.0, -6.0));
-                }
+                Strings.RemoveAll(Match);
             }
-            std::cout << "TArray     :" << Clock.GetTotalDuration() / Iterations << "ns" << std::endl;
+
+            std::cout << "RemoveAll   :" << Clock.GetTotalDuration() / RemoveTestCount << "ns" << std::endl;
         }
     }
 #endif
 
 #if 1
-    // Emplace
+    // Remove elements from the middle when the order does not matter
     {
-        const UInt32 Iterations = 10000;
-        std::cout << std::endl << "Emplace (Iterations=" << Iterations << ", TestCount=" << TestCount << ")" << std::endl;
+        const UInt32 NumElements     = 50000;
+        const UInt32 NumRemoved      = 25000;
+        const UInt32 RemoveTestCount = 10;
+        std::cout << std::endl << "Remove Unordered (Elements=" << NumElements << ", Removed=" << NumRemoved << ", TestCount=" << RemoveTestCount << ")" << std::endl;
         {
             Clock Clock;
-            for (UInt32 i = 0; i < TestCount; i++)
+            for (UInt32 i = 0; i < RemoveTestCount; i++)
             {
-                std::vector<Vec3> Vectors0;
+                TArray<UInt64> Numbers(NumElements, UInt64(1));
 
                 ScopedClock ScopedClock(Clock);
-                for (UInt32 j = 0; j < Iterations; j++)
+                for (UInt32 j = 0; j < NumRemoved; j++)
                 {
-                    Vectors0.emplace(Vectors0.begin(), 3.0, 5.0, -6.0);
+                    Numbers.Erase(Numbers.Begin() + (j * 7919) % Numbers.Size());
                 }
             }
 
-            std::cout << "std::vector:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+            std::cout << "Erase       :" << Clock.GetTotalDuration() / RemoveTestCount << "ns" << std::endl;
         }
 
         {
             Clock Clock;
-            for (UInt32 i = 0; i < TestCount; i++)
+            for (UInt32 i = 0; i < RemoveTestCount; i++)
             {
-                TArray<Vec3> Vectors1;
+                TArray<UInt64> Numbers(NumElements, UInt64(1));
 
                 ScopedClock ScopedClock(Clock);
-                for (UInt32 j = 0; j < Iterations; j++)
+                for (UInt32 j = 0; j < NumRemoved; j++)
                 {
-                    Vectors1.Emplace(Vectors1.Begin(), double(j + 1), 5.0, -6.0);
+                    Numbers.RemoveAtSwap((j * 7919) % Numbers.Size());
                 }
             }
-            std::cout << "TArray     :" << Clock.GetTotalDuration() / Iterations << "ns" << std::endl;
+
+            std::cout << "RemoveAtSwap:" << Clock.GetTotalDuration() / RemoveTestCount << "ns" << std::endl;
         }
     }
 #endif
 
+    std::cout << std::endl << "Benchmark (Fill)" << std::endl;
+
 #if 1
-    // PushBack
+    FillBenchmark<UInt32>("UInt32", 0x01020304);
+    FillBenchmark<UInt32>("UInt32 Zero", 0);
+    FillBenchmark<Vec3>("Vec3", Vec3(1.0, 2.0, 3.0));
+#endif
+
+#if 1
+    // Filling a large array with streaming stores keeps a small working set in the cache
     {
-        const UInt32 Iterations = 10000;
-        std::cout << std::endl << "PushBack (Iterations=" << Iterations << ", TestCount=" << TestCount << ")" << std::endl;
+        const UInt32 NumValues     = 16 * 1024 * 1024;
+        const UInt32 NumWorkValues = 128 * 1024;
+        std::cout << std::endl << "Working set after fill (Values=" << NumValues << ", WorkingSet=" << NumWorkValues << ", TestCount=" << TestCount << ")" << std::endl;
+
+        std::vector<UInt32> WorkingSet(NumWorkValues, 1);
+        UInt64 Sum = 0;
         {
+            std::vector<UInt32> Values(NumValues);
+
             Clock Clock;
             for (UInt32 i = 0; i < TestCount; i++)
             {
-                std::vector<Vec3> Vectors0;
+                Sum += std::accumulate(WorkingSet.begin(), WorkingSet.end(), UInt64(0));
+                std::fill(Values.begin(), Values.end(), 0x01020304u);
 
                 ScopedClock ScopedClock(Clock);
-                for (UInt32 j = 0; j < Iterations; j++)
-                {
-                    Vectors0.push_back(Vec3(3.0, 5.0, -6.0));
-                }
+                Sum += std::accumulate(WorkingSet.begin(), WorkingSet.end(), UInt64(0));
             }
 
-            std::cout << "std::vector:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+            std::cout << "std::fill   :" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
         }
 
         {
+            TArray<UInt32> Values(NumValues);
+
             Clock Clock;
             for (UInt32 i = 0; i < TestCount; i++)
             {
-                TArray<Vec3> Vectors1;
+                Sum += std::accumulate(WorkingSet.begin(), WorkingSet.end(), UInt64(0));
+                Values.Fill(0x01020304u);
 
                 ScopedClock ScopedClock(Clock);
-                for (UInt32 j = 0; j < Iterations; j++)
-                {
-                    Vectors1.PushBack(Vec3(3.0, 5.0, -6.0));
-                }
+                Sum += std::accumulate(WorkingSet.begin(), WorkingSet.end(), UInt64(0));
             }
-            std::cout << "TArray     :" << Clock.GetTotalDuration() / Iterations << "ns" << std::endl;
+
+            std::cout << "TArray::Fill:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
         }
+
+        std::cout << "Sum=" << Sum << std::endl;
     }
 #endif
 
+    std::cout << std::endl << "Benchmark (Tracking allocator)" << std::endl;
+
 #if 1
-    // EmplaceBack
+    // Cost of tracking small arrays that are created and destroyed
     {
-        const UInt32 Iterations = 10000;
-        std::cout << std::endl << "EmplaceBack (Iterations=" << Iterations << ", TestCount=" << TestCount << ")" << std::endl;
+        const UInt32 Iterations  = 1000000;
+        const UInt32 NumElements = 16;
+        std::cout << std::endl << "Churn (Iterations=" << Iterations << ", Elements=" << NumElements << ", TestCount=" << TestCount << ")" << std::endl;
         {
             Clock Clock;
             for (UInt32 i = 0; i < TestCount; i++)
             {
-                std::vector<Vec3> Vectors0;
-
                 ScopedClock ScopedClock(Clock);
                 for (UInt32 j = 0; j < Iterations; j++)
                 {
-                    Vectors0.emplace_back(3.0, 5.0, -6.0);
+                    TArray<UInt32> Numbers;
+                    for (UInt32 k = 0; k < NumElements; k++)
+                    {
+                        Numbers.PushBack(j + k);
+                    }
                 }
             }
 
-            std::cout << "std::vector:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+            std::cout << "Mallocator        :" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
         }
 
         {
             Clock Clock;
             for (UInt32 i = 0; i < TestCount; i++)
             {
-                TArray<Vec3> Vectors1;
-
                 ScopedClock ScopedClock(Clock);
                 for (UInt32 j = 0; j < Iterations; j++)
                 {
-                    Vectors1.EmplaceBack(3.0, 5.0, -6.0);
+                    TArray<UInt32, TTrackingAllocator<Mallocator, BenchmarkArrays>> Numbers;
+                    for (UInt32 k = 0; k < NumElements; k++)
+                    {
+                        Numbers.PushBack(j + k);
+                    }
                 }
             }
 
-            std::cout << "TArray     :" << Clock.GetTotalDuration() / Iterations << "ns" << std::endl;
+            std::cout << "TTrackingAllocator:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
         }
+
+        const MemoryStats Stats = TTrackingAllocator<Mallocator, BenchmarkArrays>::GetStats();
+        std::cout << "Reallocations=" << Stats.NumReallocations << " Current=" << Stats.CurrentBytes << std::endl;
     }
 #endif
 }
@@ -1060,4 +1800,359 @@ void TArray_Test(Int32 Argc, const Char** Argv)
         PrintArr(Vectors2);
     }
 #endif
+#if 1
+    std::cout << std::endl << "Testing relocatable TArray<TArray<UInt32>>" << std::endl << std::endl;
+    {
+        static_assert(TIsTriviallyRelocatable<TArray<UInt32>>, "TArray should be relocatable");
+
+        TArray<TArray<UInt32>> Arrays;
+        for (UInt32 i = 0; i < 8; i++)
+        {
+            Arrays.Insert(Arrays.Begin(), TArray<UInt32>(i + 1, i));
+        }
+
+        Arrays.Emplace(Arrays.Begin() + 2, 3u, 42u);
+        Arrays.Insert(Arrays.Begin() + 1, { TArray<UInt32>(2u, 100u), TArray<UInt32>(1u, 200u) });
+        Arrays.Erase(Arrays.Begin() + 4);
+        Arrays.Erase(Arrays.Begin(), Arrays.Begin() + 2);
+        Arrays.Reserve(32);
+        Arrays.ShrinkToFit();
+
+        for (const TArray<UInt32>& Array : Arrays)
+        {
+            std::cout << "Size=" << Array.Size() << " Front=" << Array.Front() << std::endl;
+        }
+    }
+#endif
+#if 1
+    std::cout << std::endl << "Testing TInlineArray<std::string, 4>" << std::endl << std::endl;
+    {
+        TInlineArray<std::string, 4> Strings0;
+        Strings0.PushBack("Hello");
+        Strings0.PushBack("World");
+        Strings0.Insert(Strings0.Begin(), "Inline");
+        std::cout << "Inline: Size=" << Strings0.Size() << " Capacity=" << Strings0.Capacity() << std::endl;
+
+        // Moving an inline array relocates the elements
+        TInlineArray<std::string, 4> Strings1 = Move(Strings0);
+        std::cout << "Moved Inline: Size=" << Strings1.Size() << " Front=" << Strings1.Front() << " Other Size=" << Strings0.Size() << std::endl;
+
+        // Grow onto the heap
+        for (UInt32 i = 0; i < 6; i++)
+        {
+            Strings1.EmplaceBack(std::to_string(i));
+        }
+
+        const std::string* HeapData = Strings1.Data();
+        TInlineArray<std::string, 4> Strings2 = Move(Strings1);
+        std::cout << "Moved Heap: Size=" << Strings2.Size() << " Stolen=" << (Strings2.Data() == HeapData) << " Other Size=" << Strings1.Size() << std::endl;
+
+        // Shrink back into the inline storage
+        Strings2.Resize(3);
+        Strings2.ShrinkToFit();
+
+        TInlineArray<std::string, 4> Strings3(Strings2);
+        Strings3.Erase(Strings3.Begin());
+        for (const std::string& String : Strings2)
+        {
+            std::cout << String << std::endl;
+        }
+
+        for (const std::string& String : Strings3)
+        {
+            std::cout << String << std::endl;
+        }
+    }
+#endif
+#if 1
+    std::cout << std::endl << "Testing SizeType" << std::endl << std::endl;
+    {
+        TArray<UInt8, TSizedAllocator<UInt16>> SmallArray;
+        TArray<UInt8>                          DefaultArray;
+        TArray64<UInt8>                        LargeArray(UInt64(16), UInt8(1));
+        std::cout << "sizeof(UInt16)=" << sizeof(SmallArray) << " sizeof(UInt32)=" << sizeof(DefaultArray) << " sizeof(UInt64)=" << sizeof(LargeArray) << std::endl;
+        std::cout << "MaxSize(UInt16)=" << SmallArray.MaxSize() << " MaxSize(UInt64)=" << LargeArray.MaxSize() << std::endl;
+
+        // Growth saturates at the largest size the size type can hold
+        for (UInt32 i = 0; i < SmallArray.MaxSize(); i++)
+        {
+            SmallArray.PushBack(UInt8(i));
+        }
+
+        std::cout << "Size=" << SmallArray.Size() << " Capacity=" << SmallArray.Capacity() << " SizeInBytes=" << SmallArray.SizeInBytes() << std::endl;
+
+        TArrayView<UInt8, UInt64> LargeView(LargeArray);
+        std::cout << "View Size=" << LargeView.Size() << " SizeInBytes=" << LargeView.SizeInBytes() << std::endl;
+    }
+#endif
+#if 1
+    std::cout << std::endl << "Testing GrowthPolicy" << std::endl << std::endl;
+    {
+        TArray<UInt32, Mallocator, GeometricGrowth>      Geometric;
+        TArray<UInt32, Mallocator, DoublingGrowth>       Doubling;
+        TArray<UInt32, Mallocator, TPageRoundedGrowth<>> PageRounded;
+        TArray<UInt32, Mallocator, SizeClassGrowth>      SizeClass;
+        for (UInt32 i = 0; i < 5000; i++)
+        {
+            Geometric.PushBack(i);
+            Doubling.PushBack(i);
+            PageRounded.PushBack(i);
+            SizeClass.Insert(SizeClass.Begin(), i);
+        }
+
+        // Policies that round to the usable size depend on the allocator, so only the invariants are printed
+        std::cout << "Geometric:   Size=" << Geometric.Size() << " Capacity=" << Geometric.Capacity() << std::endl;
+        std::cout << "Doubling:    Size=" << Doubling.Size() << " Fits=" << (Doubling.Capacity() >= Doubling.Size()) << " Back=" << Doubling.Back() << std::endl;
+        std::cout << "PageRounded: Size=" << PageRounded.Size() << " Fits=" << (PageRounded.Capacity() >= PageRounded.Size()) << " Back=" << PageRounded.Back() << std::endl;
+        std::cout << "SizeClass:   Size=" << SizeClass.Size() << " Fits=" << (SizeClass.Capacity() >= SizeClass.Size()) << " Front=" << SizeClass.Front() << std::endl;
+    }
+#endif
+#if 1
+    std::cout << std::endl << "Testing Alignment" << std::endl << std::endl;
+    {
+        struct alignas(32) AlignedVec
+        {
+            Float x, y, z, w;
+        };
+
+        TArray<AlignedVec> Vectors;
+        TAlignedArray<Float, 64> Floats;
+        TInlineArray<AlignedVec, 2> InlineVectors;
+
+        Bool IsAligned = true;
+        for (UInt32 i = 0; i < 1000; i++)
+        {
+            Vectors.PushBack({ Float(i), 0.0f, 0.0f, 0.0f });
+            Floats.Insert(Floats.Begin(), Float(i));
+            InlineVectors.EmplaceBack();
+
+            IsAligned = IsAligned && ((reinterpret_cast<UInt64>(Vectors.Data()) % 32) == 0);
+            IsAligned = IsAligned && ((reinterpret_cast<UInt64>(Floats.Data()) % 64) == 0);
+            IsAligned = IsAligned && ((reinterpret_cast<UInt64>(InlineVectors.Data()) % 32) == 0);
+        }
+
+        Floats.ShrinkToFit();
+        IsAligned = IsAligned && ((reinterpret_cast<UInt64>(Floats.Data()) % 64) == 0);
+
+        std::cout << "IsAligned=" << IsAligned << " Back=" << Vectors.Back().x << " Front=" << Floats.Front() << std::endl;
+    }
+#endif
+#if 1
+    std::cout << std::endl << "Testing TLinearAllocator" << std::endl << std::endl;
+    {
+        TLinearArena<> Arena(1024);
+
+        TArray<UInt32, TLinearAllocator<>> Numbers(Arena);
+        for (UInt32 i = 0; i < 100; i++)
+        {
+            Numbers.PushBack(i);
+        }
+
+        const void* FirstAllocation = nullptr;
+        {
+            TLinearArenaScope<> Scope(Arena);
+
+            TArray<std::string, TLinearAllocator<>> Strings({ "Arena", "Strings" }, Arena);
+            FirstAllocation = Strings.Data();
+
+            TArray<std::string, TLinearAllocator<>> MovedStrings(Move(Strings));
+            MovedStrings.EmplaceBack("Moved");
+
+            for (const std::string& String : MovedStrings)
+            {
+                std::cout << String << std::endl;
+            }
+        }
+
+        // Allocations made after rewinding reuse the same memory
+        TArray<UInt64, TLinearAllocator<>> Reused(2u, Arena);
+        std::cout << "Reused=" << (reinterpret_cast<const void*>(Reused.Data()) == FirstAllocation) << std::endl;
+
+        // Larger than a chunk
+        TArray<UInt64, TLinearAllocator<>> Large(UInt32(1000), UInt64(7), Arena);
+        std::cout << "Numbers Size=" << Numbers.Size() << " Back=" << Numbers.Back() << " Large Size=" << Large.Size() << " Back=" << Large.Back() << std::endl;
+
+        Arena.Reset();
+    }
+#endif
+#if 1
+    std::cout << std::endl << "Testing TTrackingAllocator" << std::endl << std::endl;
+    {
+        typedef TTrackingAllocator<Mallocator, TestArrays> TrackedAllocator;
+        {
+            TArray<UInt64, TrackedAllocator> Numbers;
+            Numbers.Reserve(16);
+            for (UInt64 i = 0; i < 64; i++)
+            {
+                Numbers.PushBack(i);
+            }
+
+            TArray<UInt64, TrackedAllocator> Copy(Numbers);
+
+            const MemoryStats Stats = TrackedAllocator::GetStats();
+            std::cout << "Allocations=" << Stats.NumAllocations << " Reallocations=" << Stats.NumReallocations << " Frees=" << Stats.NumFrees << std::endl;
+            std::cout << "Current>=Size=" << (Stats.CurrentBytes >= (Numbers.SizeInBytes() + Copy.SizeInBytes())) << " Peak>=Current=" << (Stats.PeakBytes >= Stats.CurrentBytes) << std::endl;
+        }
+
+        const MemoryStats Stats = TrackedAllocator::GetStats();
+        std::cout << "Allocations=" << Stats.NumAllocations << " Frees=" << Stats.NumFrees << " Current=" << Stats.CurrentBytes << std::endl;
+
+        // Blocks in inline storage are not counted, types without a Name are listed by their type name
+        {
+            TArray<Vec3, TTrackingAllocator<TInlineAllocator<Vec3, 4>, Vec3>> Vectors;
+            Vectors.EmplaceBack(1.0, 2.0, 3.0);
+
+            typedef TTrackingAllocator<TInlineAllocator<Vec3, 4>, Vec3> TrackedVectorAllocator;
+            std::cout << "Inline Allocations=" << TrackedVectorAllocator::GetStats().NumAllocations;
+
+            Vectors.Resize(8);
+            std::cout << " Heap Allocations=" << TrackedVectorAllocator::GetStats().NumAllocations << std::endl;
+        }
+
+        UInt32 NumTags = 0;
+        MemoryTracker::Get().ForEach([&NumTags](const MemoryTag& Tag)
+        {
+            if (std::string(Tag.Name) == TestArrays::Name)
+            {
+                NumTags++;
+            }
+        });
+
+        std::cout << "Registered=" << NumTags << std::endl;
+        MemoryTracker::Get().Dump();
+    }
+#endif
+#if 1
+    std::cout << std::endl << "Testing Uninitialized growth" << std::endl << std::endl;
+    {
+        TArray<UInt32> Numbers;
+        const UInt32 Index = Numbers.AddUninitialized(4);
+        for (UInt32 i = 0; i < 4; i++)
+        {
+            Numbers[Index + i] = i;
+        }
+
+        TArrayView<UInt32> Tail = Numbers.AppendUninitialized(3);
+        for (UInt32& Number : Tail)
+        {
+            Number = 10;
+        }
+
+        std::cout << "Index=" << Index << " Size=" << Numbers.Size() << " TailSize=" << Tail.Size() << " Back=" << Numbers.Back() << std::endl;
+
+        Numbers.ResizeUninitialized(100);
+        Numbers.SetNumUnchecked(5);
+        std::cout << "Size=" << Numbers.Size() << " Capacity>=100=" << (Numbers.Capacity() >= 100) << " Back=" << Numbers.Back() << std::endl;
+
+        // Nothing to append
+        TArrayView<UInt32> Empty = Numbers.AppendUninitialized(0);
+        std::cout << "Empty=" << Empty.IsEmpty() << " Size=" << Numbers.Size() << std::endl;
+    }
+#endif
+#if 1
+    std::cout << std::endl << "Testing Append" << std::endl << std::endl;
+    {
+        // Ranges with iterators that are not pointers
+        std::vector<std::string> Source = { "First", "Second", "Third" };
+
+        TArray<std::string> Strings;
+        Strings.Append(Source.begin(), Source.end());
+        Strings.Insert(Strings.Begin() + 1, Source.begin(), Source.begin() + 2);
+        Strings.Insert(Strings.End(), { "Last" });
+        PrintArr(Strings);
+
+        // Appending an array to itself
+        TArray<UInt32> Numbers = { 1, 2, 3 };
+        Numbers.ShrinkToFit();
+        Numbers.Append(Numbers);
+        Numbers.Append(TArrayView<UInt32>(Numbers));
+        for (UInt32 Number : Numbers)
+        {
+            std::cout << Number << " ";
+        }
+
+        std::cout << std::endl;
+
+        // The buffer is stolen when the array is empty
+        TArray<std::string> Moved;
+        const std::string* StolenData = Strings.Data();
+        Moved.Append(Move(Strings));
+        std::cout << "Stolen=" << (Moved.Data() == StolenData) << " Size=" << Moved.Size() << " Other Size=" << Strings.Size() << std::endl;
+
+        TArray<std::string> Other = { "Moved #1", "Moved #2" };
+        TArray<std::string>::Iterator It = Moved.Append(Move(Other));
+        std::cout << "First=" << *It << " Size=" << Moved.Size() << " Other Size=" << Other.Size() << std::endl;
+
+        std::string ViewStrings[] = { "View #1", "View #2" };
+        Moved.MoveAppend(TArrayView<std::string>(ViewStrings));
+        std::cout << "Back=" << Moved.Back() << " Source Empty=" << ViewStrings[1].empty() << std::endl;
+    }
+#endif
+#if 1
+    std::cout << std::endl << "Testing Remove" << std::endl << std::endl;
+    {
+        TArray<std::string> Strings = { "Keep #1", "Remove", "Keep #2", "Remove", "Remove", "Keep #3" };
+        const UInt32 NumRemoved = Strings.RemoveAll("Remove");
+        std::cout << "Removed=" << NumRemoved << std::endl;
+        PrintArr(Strings);
+
+        Strings.RemoveAtSwap(0);
+        PrintArr(Strings);
+
+        // Removing the last element
+        Strings.RemoveAtSwap(Strings.LastIndex());
+        PrintArr(Strings);
+
+        TArray<UInt32> Numbers = { 1, 2, 3, 4, 5, 6, 7, 8 };
+        std::cout << "Removed Odd=" << Numbers.RemoveIf([](UInt32 Number) { return (Number % 2) != 0; }) << " None=" << Numbers.RemoveAll(100) << std::endl;
+
+        Numbers.RemoveAtSwap(0);
+        for (UInt32 Number : Numbers)
+        {
+            std::cout << Number << " ";
+        }
+
+        std::cout << std::endl;
+    }
+#endif
+#if 1
+    std::cout << std::endl << "Testing Fill" << std::endl << std::endl;
+    {
+        // Sizes around the cache line, the pattern and the streaming threshold, starting at unaligned offsets
+        const UInt32 Sizes[]   = { 0, 1, 7, 64, 100, 1000, 4099, 300000, 1100000 };
+        const UInt32 Offsets[] = { 0, 1, 3 };
+
+        Bool Passed = true;
+        for (UInt32 Size : Sizes)
+        {
+            for (UInt32 Offset : Offsets)
+            {
+                TArray<UInt32> Numbers(Offset, 7);
+                Numbers.Resize(Offset + Size, 0x01020304);
+
+                TArray<Vec3> Vectors(Offset, Vec3(7.0, 7.0, 7.0));
+                Vectors.Resize(Offset + Size, Vec3(1.0, 2.0, 3.0));
+
+                for (UInt32 Index = 0; Index < Numbers.Size(); Index++)
+                {
+                    Passed = Passed && (Numbers[Index] == ((Index < Offset) ? 7u : 0x01020304u));
+                    Passed = Passed && (Vectors[Index] == ((Index < Offset) ? Vec3(7.0, 7.0, 7.0) : Vec3(1.0, 2.0, 3.0)));
+                }
+
+                Numbers.Fill(0);
+                Vectors.Fill(Vec3(4.0, 5.0, 6.0));
+                for (UInt32 Index = 0; Index < Numbers.Size(); Index++)
+                {
+                    Passed = Passed && (Numbers[Index] == 0) && (Vectors[Index] == Vec3(4.0, 5.0, 6.0));
+                }
+            }
+        }
+
+        TArray<std::string> Strings(3, "Fill");
+        Strings.Fill("Filled");
+        PrintArr(Strings);
+
+        std::cout << "Passed=" << Passed << std::endl;
+    }
+#endif
 }
@@ -0,0 +1,300 @@
+#include "TDeque_Test.h"
+
+#include "Clock.h"
+
+#include "../Containers/Deque.h"
+#include "../Containers/Array.h"
+
+#include <deque>
+#include <iostream>
+#include <string>
+
+/*
+ * PrintDeque
+ */
+
+template<typename T>
+void PrintDeque(const TDeque<T>& Deque, const std::string& Name = "")
+{
+    std::cout << Name << std::endl;
+    std::cout << "--------------------------------" << std::endl;
+
+    for (const T& Element : Deque)
+    {
+        std::cout << Element << std::endl;
+    }
+
+    std::cout << "Size: " << Deque.Size() << std::endl;
+    std::cout << "Capacity: " << Deque.Capacity() << std::endl;
+
+    std::cout << "--------------------------------" << std::endl << std::endl;
+}
+#define PrintDeque(Deque) PrintDeque(Deque, #Deque)
+
+/*
+ * Benchmark
+ */
+
+void TDeque_Benchmark()
+{
+    std::cout << std::endl << "Benchmark (TDeque)" << std::endl;
+    const UInt32 TestCount = 100;
+
+#if 1
+    // Insert at the front, which is O(n) for each insert into an array
+    {
+        const UInt32 Iterations = 10000;
+        std::cout << std::endl << "Insert Front (Iterations=" << Iterations << ", TestCount=" << TestCount << ")" << std::endl;
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                TArray<std::string> Strings;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Strings.Insert(Strings.Begin(), "My name is jeff");
+                }
+            }
+
+            std::cout << "TArray    :" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                std::deque<std::string> Strings;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Strings.emplace_front("My name is jeff");
+                }
+            }
+
+            std::cout << "std::deque:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                TDeque<std::string> Strings;
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Strings.EmplaceFront("My name is jeff");
+                }
+            }
+
+            std::cout << "TDeque    :" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+    }
+#endif
+
+#if 1
+    // Work queue that stays at a steady size, items are pushed at the back and popped from the front
+    {
+        const UInt32 Iterations = 1000000;
+        const UInt32 QueueSize  = 256;
+        std::cout << std::endl << "Queue (Iterations=" << Iterations << ", Size=" << QueueSize << ", TestCount=" << TestCount << ")" << std::endl;
+        {
+            Clock Clock;
+            UInt64 Sum = 0;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                std::deque<UInt64> Queue(QueueSize, 1);
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Sum += Queue.front();
+                    Queue.pop_front();
+                    Queue.push_back(j);
+                }
+            }
+
+            std::cout << "std::deque:" << Clock.GetTotalDuration() / TestCount << "ns (Sum=" << Sum << ")" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            UInt64 Sum = 0;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                TDeque<UInt64> Queue;
+                for (UInt32 j = 0; j < QueueSize; j++)
+                {
+                    Queue.PushBack(1);
+                }
+
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    Sum += Queue.Front();
+                    Queue.PopFront();
+                    Queue.PushBack(j);
+                }
+            }
+
+            std::cout << "TDeque    :" << Clock.GetTotalDuration() / TestCount << "ns (Sum=" << Sum << ")" << std::endl;
+        }
+    }
+#endif
+
+#if 1
+    // Random access into a deque that has wrapped around
+    {
+        const UInt32 NumElements = 1000000;
+        std::cout << std::endl << "Random Access (Elements=" << NumElements << ", TestCount=" << TestCount << ")" << std::endl;
+
+        std::deque<UInt32> StdQueue;
+        TDeque<UInt32>     Queue;
+        for (UInt32 i = 0; i < NumElements; i++)
+        {
+            StdQueue.push_front(i);
+            Queue.PushFront(i);
+        }
+
+        {
+            Clock Clock;
+            UInt64 Sum = 0;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < NumElements; j++)
+                {
+                    Sum += StdQueue[j];
+                }
+            }
+
+            std::cout << "std::deque:" << Clock.GetTotalDuration() / TestCount << "ns (Sum=" << Sum << ")" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            UInt64 Sum = 0;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 j = 0; j < NumElements; j++)
+                {
+                    Sum += Queue[j];
+                }
+            }
+
+            std::cout << "TDeque    :" << Clock.GetTotalDuration() / TestCount << "ns (Sum=" << Sum << ")" << std::endl;
+        }
+
+        // The segments are contiguous, so they can be iterated without wrapping the index
+        {
+            Clock Clock;
+            UInt64 Sum = 0;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 Element : Queue.GetFirstSegment())
+                {
+                    Sum += Element;
+                }
+
+                for (UInt32 Element : Queue.GetSecondSegment())
+                {
+                    Sum += Element;
+                }
+            }
+
+            std::cout << "Segments  :" << Clock.GetTotalDuration() / TestCount << "ns (Sum=" << Sum << ")" << std::endl;
+        }
+    }
+#endif
+}
+
+/*
+ * Test
+ */
+
+void TDeque_Test()
+{
+    std::cout << std::endl << "----------TDeque----------" << std::endl << std::endl;
+
+    std::cout << "Testing PushBack/PushFront" << std::endl;
+    TDeque<std::string> Strings;
+    Strings.PushBack("Back #1");
+    Strings.PushFront("Front #1");
+    Strings.EmplaceBack("Back #2");
+    Strings.EmplaceFront("Front #2");
+    Strings.PushFront("Front #3");
+    PrintDeque(Strings);
+
+    std::cout << "Testing PopBack/PopFront" << std::endl;
+    Strings.PopBack();
+    Strings.PopFront();
+    PrintDeque(Strings);
+
+    std::cout << "Testing Front/Back/At" << std::endl;
+    std::cout << "Front=" << Strings.Front() << " Back=" << Strings.Back() << " [1]=" << Strings[1] << std::endl;
+
+    std::cout << "Testing Wrap Around" << std::endl;
+    TDeque<UInt32> Numbers;
+    for (UInt32 i = 0; i < 6; i++)
+    {
+        Numbers.PushBack(i);
+    }
+
+    for (UInt32 i = 0; i < 4; i++)
+    {
+        Numbers.PopFront();
+        Numbers.PushBack(6 + i);
+    }
+
+    TArrayView<UInt32> First  = Numbers.GetFirstSegment();
+    TArrayView<UInt32> Second = Numbers.GetSecondSegment();
+    std::cout << "Capacity=" << Numbers.Capacity() << " First=" << First.Size() << " Second=" << Second.Size() << std::endl;
+    PrintDeque(Numbers);
+
+    TArrayView<UInt32> All = Numbers.MakeContiguous();
+    std::cout << "Contiguous Size=" << All.Size() << " Second=" << Numbers.GetSecondSegment().Size() << " Front=" << All.Front() << " Back=" << All.Back() << std::endl;
+
+    std::cout << "Testing Grow While Wrapped" << std::endl;
+    for (UInt32 i = 0; i < 3; i++)
+    {
+        Numbers.PopFront();
+        Numbers.PushFront(100 + i);
+    }
+
+    for (UInt32 i = 0; i < 10; i++)
+    {
+        Numbers.PushFront(200 + i);
+    }
+
+    UInt32 Index = 0;
+    Bool IsOrdered = true;
+    for (TDeque<UInt32>::Iterator It = Numbers.Begin(); It != Numbers.End(); It++)
+    {
+        IsOrdered = IsOrdered && (*It == Numbers[Index++]);
+    }
+
+    std::cout << "Size=" << Numbers.Size() << " Front=" << Numbers.Front() << " Back=" << Numbers.Back() << " IsOrdered=" << IsOrdered << std::endl;
+
+    std::cout << "Testing Copy/Move" << std::endl;
+    TDeque<std::string> Copy(Strings);
+    TDeque<std::string> Moved(Move(Strings));
+    Copy.PushFront("Copy Front");
+    PrintDeque(Copy);
+    PrintDeque(Moved);
+    std::cout << "Moved From Size=" << Strings.Size() << std::endl;
+
+    Strings = { "List #1", "List #2" };
+    Moved   = Copy;
+    std::string Popped;
+    while (Moved.TryPopFront(Popped))
+    {
+        std::cout << "Popped=" << Popped << std::endl;
+    }
+
+    PrintDeque(Strings);
+}
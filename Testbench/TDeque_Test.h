@@ -0,0 +1,4 @@
+#pragma once
+
+void TDeque_Benchmark();
+void TDeque_Test();
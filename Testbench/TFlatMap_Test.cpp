@@ -0,0 +1,349 @@
+#include "TFlatMap_Test.h"
+
+#include "Clock.h"
+
+#include "../Containers/FlatMap.h"
+#include "../Containers/Array.h"
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+/*
+ * PrintFlatMap
+ */
+
+template<typename TKey, typename TValue>
+void PrintFlatMap(const TFlatMap<TKey, TValue>& Map, const std::string& Name = "")
+{
+    std::cout << Name << std::endl;
+    std::cout << "--------------------------------" << std::endl;
+
+    for (auto Pair : Map)
+    {
+        std::cout << Pair.Key << " = " << Pair.Value << std::endl;
+    }
+
+    std::cout << "Size: " << Map.Size() << std::endl;
+    std::cout << "--------------------------------" << std::endl << std::endl;
+}
+#define PrintFlatMap(Map) PrintFlatMap(Map, #Map)
+
+template<typename TKey>
+void PrintFlatSet(const TFlatSet<TKey>& Set, const std::string& Name = "")
+{
+    std::cout << Name << std::endl;
+    std::cout << "--------------------------------" << std::endl;
+
+    for (const TKey& Key : Set)
+    {
+        std::cout << Key << std::endl;
+    }
+
+    std::cout << "Size: " << Set.Size() << std::endl;
+    std::cout << "--------------------------------" << std::endl << std::endl;
+}
+#define PrintFlatSet(Set) PrintFlatSet(Set, #Set)
+
+/*
+ * Benchmark
+ */
+
+// Keys that are spread out, so that inserting them in order is not a special case
+static UInt32 GetScatteredKey(UInt32 Index)
+{
+    return (Index * 2654435761u) ^ 0x5bd1e995u;
+}
+
+void TFlatMap_Benchmark()
+{
+    std::cout << std::endl << "Benchmark (TFlatMap)" << std::endl;
+    const UInt32 TestCount = 100;
+
+#if 1
+    // Lookups in a read-heavy table
+    {
+        const UInt32 NumElements = 4096;
+        const UInt32 NumLookups  = 1000000;
+        std::cout << std::endl << "Find (Elements=" << NumElements << ", Lookups=" << NumLookups << ", TestCount=" << TestCount << ")" << std::endl;
+
+        TArray<UInt32> Lookups;
+        Lookups.Reserve(NumLookups);
+        for (UInt32 i = 0; i < NumLookups; i++)
+        {
+            Lookups.PushBack(GetScatteredKey((i * 7919u) % (NumElements * 2)));
+        }
+
+        {
+            TArray<UInt32> Keys;
+            TArray<UInt64> Values;
+            for (UInt32 i = 0; i < NumElements; i++)
+            {
+                Keys.PushBack(GetScatteredKey(i));
+                Values.PushBack(i);
+            }
+
+            TFlatMap<UInt32, UInt64> Map(::Move(Keys), ::Move(Values));
+
+            Clock  Clock;
+            UInt64 Sum = 0;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 Key : Lookups)
+                {
+                    const UInt64* Value = Map.Find(Key);
+                    Sum += Value ? *Value : 0;
+                }
+            }
+
+            std::cout << "TFlatMap          :" << Clock.GetTotalDuration() / TestCount << "ns (Sum=" << Sum << ")" << std::endl;
+        }
+
+        {
+            std::map<UInt32, UInt64> Map;
+            for (UInt32 i = 0; i < NumElements; i++)
+            {
+                Map.emplace(GetScatteredKey(i), i);
+            }
+
+            Clock  Clock;
+            UInt64 Sum = 0;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 Key : Lookups)
+                {
+                    auto It = Map.find(Key);
+                    Sum += (It != Map.end()) ? It->second : 0;
+                }
+            }
+
+            std::cout << "std::map          :" << Clock.GetTotalDuration() / TestCount << "ns (Sum=" << Sum << ")" << std::endl;
+        }
+
+        {
+            std::unordered_map<UInt32, UInt64> Map;
+            for (UInt32 i = 0; i < NumElements; i++)
+            {
+                Map.emplace(GetScatteredKey(i), i);
+            }
+
+            Clock  Clock;
+            UInt64 Sum = 0;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                for (UInt32 Key : Lookups)
+                {
+                    auto It = Map.find(Key);
+                    Sum += (It != Map.end()) ? It->second : 0;
+                }
+            }
+
+            std::cout << "std::unordered_map:" << Clock.GetTotalDuration() / TestCount << "ns (Sum=" << Sum << ")" << std::endl;
+        }
+    }
+#endif
+
+#if 1
+    // Building the table
+    {
+        const UInt32 NumElements = 4096;
+        std::cout << std::endl << "Construct (Elements=" << NumElements << ", TestCount=" << TestCount << ")" << std::endl;
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+
+                TFlatMap<UInt32, UInt64> Map;
+                for (UInt32 j = 0; j < NumElements; j++)
+                {
+                    Map.Add(GetScatteredKey(j), j);
+                }
+            }
+
+            std::cout << "TFlatMap (Add)    :" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+
+                TArray<UInt32> Keys;
+                TArray<UInt64> Values;
+                Keys.Reserve(NumElements);
+                Values.Reserve(NumElements);
+                for (UInt32 j = 0; j < NumElements; j++)
+                {
+                    Keys.PushBack(GetScatteredKey(j));
+                    Values.PushBack(j);
+                }
+
+                TFlatMap<UInt32, UInt64> Map(::Move(Keys), ::Move(Values));
+            }
+
+            std::cout << "TFlatMap (Bulk)   :" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+
+                TFlatMap<UInt32, UInt64> Map;
+                for (UInt32 j = 0; j < NumElements; j += 256)
+                {
+                    TArray<UInt32> Keys;
+                    TArray<UInt64> Values;
+                    for (UInt32 k = j; k < j + 256; k++)
+                    {
+                        Keys.PushBack(GetScatteredKey(k));
+                        Values.PushBack(k);
+                    }
+
+                    Map.Merge(::Move(Keys), ::Move(Values));
+                }
+            }
+
+            std::cout << "TFlatMap (Merge)  :" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+
+                std::map<UInt32, UInt64> Map;
+                for (UInt32 j = 0; j < NumElements; j++)
+                {
+                    Map.emplace(GetScatteredKey(j), j);
+                }
+            }
+
+            std::cout << "std::map          :" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+    }
+#endif
+}
+
+/*
+ * Test
+ */
+
+// Compares std::string with string literals without constructing a std::string
+struct StringLess
+{
+    Bool operator()(const std::string& Lhs, const std::string& Rhs) const noexcept { return Lhs < Rhs; }
+    Bool operator()(const std::string& Lhs, const Char* Rhs) const noexcept { return Lhs.compare(Rhs) < 0; }
+    Bool operator()(const Char* Lhs, const std::string& Rhs) const noexcept { return Rhs.compare(Lhs) > 0; }
+};
+
+void TFlatMap_Test()
+{
+    std::cout << std::endl << "----------TFlatMap----------" << std::endl << std::endl;
+
+    std::cout << "Testing Add/Emplace" << std::endl;
+    TFlatMap<Int32, std::string> Map;
+    Map.Add(5, "Five");
+    Map.Add(1, "One");
+    Map.Add(3, "Three");
+    Map.Emplace(2, "Two");
+    Map.Emplace(3, "Not Three");
+    Map.Add(4, "Four");
+    Map.Add(1, "Uno");
+    Map[6] = "Six";
+    PrintFlatMap(Map);
+
+    std::cout << "Testing Find/Contains" << std::endl;
+    {
+        const std::string* Value = Map.Find(3);
+        std::cout << "Find(3)=" << (Value ? *Value : "null") << " Find(7)=" << (Map.Find(7) ? "found" : "null") << std::endl;
+        std::cout << "Contains(4)=" << Map.Contains(4) << " Contains(0)=" << Map.Contains(0) << " IndexOf(5)=" << Map.IndexOf(5) << " At(2)=" << Map.At(2) << std::endl;
+    }
+
+    std::cout << "Testing LowerBound" << std::endl;
+    {
+        TFlatSet<Int32> Odd = { 1, 3, 5, 7, 9, 11, 13 };
+        for (Int32 Key = 0; Key <= 14; Key++)
+        {
+            std::cout << Odd.LowerBound(Key) << " ";
+        }
+
+        std::cout << std::endl;
+    }
+
+    std::cout << "Testing Remove" << std::endl;
+    Map.Remove(4);
+    Map.Remove(10);
+    Map.RemoveAt(0);
+    PrintFlatMap(Map);
+
+    std::cout << "Testing Bulk Construct" << std::endl;
+    {
+        TArray<std::string> Keys   = { "Delta", "Alpha", "Charlie", "Bravo", "Alpha", "Echo" };
+        TArray<Int32>       Values = { 4, 1, 3, 2, 10, 5 };
+        TFlatMap<std::string, Int32> Letters(::Move(Keys), ::Move(Values));
+        PrintFlatMap(Letters);
+
+        // Heterogeneous lookup with a comparison that accepts string literals
+        TArray<std::string> Names = { "Jeff", "Anna", "Bob" };
+        TFlatSet<std::string, StringLess> NameSet(::Move(Names));
+        std::cout << "Contains(\"Anna\")=" << NameSet.Contains("Anna") << " Contains(\"Carl\")=" << NameSet.Contains("Carl") << std::endl;
+    }
+
+    std::cout << "Testing Merge" << std::endl;
+    {
+        TFlatMap<Int32, Int32> Merged;
+        Merged.Merge(TArray<Int32>({ 10, 20, 30 }), TArray<Int32>({ 1, 2, 3 }));
+        Merged.Merge(TArray<Int32>({ 40, 50 }), TArray<Int32>({ 4, 5 }));
+        Merged.Merge(TArray<Int32>({ 35, 5, 20, 60 }), TArray<Int32>({ 35, 0, 200, 6 }));
+        PrintFlatMap(Merged);
+
+        TFlatSet<Int32> Set = { 8, 2, 6, 4, 2 };
+        Set.Add(5);
+        Set.Add(6);
+        Set.Merge(TArray<Int32>({ 9, 1, 4, 7, 3, 3 }));
+        Set.Remove(5);
+        PrintFlatSet(Set);
+    }
+
+    std::cout << "Testing Large" << std::endl;
+    {
+        TArray<UInt32> Keys;
+        TArray<UInt32> Values;
+        for (UInt32 i = 0; i < 10000; i++)
+        {
+            Keys.PushBack((i * 7919u) % 10007u);
+            Values.PushBack(i);
+        }
+
+        TFlatMap<UInt32, UInt32> Large(::Move(Keys), ::Move(Values));
+
+        Bool IsValid = IsSorted(Large.GetKeys());
+        for (UInt32 i = 0; i < 10000; i++)
+        {
+            const UInt32* Value = Large.Find((i * 7919u) % 10007u);
+            IsValid = IsValid && Value && (*Value == i);
+        }
+
+        std::cout << "Size=" << Large.Size() << " IsValid=" << IsValid << " Contains(10006)=" << Large.Contains(10006u) << std::endl;
+    }
+
+    std::cout << "Testing Copy/Move" << std::endl;
+    {
+        TFlatMap<Int32, std::string> Copy(Map);
+        TFlatMap<Int32, std::string> Moved(::Move(Copy));
+        Moved.Add(0, "Zero");
+        PrintFlatMap(Moved);
+        std::cout << "Copy.Size()=" << Copy.Size() << " Map.Size()=" << Map.Size() << std::endl;
+    }
+}
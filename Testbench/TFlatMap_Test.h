@@ -0,0 +1,4 @@
+#pragma once
+
+void TFlatMap_Benchmark();
+void TFlatMap_Test();
@@ -0,0 +1,384 @@
+#include "THashMap_Test.h"
+
+#include "Clock.h"
+
+#include "../Containers/HashMap.h"
+#include "../Containers/Array.h"
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+/*
+ * PrintHashMap - Sorted by key, since the order of a hash map depends on the hash function
+ */
+
+template<typename TKey, typename TValue, typename THasher>
+void PrintHashMap(const THashMap<TKey, TValue, THasher>& Map, const std::string& Name = "")
+{
+    std::cout << Name << std::endl;
+    std::cout << "--------------------------------" << std::endl;
+
+    std::map<TKey, TValue> Sorted;
+    for (auto Pair : Map)
+    {
+        Sorted.emplace(Pair.Key, Pair.Value);
+    }
+
+    for (const auto& Pair : Sorted)
+    {
+        std::cout << Pair.first << " = " << Pair.second << std::endl;
+    }
+
+    std::cout << "Size: " << Map.Size() << std::endl;
+    std::cout << "Capacity: " << Map.Capacity() << std::endl;
+    std::cout << "--------------------------------" << std::endl << std::endl;
+}
+#define PrintHashMap(Map) PrintHashMap(Map, #Map)
+
+/*
+ * Benchmark
+ */
+
+// Keys that are spread out, so that the benchmark does not depend on the hash function of std::unordered_map
+static UInt64 GetRandomKey(UInt64 Index)
+{
+    return HashInteger(Index + 0x9E3779B97F4A7C15ull);
+}
+
+void THashMap_Benchmark()
+{
+    std::cout << std::endl << "Benchmark (THashMap)" << std::endl;
+    const UInt32 TestCount   = 10;
+    const UInt32 NumElements = 1000000;
+
+#if 1
+    {
+        std::cout << std::endl << "UInt64 Keys (Elements=" << NumElements << ", TestCount=" << TestCount << ")" << std::endl;
+
+        Clock InsertClock;
+        Clock ReserveClock;
+        Clock HitClock;
+        Clock MissClock;
+        Clock RemoveClock;
+        UInt64 Sum = 0;
+        for (UInt32 i = 0; i < TestCount; i++)
+        {
+            THashMap<UInt64, UInt64> Map;
+            {
+                ScopedClock ScopedClock(InsertClock);
+                for (UInt64 j = 0; j < NumElements; j++)
+                {
+                    Map.Add(GetRandomKey(j), j);
+                }
+            }
+
+            {
+                THashMap<UInt64, UInt64> Reserved;
+
+                ScopedClock ScopedClock(ReserveClock);
+                Reserved.Reserve(NumElements);
+                for (UInt64 j = 0; j < NumElements; j++)
+                {
+                    Reserved.Add(GetRandomKey(j), j);
+                }
+            }
+
+            {
+                ScopedClock ScopedClock(HitClock);
+                for (UInt64 j = 0; j < NumElements; j++)
+                {
+                    Sum += *Map.Find(GetRandomKey(j));
+                }
+            }
+
+            {
+                ScopedClock ScopedClock(MissClock);
+                for (UInt64 j = NumElements; j < NumElements * 2; j++)
+                {
+                    Sum += Map.Contains(GetRandomKey(j)) ? 1 : 0;
+                }
+            }
+
+            {
+                ScopedClock ScopedClock(RemoveClock);
+                for (UInt64 j = 0; j < NumElements; j++)
+                {
+                    Map.Remove(GetRandomKey(j));
+                }
+            }
+        }
+
+        std::cout << "THashMap Insert           :" << InsertClock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        std::cout << "THashMap Insert (Reserved):" << ReserveClock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        std::cout << "THashMap Hit              :" << HitClock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        std::cout << "THashMap Miss             :" << MissClock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        std::cout << "THashMap Remove           :" << RemoveClock.GetTotalDuration() / TestCount << "ns (Sum=" << Sum << ")" << std::endl;
+    }
+
+    {
+        Clock InsertClock;
+        Clock ReserveClock;
+        Clock HitClock;
+        Clock MissClock;
+        Clock RemoveClock;
+        UInt64 Sum = 0;
+        for (UInt32 i = 0; i < TestCount; i++)
+        {
+            std::unordered_map<UInt64, UInt64> Map;
+            {
+                ScopedClock ScopedClock(InsertClock);
+                for (UInt64 j = 0; j < NumElements; j++)
+                {
+                    Map[GetRandomKey(j)] = j;
+                }
+            }
+
+            {
+                std::unordered_map<UInt64, UInt64> Reserved;
+
+                ScopedClock ScopedClock(ReserveClock);
+                Reserved.reserve(NumElements);
+                for (UInt64 j = 0; j < NumElements; j++)
+                {
+                    Reserved[GetRandomKey(j)] = j;
+                }
+            }
+
+            {
+                ScopedClock ScopedClock(HitClock);
+                for (UInt64 j = 0; j < NumElements; j++)
+                {
+                    Sum += Map.find(GetRandomKey(j))->second;
+                }
+            }
+
+            {
+                ScopedClock ScopedClock(MissClock);
+                for (UInt64 j = NumElements; j < NumElements * 2; j++)
+                {
+                    Sum += (Map.find(GetRandomKey(j)) != Map.end()) ? 1 : 0;
+                }
+            }
+
+            {
+                ScopedClock ScopedClock(RemoveClock);
+                for (UInt64 j = 0; j < NumElements; j++)
+                {
+                    Map.erase(GetRandomKey(j));
+                }
+            }
+        }
+
+        std::cout << "std::unordered_map Insert           :" << InsertClock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        std::cout << "std::unordered_map Insert (Reserved):" << ReserveClock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        std::cout << "std::unordered_map Hit              :" << HitClock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        std::cout << "std::unordered_map Miss             :" << MissClock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        std::cout << "std::unordered_map Remove           :" << RemoveClock.GetTotalDuration() / TestCount << "ns (Sum=" << Sum << ")" << std::endl;
+    }
+#endif
+
+#if 1
+    // String keys
+    {
+        const UInt32 NumStrings = 100000;
+        std::cout << std::endl << "std::string Keys (Elements=" << NumStrings << ", TestCount=" << TestCount << ")" << std::endl;
+
+        TArray<std::string> Keys;
+        for (UInt32 i = 0; i < NumStrings; i++)
+        {
+            Keys.EmplaceBack("Key number " + std::to_string(GetRandomKey(i)));
+        }
+
+        {
+            Clock InsertClock;
+            Clock HitClock;
+            UInt64 Sum = 0;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                THashMap<std::string, UInt32> Map;
+                {
+                    ScopedClock ScopedClock(InsertClock);
+                    for (UInt32 j = 0; j < NumStrings; j++)
+                    {
+                        Map.Add(Keys[j], j);
+                    }
+                }
+
+                ScopedClock ScopedClock(HitClock);
+                for (UInt32 j = 0; j < NumStrings; j++)
+                {
+                    Sum += *Map.Find(Keys[j]);
+                }
+            }
+
+            std::cout << "THashMap Insert:" << InsertClock.GetTotalDuration() / TestCount << "ns" << std::endl;
+            std::cout << "THashMap Hit   :" << HitClock.GetTotalDuration() / TestCount << "ns (Sum=" << Sum << ")" << std::endl;
+        }
+
+        {
+            Clock InsertClock;
+            Clock HitClock;
+            UInt64 Sum = 0;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                std::unordered_map<std::string, UInt32> Map;
+                {
+                    ScopedClock ScopedClock(InsertClock);
+                    for (UInt32 j = 0; j < NumStrings; j++)
+                    {
+                        Map[Keys[j]] = j;
+                    }
+                }
+
+                ScopedClock ScopedClock(HitClock);
+                for (UInt32 j = 0; j < NumStrings; j++)
+                {
+                    Sum += Map.find(Keys[j])->second;
+                }
+            }
+
+            std::cout << "std::unordered_map Insert:" << InsertClock.GetTotalDuration() / TestCount << "ns" << std::endl;
+            std::cout << "std::unordered_map Hit   :" << HitClock.GetTotalDuration() / TestCount << "ns (Sum=" << Sum << ")" << std::endl;
+        }
+    }
+#endif
+}
+
+/*
+ * Test
+ */
+
+// Hashes string literals the same as std::string, so that they can be looked up without constructing a std::string
+struct StringHasher
+{
+    UInt64 operator()(const std::string& String) const noexcept { return (*this)(String.c_str()); }
+
+    UInt64 operator()(const Char* String) const noexcept
+    {
+        UInt64 Hash = 0xcbf29ce484222325ull;
+        for (; *String; String++)
+        {
+            Hash = (Hash ^ UInt8(*String)) * 0x100000001b3ull;
+        }
+
+        return HashInteger(Hash);
+    }
+};
+
+// Puts all keys into a few home slots at the end of the table, so that probe sequences are long and wrap around
+struct CollidingHasher
+{
+    UInt64 operator()(UInt32 Key) const noexcept { return (0xFFFFFFF8ull + (Key % 8)) | (UInt64(Key % 3) << 57); }
+};
+
+void THashMap_Test()
+{
+    std::cout << std::endl << "----------THashMap----------" << std::endl << std::endl;
+
+    std::cout << "Testing Add/Emplace" << std::endl;
+    THashMap<Int32, std::string> Map;
+    Map.Add(5, "Five");
+    Map.Add(1, "One");
+    Map.Add(3, "Three");
+    Map.Emplace(2, "Two");
+    Map.Emplace(3, "Not Three");
+    Map.Add(4, "Four");
+    Map.Add(1, "Uno");
+    Map[6] = "Six";
+    PrintHashMap(Map);
+
+    std::cout << "Testing Find/Contains" << std::endl;
+    {
+        const std::string* Value = Map.Find(3);
+        std::cout << "Find(3)=" << (Value ? *Value : "null") << " Find(7)=" << (Map.Find(7) ? "found" : "null") << std::endl;
+        std::cout << "Contains(4)=" << Map.Contains(4) << " Contains(0)=" << Map.Contains(0) << " At(2)=" << Map.At(2) << std::endl;
+    }
+
+    std::cout << "Testing Remove" << std::endl;
+    std::cout << "Remove(4)=" << Map.Remove(4) << " Remove(10)=" << Map.Remove(10) << std::endl;
+    PrintHashMap(Map);
+
+    std::cout << "Testing Heterogeneous Lookup" << std::endl;
+    {
+        THashMap<std::string, Int32, StringHasher> Names;
+        Names.Add(std::string("Jeff"), 1);
+        Names.Add("Anna", 2);
+        Names.Emplace("Bob", 3);
+        std::cout << "Find(\"Anna\")=" << *Names.Find("Anna") << " Contains(\"Carl\")=" << Names.Contains("Carl") << " Remove(\"Jeff\")=" << Names.Remove("Jeff") << std::endl;
+        PrintHashMap(Names);
+    }
+
+    std::cout << "Testing Reserve" << std::endl;
+    {
+        THashMap<UInt32, UInt32> Reserved;
+        Reserved.Reserve(1000);
+        const UInt32 Capacity = Reserved.Capacity();
+        for (UInt32 i = 0; i < 1000; i++)
+        {
+            Reserved.Add(i, i);
+        }
+
+        std::cout << "Capacity=" << Capacity << " After=" << Reserved.Capacity() << " Size=" << Reserved.Size() << std::endl;
+
+        Reserved.Clear();
+        std::cout << "Cleared Size=" << Reserved.Size() << " Capacity=" << Reserved.Capacity() << " Contains(5)=" << Reserved.Contains(5u) << std::endl;
+    }
+
+    std::cout << "Testing Remove (Collisions)" << std::endl;
+    {
+        // Random adds and removes with long, wrapping probe sequences, compared against std::unordered_map
+        THashMap<UInt32, UInt32, CollidingHasher> Colliding;
+        std::unordered_map<UInt32, UInt32>        Reference;
+
+        UInt64 State   = 0x2545F4914F6CDD1Dull;
+        Bool   IsEqual = true;
+        for (UInt32 i = 0; i < 20000; i++)
+        {
+            State = HashInteger(State);
+
+            const UInt32 Key = UInt32(State % 200);
+            if ((State >> 32) % 3 == 0)
+            {
+                IsEqual = IsEqual && (Colliding.Remove(Key) == (Reference.erase(Key) == 1));
+            }
+            else
+            {
+                Colliding.Add(Key, i);
+                Reference[Key] = i;
+            }
+
+            IsEqual = IsEqual && (Colliding.Size() == Reference.size());
+        }
+
+        for (const auto& Pair : Reference)
+        {
+            const UInt32* Value = Colliding.Find(Pair.first);
+            IsEqual = IsEqual && Value && (*Value == Pair.second);
+        }
+
+        UInt32 Count = 0;
+        for (auto Pair : Colliding)
+        {
+            IsEqual = IsEqual && (Reference.count(Pair.Key) == 1);
+            Count++;
+        }
+
+        std::cout << "IsEqual=" << IsEqual << " Size=" << Colliding.Size() << " Count=" << Count << std::endl;
+    }
+
+    std::cout << "Testing Copy/Move" << std::endl;
+    {
+        THashMap<Int32, std::string> Copy(Map);
+        THashMap<Int32, std::string> Moved(::Move(Copy));
+        Moved.Add(0, "Zero");
+        PrintHashMap(Moved);
+        std::cout << "Copy.Size()=" << Copy.Size() << " Map.Size()=" << Map.Size() << std::endl;
+
+        Copy = Moved;
+        Copy.Remove(0);
+        Moved.Swap(Copy);
+        std::cout << "Copy.Size()=" << Copy.Size() << " Moved.Size()=" << Moved.Size() << std::endl;
+    }
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+void THashMap_Benchmark();
+void THashMap_Test();
@@ -0,0 +1,320 @@
+#include "THashSet_Test.h"
+
+#include "Clock.h"
+#include "Vec3.h"
+
+#include "../Containers/HashSet.h"
+#include "../Containers/Hash.h"
+#include "../Containers/Array.h"
+#include "../Containers/StaticArray.h"
+
+#include <iostream>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+/*
+ * Hashing of Vec3, combines the hashes of the components
+ */
+
+template<>
+struct THash<Vec3>
+{
+    UInt64 operator()(const Vec3& Vector) const noexcept
+    {
+        return HashValues(Vector.x, Vector.y, Vector.z);
+    }
+};
+
+struct Vec3StdHash
+{
+    size_t operator()(const Vec3& Vector) const noexcept
+    {
+        const size_t Hash = std::hash<Double>()(Vector.x);
+        return ((Hash * 31) + std::hash<Double>()(Vector.y)) * 31 + std::hash<Double>()(Vector.z);
+    }
+};
+
+/*
+ * PrintHashSet - Sorted, since the order of a hash set depends on the hash function
+ */
+
+template<typename TKey>
+void PrintHashSet(const THashSet<TKey>& Set, const std::string& Name = "")
+{
+    std::cout << Name << std::endl;
+    std::cout << "--------------------------------" << std::endl;
+
+    std::set<TKey> Sorted(Set.begin(), Set.end());
+    for (const TKey& Key : Sorted)
+    {
+        std::cout << Key << std::endl;
+    }
+
+    std::cout << "Size: " << Set.Size() << std::endl;
+    std::cout << "Capacity: " << Set.Capacity() << std::endl;
+    std::cout << "--------------------------------" << std::endl << std::endl;
+}
+#define PrintHashSet(Set) PrintHashSet(Set, #Set)
+
+/*
+ * Benchmark
+ */
+
+void THashSet_Benchmark()
+{
+    std::cout << std::endl << "Benchmark (THashSet)" << std::endl;
+
+#if 1
+    // Hashing throughput for different sizes
+    {
+        const UInt64 TotalBytes = 256 * 1024 * 1024;
+        std::cout << std::endl << "HashBytes (Bytes=" << TotalBytes << ")" << std::endl;
+
+        TArray<Byte> Buffer;
+        Buffer.Resize(1024 * 1024);
+        for (UInt32 i = 0; i < Buffer.Size(); i++)
+        {
+            Buffer[i] = Byte(HashInteger(i));
+        }
+
+        const UInt64 Sizes[] = { 8, 24, 64, 1024, 1024 * 1024 };
+        for (UInt64 Size : Sizes)
+        {
+            const UInt64 Iterations = TotalBytes / Size;
+
+            Clock  HashClock;
+            UInt64 Sum = 0;
+            {
+                ScopedClock ScopedClock(HashClock);
+                for (UInt64 i = 0; i < Iterations; i++)
+                {
+                    Sum += HashBytes(Buffer.Data() + ((i * 64) % (Buffer.Size() - Size + 1)), Size);
+                }
+            }
+
+            Clock  StdClock;
+            UInt64 StdSum = 0;
+            {
+                ScopedClock ScopedClock(StdClock);
+                for (UInt64 i = 0; i < Iterations; i++)
+                {
+                    const Char* Data = reinterpret_cast<const Char*>(Buffer.Data()) + ((i * 64) % (Buffer.Size() - Size + 1));
+                    StdSum += std::hash<std::string_view>()(std::string_view(Data, Size));
+                }
+            }
+
+            std::cout << "Size=" << Size << " HashBytes:" << (Double(TotalBytes) / Double(HashClock.GetTotalDuration())) << "GB/s std::hash:" << (Double(TotalBytes) / Double(StdClock.GetTotalDuration())) << "GB/s (Sum=" << ((Sum ^ StdSum) & 0xff) << ")" << std::endl;
+        }
+    }
+#endif
+
+#if 1
+    // Bulk hashing of arrays compared to hashing each element
+    {
+        const UInt32 TestCount = 100;
+        std::cout << std::endl << "Hash TArray<UInt32> (Elements=" << 1024 * 1024 << ", TestCount=" << TestCount << ")" << std::endl;
+
+        TArray<UInt32> Array;
+        for (UInt32 i = 0; i < 1024 * 1024; i++)
+        {
+            Array.PushBack(UInt32(HashInteger(i)));
+        }
+
+        Clock  BulkClock;
+        Clock  ElementClock;
+        UInt64 Sum = 0;
+        for (UInt32 i = 0; i < TestCount; i++)
+        {
+            {
+                ScopedClock ScopedClock(BulkClock);
+                Sum += THash<TArray<UInt32>>()(Array);
+            }
+
+            {
+                ScopedClock ScopedClock(ElementClock);
+
+                UInt64 Hash = HashInteger(Array.Size());
+                for (UInt32 Element : Array)
+                {
+                    Hash = HashCombine(Hash, THash<UInt32>()(Element));
+                }
+
+                Sum += Hash;
+            }
+        }
+
+        std::cout << "Bulk       :" << BulkClock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        std::cout << "Per element:" << ElementClock.GetTotalDuration() / TestCount << "ns (Sum=" << (Sum & 0xff) << ")" << std::endl;
+    }
+#endif
+
+#if 1
+    // Sets of Vec3
+    {
+        const UInt32 TestCount   = 10;
+        const UInt32 NumElements = 1000000;
+        std::cout << std::endl << "Vec3 Keys (Elements=" << NumElements << ", TestCount=" << TestCount << ")" << std::endl;
+
+        TArray<Vec3> Vectors;
+        for (UInt32 i = 0; i < NumElements; i++)
+        {
+            Vectors.EmplaceBack(Double(i % 100), Double((i / 100) % 100), Double(i / 10000));
+        }
+
+        {
+            Clock  InsertClock;
+            Clock  HitClock;
+            UInt64 Sum = 0;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                THashSet<Vec3> Set;
+                {
+                    ScopedClock ScopedClock(InsertClock);
+                    for (const Vec3& Vector : Vectors)
+                    {
+                        Set.Add(Vector);
+                    }
+                }
+
+                ScopedClock ScopedClock(HitClock);
+                for (const Vec3& Vector : Vectors)
+                {
+                    Sum += Set.Contains(Vector) ? 1 : 0;
+                }
+            }
+
+            std::cout << "THashSet Insert:" << InsertClock.GetTotalDuration() / TestCount << "ns" << std::endl;
+            std::cout << "THashSet Hit   :" << HitClock.GetTotalDuration() / TestCount << "ns (Sum=" << Sum << ")" << std::endl;
+        }
+
+        {
+            Clock  InsertClock;
+            Clock  HitClock;
+            UInt64 Sum = 0;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                std::unordered_set<Vec3, Vec3StdHash> Set;
+                {
+                    ScopedClock ScopedClock(InsertClock);
+                    for (const Vec3& Vector : Vectors)
+                    {
+                        Set.insert(Vector);
+                    }
+                }
+
+                ScopedClock ScopedClock(HitClock);
+                for (const Vec3& Vector : Vectors)
+                {
+                    Sum += Set.count(Vector);
+                }
+            }
+
+            std::cout << "std::unordered_set Insert:" << InsertClock.GetTotalDuration() / TestCount << "ns" << std::endl;
+            std::cout << "std::unordered_set Hit   :" << HitClock.GetTotalDuration() / TestCount << "ns (Sum=" << Sum << ")" << std::endl;
+        }
+    }
+#endif
+}
+
+/*
+ * Test
+ */
+
+void THashSet_Test()
+{
+    std::cout << std::endl << "----------THashSet----------" << std::endl << std::endl;
+
+    std::cout << "Testing Add/Remove" << std::endl;
+    THashSet<std::string> Strings = { "Hello", "World", "Hello" };
+    std::cout << "Add(\"Jeff\")=" << Strings.Add("Jeff") << " Add(\"World\")=" << Strings.Add(std::string("World")) << std::endl;
+    std::cout << "Remove(\"Hello\")=" << Strings.Remove("Hello") << " Remove(\"Hello\")=" << Strings.Remove("Hello") << std::endl;
+    PrintHashSet(Strings);
+
+    std::cout << "Testing Contains" << std::endl;
+    {
+        // Heterogeneous lookup without constructing a std::string
+        const std::string_view View("Jeff");
+        std::cout << "Contains(\"World\")=" << Strings.Contains("World") << " Contains(View)=" << Strings.Contains(View) << " Contains(\"Hello\")=" << Strings.Contains("Hello") << std::endl;
+        std::cout << "Find(\"Jeff\")=" << *Strings.Find("Jeff") << std::endl;
+    }
+
+    std::cout << "Testing Vec3" << std::endl;
+    {
+        THashSet<Vec3> Vectors;
+        for (UInt32 i = 0; i < 1000; i++)
+        {
+            Vectors.Add(Vec3(Double(i % 10), Double(i % 7), 0.0));
+        }
+
+        Vectors.Add(Vec3(-0.0, 0.0, 0.0));
+        std::cout << "Size=" << Vectors.Size() << " Contains(3,3,0)=" << Vectors.Contains(Vec3(3.0, 3.0, 0.0)) << " Contains(3,3,1)=" << Vectors.Contains(Vec3(3.0, 3.0, 1.0)) << std::endl;
+    }
+
+    std::cout << "Testing Copy/Move" << std::endl;
+    {
+        THashSet<std::string> Copy(Strings);
+        THashSet<std::string> Moved(::Move(Copy));
+        Moved.Add("Moved");
+        PrintHashSet(Moved);
+        std::cout << "Copy.Size()=" << Copy.Size() << " Strings.Size()=" << Strings.Size() << std::endl;
+    }
+
+    std::cout << "Testing Hash" << std::endl;
+    {
+        // Equal values hash the same, independent of the container
+        TArray<Byte> Bytes = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+        TStaticArray<Byte, 10> StaticBytes = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+        TArrayView<Byte> View(Bytes);
+        TArrayView<const Byte> ConstView(Bytes.Data(), Bytes.Data() + Bytes.Size());
+
+        const UInt64 ArrayHash = THash<TArray<Byte>>()(Bytes);
+        std::cout << "Array=View:" << (ArrayHash == THash<TArrayView<Byte>>()(View));
+        std::cout << " Array=ConstView:" << (ArrayHash == THash<TArrayView<const Byte>>()(ConstView));
+        std::cout << " Array=StaticArray:" << (ArrayHash == THash<TStaticArray<Byte, 10>>()(StaticBytes));
+        std::cout << " Array=Bytes:" << (ArrayHash == HashBytes(Bytes.Data(), Bytes.Size())) << std::endl;
+
+        std::cout << "String=StringView:" << (THash<std::string>()(std::string("Hash me")) == THash<std::string_view>()("Hash me"));
+        std::cout << " Zero=NegativeZero:" << (THash<Double>()(0.0) == THash<Double>()(-0.0));
+        std::cout << " Combine is ordered:" << (HashValues(1, 2) != HashValues(2, 1)) << std::endl;
+
+        // All sizes up to 64 bytes, every changed byte must change the hash
+        Byte Buffer[64] = {};
+        Bool IsDifferent = true;
+        for (UInt64 Size = 1; Size <= 64; Size++)
+        {
+            const UInt64 Hash = HashBytes(Buffer, Size);
+            for (UInt64 Index = 0; Index < Size; Index++)
+            {
+                Buffer[Index] = 1;
+                IsDifferent = IsDifferent && (HashBytes(Buffer, Size) != Hash);
+                Buffer[Index] = 0;
+            }
+
+            IsDifferent = IsDifferent && (HashBytes(Buffer, Size) != HashBytes(Buffer, Size - 1));
+        }
+
+        std::cout << "Every byte changes the hash:" << IsDifferent << std::endl;
+
+        // Flipping one input bit should flip about half of the output bits
+        UInt64 FlippedBits = 0;
+        UInt64 NumSamples  = 0;
+        for (UInt64 Value = 0; Value < 256; Value++)
+        {
+            for (UInt32 Bit = 0; Bit < 64; Bit++)
+            {
+                UInt64 Diff = HashInteger(Value) ^ HashInteger(Value ^ (1ull << Bit));
+                for (; Diff; Diff &= Diff - 1)
+                {
+                    FlippedBits++;
+                }
+
+                NumSamples++;
+            }
+        }
+
+        const Double Average = Double(FlippedBits) / Double(NumSamples);
+        std::cout << "HashInteger avalanche within 31-33 bits:" << (Average > 31.0 && Average < 33.0) << std::endl;
+    }
+}
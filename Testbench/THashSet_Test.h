@@ -0,0 +1,4 @@
+#pragma once
+
+void THashSet_Benchmark();
+void THashSet_Test();
@@ -0,0 +1,393 @@
+#include "TSPSCQueue_Test.h"
+
+#include "Clock.h"
+
+#include "../Containers/SPSCQueue.h"
+#include "../Containers/Array.h"
+#include "../Containers/Deque.h"
+#include "../Containers/UniquePtr.h"
+
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <pthread.h>
+#endif
+
+/*
+ * Threads on separate cores, when there are at least two cores
+ */
+
+static void PinThread(std::thread& Thread, UInt32 Core)
+{
+    if (std::thread::hardware_concurrency() < 2)
+    {
+        return;
+    }
+
+#if defined(_WIN32)
+    SetThreadAffinityMask(Thread.native_handle(), DWORD_PTR(1) << Core);
+#elif defined(__linux__)
+    cpu_set_t Set;
+    CPU_ZERO(&Set);
+    CPU_SET(Core, &Set);
+    pthread_setaffinity_np(Thread.native_handle(), sizeof(Set), &Set);
+#else
+    (void)Thread;
+    (void)Core;
+#endif
+}
+
+// Spins for a while before giving the core away, which matters when both threads share a core
+static void Backoff(UInt32& NumSpins)
+{
+    if (++NumSpins >= 64)
+    {
+        std::this_thread::yield();
+        NumSpins = 0;
+    }
+}
+
+// Runs the producer and the consumer on their own pinned threads and returns the duration in nanoseconds
+template<typename TProducer, typename TConsumer>
+static Int64 RunPair(TProducer&& Producer, TConsumer&& Consumer)
+{
+    Clock Clock;
+    {
+        ScopedClock ScopedClock(Clock);
+
+        std::thread ConsumerThread(Consumer);
+        std::thread ProducerThread(Producer);
+        PinThread(ConsumerThread, 1);
+        PinThread(ProducerThread, 0);
+
+        ProducerThread.join();
+        ConsumerThread.join();
+    }
+
+    return Clock.GetTotalDuration();
+}
+
+/*
+ * Benchmark
+ */
+
+void TSPSCQueue_Benchmark()
+{
+    std::cout << std::endl << "Benchmark (TSPSCQueue, HardwareThreads=" << std::thread::hardware_concurrency() << ")" << std::endl;
+
+    constexpr UInt32 Capacity  = 4096;
+    constexpr UInt32 BatchSize = 64;
+    typedef TSPSCQueue<UInt64, Capacity> QueueType;
+
+#if 1
+    // Throughput
+    {
+        const UInt64 NumElements = 64 * 1024 * 1024;
+        std::cout << std::endl << "Throughput (Elements=" << NumElements << ", Capacity=" << Capacity << ", BatchSize=" << BatchSize << ")" << std::endl;
+
+        {
+            std::mutex     Mutex;
+            TDeque<UInt64> Deque;
+            UInt64         Sum = 0;
+
+            const Int64 Duration = RunPair([&]()
+            {
+                for (UInt64 i = 0; i < NumElements; i++)
+                {
+                    std::lock_guard<std::mutex> Lock(Mutex);
+                    Deque.PushBack(i);
+                }
+            },
+            [&]()
+            {
+                UInt64 NumPopped = 0;
+                UInt32 NumSpins  = 0;
+                while (NumPopped < NumElements)
+                {
+                    Bool   HasElement = false;
+                    UInt64 Element    = 0;
+                    {
+                        std::lock_guard<std::mutex> Lock(Mutex);
+                        HasElement = Deque.TryPopFront(Element);
+                    }
+
+                    if (HasElement)
+                    {
+                        Sum += Element;
+                        NumPopped++;
+                    }
+                    else
+                    {
+                        Backoff(NumSpins);
+                    }
+                }
+            });
+
+            std::cout << "std::mutex + TDeque : " << Duration / 1000000 << "ms, " << Double(NumElements) * 1000.0 / Double(Duration) << "M/s (Sum=" << Sum << ")" << std::endl;
+        }
+
+        {
+            TUniquePtr<QueueType> Queue = MakeUnique<QueueType>();
+            UInt64 Sum = 0;
+
+            const Int64 Duration = RunPair([&]()
+            {
+                UInt32 NumSpins = 0;
+                for (UInt64 i = 0; i < NumElements; i++)
+                {
+                    while (!Queue->Push(i))
+                    {
+                        Backoff(NumSpins);
+                    }
+                }
+            },
+            [&]()
+            {
+                UInt64 NumPopped = 0;
+                UInt32 NumSpins  = 0;
+                UInt64 Element   = 0;
+                while (NumPopped < NumElements)
+                {
+                    if (Queue->Pop(Element))
+                    {
+                        Sum += Element;
+                        NumPopped++;
+                    }
+                    else
+                    {
+                        Backoff(NumSpins);
+                    }
+                }
+            });
+
+            std::cout << "Push/Pop            : " << Duration / 1000000 << "ms, " << Double(NumElements) * 1000.0 / Double(Duration) << "M/s (Sum=" << Sum << ")" << std::endl;
+        }
+
+        {
+            TUniquePtr<QueueType> Queue = MakeUnique<QueueType>();
+            UInt64 Sum = 0;
+
+            const Int64 Duration = RunPair([&]()
+            {
+                UInt64 Batch[BatchSize];
+                UInt32 NumSpins = 0;
+                for (UInt64 i = 0; i < NumElements; i += BatchSize)
+                {
+                    for (UInt32 j = 0; j < BatchSize; j++)
+                    {
+                        Batch[j] = i + j;
+                    }
+
+                    TArrayView<UInt64> Remaining(Batch);
+                    while (Remaining.Size() > 0)
+                    {
+                        const UInt32 NumPushed = Queue->PushBatch(Remaining);
+                        Remaining = TArrayView<UInt64>(Remaining.Data() + NumPushed, Remaining.Data() + Remaining.Size());
+                        if (NumPushed == 0)
+                        {
+                            Backoff(NumSpins);
+                        }
+                    }
+                }
+            },
+            [&]()
+            {
+                UInt64 Batch[BatchSize];
+                UInt64 NumPopped = 0;
+                UInt32 NumSpins  = 0;
+                while (NumPopped < NumElements)
+                {
+                    const UInt32 Count = Queue->PopBatch(TArrayView<UInt64>(Batch));
+                    for (UInt32 j = 0; j < Count; j++)
+                    {
+                        Sum += Batch[j];
+                    }
+
+                    NumPopped += Count;
+                    if (Count == 0)
+                    {
+                        Backoff(NumSpins);
+                    }
+                }
+            });
+
+            std::cout << "PushBatch/PopBatch  : " << Duration / 1000000 << "ms, " << Double(NumElements) * 1000.0 / Double(Duration) << "M/s (Sum=" << Sum << ")" << std::endl;
+        }
+    }
+#endif
+
+#if 1
+    // Latency, one element goes back and forth between two queues
+    {
+        const UInt32 NumRoundTrips = 1000000;
+        std::cout << std::endl << "Latency (RoundTrips=" << NumRoundTrips << ")" << std::endl;
+
+        TUniquePtr<QueueType> Ping = MakeUnique<QueueType>();
+        TUniquePtr<QueueType> Pong = MakeUnique<QueueType>();
+
+        const Int64 Duration = RunPair([&]()
+        {
+            UInt32 NumSpins = 0;
+            UInt64 Element  = 0;
+            for (UInt32 i = 0; i < NumRoundTrips; i++)
+            {
+                Ping->Push(UInt64(i));
+                while (!Pong->Pop(Element))
+                {
+                    Backoff(NumSpins);
+                }
+            }
+        },
+        [&]()
+        {
+            UInt32 NumSpins = 0;
+            UInt64 Element  = 0;
+            for (UInt32 i = 0; i < NumRoundTrips; i++)
+            {
+                while (!Ping->Pop(Element))
+                {
+                    Backoff(NumSpins);
+                }
+
+                Pong->Push(Element);
+            }
+        });
+
+        std::cout << "Round trip: " << Duration / NumRoundTrips << "ns, One way: " << Duration / (2 * Int64(NumRoundTrips)) << "ns" << std::endl;
+    }
+#endif
+}
+
+/*
+ * Test
+ */
+
+void TSPSCQueue_Test()
+{
+    std::cout << std::endl << "----------TSPSCQueue----------" << std::endl << std::endl;
+
+#if 1
+    std::cout << "Testing Push and Pop" << std::endl;
+    {
+        TSPSCQueue<std::string, 4> Queue;
+        std::cout << "Capacity=" << Queue.GetCapacity() << " IsEmpty=" << Queue.IsEmpty() << std::endl;
+
+        const std::string Strings[] = { "Hello", "World", "From", "Queue" };
+        for (const std::string& String : Strings)
+        {
+            Queue.Push(String);
+        }
+
+        std::cout << "Full Push=" << Queue.Push(std::string("Extra")) << " Size=" << Queue.Size() << std::endl;
+
+        std::string Element;
+        while (Queue.Pop(Element))
+        {
+            std::cout << Element << " ";
+        }
+
+        std::cout << std::endl << "Empty Pop=" << Queue.Pop(Element) << std::endl;
+    }
+#endif
+
+#if 1
+    std::cout << std::endl << "Testing batches" << std::endl;
+    {
+        TSPSCQueue<UInt32, 8> Queue;
+
+        // Wraps around the end of the buffer
+        UInt32 Numbers[] = { 1, 2, 3, 4, 5, 6 };
+        UInt32 Popped[6] = { };
+        const UInt32 NumPushed0 = Queue.PushBatch(TArrayView<UInt32>(Numbers));
+        const UInt32 NumPopped0 = Queue.PopBatch(TArrayView<UInt32>(Popped));
+        const UInt32 NumPushed1 = Queue.PushBatch(TArrayView<UInt32>(Numbers));
+        const UInt32 NumPushed2 = Queue.PushBatch(TArrayView<UInt32>(Numbers));
+        std::cout << "Pushed=" << NumPushed0 << " Popped=" << NumPopped0 << " Pushed=" << NumPushed1 << " Pushed (Full)=" << NumPushed2 << " Size=" << Queue.Size() << std::endl;
+
+        UInt32 Batch[16] = { };
+        const UInt32 NumPopped1 = Queue.PopBatch(TArrayView<UInt32>(Batch));
+        for (UInt32 Index = 0; Index < NumPopped1; Index++)
+        {
+            std::cout << Batch[Index] << " ";
+        }
+
+        std::cout << std::endl << "Popped=" << NumPopped1 << " Empty PopBatch=" << Queue.PopBatch(TArrayView<UInt32>(Batch)) << std::endl;
+    }
+#endif
+
+#if 1
+    std::cout << std::endl << "Testing two threads" << std::endl;
+    {
+        const UInt32 NumElements = 1000000;
+        TUniquePtr<TSPSCQueue<UInt32, 64>> Queue = MakeUnique<TSPSCQueue<UInt32, 64>>();
+
+        // The consumer checks that every element arrives once and in order, single and batched pushes are mixed
+        Bool InOrder = true;
+        RunPair([&]()
+        {
+            UInt32 NumSpins = 0;
+            UInt32 Next     = 0;
+            while (Next < NumElements)
+            {
+                if ((Next / 1000) % 2 == 0)
+                {
+                    if (Queue->Push(Next))
+                    {
+                        Next++;
+                        continue;
+                    }
+                }
+                else
+                {
+                    UInt32 Batch[7];
+                    const UInt32 BatchSize = std::min<UInt32>(7, NumElements - Next);
+                    for (UInt32 Index = 0; Index < BatchSize; Index++)
+                    {
+                        Batch[Index] = Next + Index;
+                    }
+
+                    const UInt32 NumPushed = Queue->PushBatch(TArrayView<UInt32>(Batch, Batch + BatchSize));
+                    Next += NumPushed;
+                    if (NumPushed > 0)
+                    {
+                        continue;
+                    }
+                }
+
+                Backoff(NumSpins);
+            }
+        },
+        [&]()
+        {
+            UInt32 NumSpins = 0;
+            UInt32 Expected = 0;
+            UInt32 Batch[5];
+            while (Expected < NumElements)
+            {
+                const UInt32 Count = Queue->PopBatch(TArrayView<UInt32>(Batch));
+                for (UInt32 Index = 0; Index < Count; Index++)
+                {
+                    InOrder = InOrder && (Batch[Index] == Expected);
+                    Expected++;
+                }
+
+                if (Count == 0)
+                {
+                    Backoff(NumSpins);
+                }
+            }
+        });
+
+        std::cout << "InOrder=" << InOrder << " IsEmpty=" << Queue->IsEmpty() << std::endl;
+    }
+#endif
+}
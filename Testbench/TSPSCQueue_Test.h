@@ -0,0 +1,4 @@
+#pragma once
+
+void TSPSCQueue_Benchmark();
+void TSPSCQueue_Test();
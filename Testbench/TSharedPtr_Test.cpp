@@ -1,8 +1,336 @@
 #include "TSharedPtr_Test.h"
 
+#include "Clock.h"
+#include "Memory.h"
+
 #include "../Containers/SharedPtr.h"
 
 #include <iostream>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+/*
+ * Benchmark
+ */
+
+struct Payload
+{
+    Payload(UInt64 InValue)
+        : Value(InValue)
+    {
+    }
+
+    UInt64 Value;
+    UInt64 Padding[3];
+};
+
+// Mallocator that counts its allocations, only used by the layout benchmark so the other benchmarks are not affected
+struct CountingMallocator : public Mallocator
+{
+    void* Allocate(UInt64 Size, UInt64 Alignment)
+    {
+        NumAllocations++;
+        return Mallocator::Allocate(Size, Alignment);
+    }
+
+    inline static UInt64 NumAllocations = 0;
+};
+
+// Payload that is allocated through CountingMallocator when it is created with new
+struct CountedPayload : public Payload
+{
+    using Payload::Payload;
+
+    static void* operator new(size_t Size)
+    {
+        if (void* Memory = CountingMallocator().Allocate(Size, __STDCPP_DEFAULT_NEW_ALIGNMENT__))
+        {
+            return Memory;
+        }
+
+        throw std::bad_alloc();
+    }
+
+    static void operator delete(void* Ptr) noexcept
+    {
+        CountingMallocator().Free(Ptr, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+    }
+};
+
+// Each thread copies and releases the same pointer, which makes all the threads write to the same counter
+template<typename TPointer>
+static Int64 CopyReleaseBenchmark(const TPointer& Pointer, UInt32 NumThreads, UInt32 Iterations)
+{
+    Clock Clock;
+    {
+        ScopedClock ScopedClock(Clock);
+
+        std::vector<std::thread> Threads;
+        for (UInt32 i = 0; i < NumThreads; i++)
+        {
+            Threads.emplace_back([&Pointer, Iterations]()
+            {
+                for (UInt32 j = 0; j < Iterations; j++)
+                {
+                    TPointer Copy = Pointer;
+                    UNREFERENCED_VARIABLE(Copy);
+                }
+            });
+        }
+
+        for (std::thread& Thread : Threads)
+        {
+            Thread.join();
+        }
+    }
+
+    return Clock.GetTotalDuration();
+}
+
+// Control blocks come from the pool and are only counted when memory tracking is enabled
+static UInt64 GetNumControlBlocks()
+{
+#if ENABLE_MEMORY_TRACKING
+    return ControlBlockAllocator::GetStats().NumAllocations;
+#else
+    return 0;
+#endif
+}
+
+// Sums the objects through the pointers, creating the pointers interleaved with other allocations
+template<typename TCreateFunc>
+static void LayoutBenchmark(const Char* Name, UInt32 Count, UInt32 TestCount, TCreateFunc&& CreateFunc)
+{
+    Clock CreateClock;
+    Clock DerefClock;
+    Clock CopyClock;
+    UInt64 NumAllocations = 0;
+    UInt64 NumBlocks      = 0;
+    UInt64 Sum            = 0;
+    for (UInt32 i = 0; i < TestCount; i++)
+    {
+        std::vector<TSharedPtr<CountedPayload>> Pointers;
+        Pointers.reserve(Count);
+
+        const UInt64 StartAllocations = CountingMallocator::NumAllocations;
+        const UInt64 StartBlocks      = GetNumControlBlocks();
+        {
+            ScopedClock ScopedClock(CreateClock);
+            for (UInt32 j = 0; j < Count; j++)
+            {
+                Pointers.emplace_back(CreateFunc(j));
+            }
+        }
+
+        NumAllocations += CountingMallocator::NumAllocations - StartAllocations;
+        NumBlocks      += GetNumControlBlocks() - StartBlocks;
+
+        {
+            ScopedClock ScopedClock(DerefClock);
+            for (const TSharedPtr<CountedPayload>& Pointer : Pointers)
+            {
+                Sum += Pointer->Value;
+            }
+        }
+
+        {
+            ScopedClock ScopedClock(CopyClock);
+            for (const TSharedPtr<CountedPayload>& Pointer : Pointers)
+            {
+                TSharedPtr<CountedPayload> Copy = Pointer;
+                Sum += Copy->Value;
+            }
+        }
+    }
+
+    std::cout << Name << ": Heap Allocations/Pointer=" << Double(NumAllocations) / (Double(Count) * TestCount);
+#if ENABLE_MEMORY_TRACKING
+    std::cout << " Pool Blocks/Pointer=" << Double(NumBlocks) / (Double(Count) * TestCount);
+#endif
+    std::cout
+        << " Create=" << CreateClock.GetTotalDuration() / (UInt64(Count) * TestCount) << "ns"
+        << " Dereference=" << DerefClock.GetTotalDuration() / (UInt64(Count) * TestCount) << "ns"
+        << " Copy+Dereference=" << CopyClock.GetTotalDuration() / (UInt64(Count) * TestCount) << "ns"
+        << " (Sum=" << Sum << ")" << std::endl;
+}
+
+// Mallocator with the same sized Free as PoolAllocator
+struct SizedMallocator
+{
+    void* Allocate(UInt64 Size, UInt64 Alignment)
+    {
+        return Mallocator().Allocate(Size, Alignment);
+    }
+
+    void Free(void* Ptr, UInt64 Size, UInt64 Alignment)
+    {
+        UNREFERENCED_VARIABLE(Size);
+        Mallocator().Free(Ptr, Alignment);
+    }
+};
+
+template<typename TAllocator>
+struct TChurnBlock
+{
+    TChurnBlock() = default;
+
+    TChurnBlock(UInt64 InSize)
+        : Ptr(TAllocator().Allocate(InSize, 16))
+        , Size(InSize)
+    {
+    }
+
+    TChurnBlock(const TChurnBlock&) = delete;
+
+    ~TChurnBlock()
+    {
+        TAllocator().Free(Ptr, Size, 16);
+    }
+
+    TChurnBlock& operator=(TChurnBlock&& Other)
+    {
+        TAllocator().Free(Ptr, Size, 16);
+        Ptr  = Other.Ptr;
+        Size = Other.Size;
+        Other.Ptr = nullptr;
+        return *this;
+    }
+
+    void*  Ptr  = nullptr;
+    UInt64 Size = 0;
+};
+
+// Each thread keeps a set of live objects and replaces random ones, so blocks are freed in a different order than they are allocated
+template<typename TObject, typename TCreateFunc>
+static void ChurnBenchmark(const Char* Name, UInt32 NumThreads, UInt32 Iterations, TCreateFunc&& CreateFunc)
+{
+    const UInt32 NumLive     = 64 * 1024;
+    const UInt64 StartMemory = GetResidentMemory();
+
+    Clock Clock;
+    {
+        ScopedClock ScopedClock(Clock);
+
+        std::vector<std::thread> Threads;
+        for (UInt32 ThreadIndex = 0; ThreadIndex < NumThreads; ThreadIndex++)
+        {
+            Threads.emplace_back([&, ThreadIndex]()
+            {
+                std::vector<TObject> Objects(NumLive);
+
+                UInt32 Random = (ThreadIndex * 7919) + 1;
+                for (UInt32 i = 0; i < Iterations; i++)
+                {
+                    Random = (Random * 1664525) + 1013904223;
+                    Objects[(Random >> 8) % NumLive] = CreateFunc(Random);
+                }
+            });
+        }
+
+        for (std::thread& Thread : Threads)
+        {
+            Thread.join();
+        }
+    }
+
+    const UInt64 EndMemory = GetResidentMemory();
+    std::cout << Name << ":" << Clock.GetTotalDuration() / (UInt64(Iterations) * NumThreads) << "ns"
+        << " RSS Growth=" << ((EndMemory > StartMemory) ? (EndMemory - StartMemory) / 1024 : 0) << "KB" << std::endl;
+}
+
+void TSharedPtr_Benchmark()
+{
+    std::cout << std::endl << "Benchmark (Layout)" << std::endl;
+    {
+        const UInt32 Count     = 1000000;
+        const UInt32 TestCount = 10;
+        std::cout << std::endl << "Create/Dereference (Count=" << Count << ", TestCount=" << TestCount << ")" << std::endl;
+
+        LayoutBenchmark("Separate  ", Count, TestCount, [](UInt32 Value)
+        {
+            return TSharedPtr<CountedPayload>(new CountedPayload(Value));
+        });
+
+        LayoutBenchmark("MakeShared", Count, TestCount, [](UInt32 Value)
+        {
+            return MakeShared<CountedPayload>(Value);
+        });
+    }
+
+    std::cout << std::endl << "Benchmark (Copy/Release)" << std::endl;
+
+    const UInt32 Iterations = 1000000;
+
+    // Single-threaded, the non-atomic counter is only valid here
+    {
+        std::cout << std::endl << "Copy/Release (Threads=1, Iterations=" << Iterations << ")" << std::endl;
+
+        std::shared_ptr<UInt32> StdPtr = std::make_shared<UInt32>(5);
+        std::cout << "std::shared_ptr     :" << CopyReleaseBenchmark(StdPtr, 1, Iterations) / Iterations << "ns" << std::endl;
+
+        TSharedPtr<UInt32> SharedPtr = MakeShared<UInt32>(5);
+        std::cout << "TSharedPtr          :" << CopyReleaseBenchmark(SharedPtr, 1, Iterations) / Iterations << "ns" << std::endl;
+
+        TThreadSafeSharedPtr<UInt32> ThreadSafePtr = MakeShared<UInt32, ThreadSafeRefCounter>(5);
+        std::cout << "TThreadSafeSharedPtr:" << CopyReleaseBenchmark(ThreadSafePtr, 1, Iterations) / Iterations << "ns" << std::endl;
+    }
+
+    const UInt32 MaxThreads = std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() : 2;
+    for (UInt32 NumThreads = 2; NumThreads <= MaxThreads; NumThreads *= 2)
+    {
+        const UInt32 TotalIterations = Iterations * NumThreads;
+        std::cout << std::endl << "Copy/Release (Threads=" << NumThreads << ", Iterations=" << Iterations << " per thread)" << std::endl;
+
+        std::shared_ptr<UInt32> StdPtr = std::make_shared<UInt32>(5);
+        std::cout << "std::shared_ptr     :" << CopyReleaseBenchmark(StdPtr, NumThreads, Iterations) / TotalIterations << "ns" << std::endl;
+
+        TThreadSafeSharedPtr<UInt32> ThreadSafePtr = MakeShared<UInt32, ThreadSafeRefCounter>(5);
+        std::cout << "TThreadSafeSharedPtr:" << CopyReleaseBenchmark(ThreadSafePtr, NumThreads, Iterations) / TotalIterations << "ns" << std::endl;
+
+        if (ThreadSafePtr.GetStrongReferences() != 1)
+        {
+            std::cout << "ERROR: Strong references=" << ThreadSafePtr.GetStrongReferences() << std::endl;
+        }
+    }
+
+    std::cout << std::endl << "Benchmark (Churn)" << std::endl;
+
+    for (UInt32 NumThreads : { 1u, MaxThreads })
+    {
+        const UInt32 ChurnIterations = 4000000;
+        std::cout << std::endl << "Churn (Threads=" << NumThreads << ", Iterations=" << ChurnIterations << " per thread)" << std::endl;
+
+        // Sizes from 16 to 256 bytes, the range that the pool serves
+        ChurnBenchmark<TChurnBlock<SizedMallocator>>("Mallocator          ", NumThreads, ChurnIterations, [](UInt32 Random)
+        {
+            return TChurnBlock<SizedMallocator>(((Random % 16) + 1) * 16);
+        });
+
+        ChurnBenchmark<TChurnBlock<PoolAllocator>>("PoolAllocator       ", NumThreads, ChurnIterations, [](UInt32 Random)
+        {
+            return TChurnBlock<PoolAllocator>(((Random % 16) + 1) * 16);
+        });
+
+        // The control block of std::shared_ptr is allocated with malloc, while TSharedPtr uses the pool
+        ChurnBenchmark<std::shared_ptr<Payload>>("std::shared_ptr     ", NumThreads, ChurnIterations, [](UInt32 Random)
+        {
+            return std::shared_ptr<Payload>(new Payload(Random));
+        });
+
+        ChurnBenchmark<TThreadSafeSharedPtr<Payload>>("TThreadSafeSharedPtr", NumThreads, ChurnIterations, [](UInt32 Random)
+        {
+            return TThreadSafeSharedPtr<Payload>(new Payload(Random));
+        });
+    }
+
+    std::cout << "Pool reserved=" << SizeClassPool::Get().GetReservedBytes() / 1024 << "KB" << std::endl;
+}
+
+/*
+ * Test
+ */
 
 void TSharedPtr_Test()
 {
@@ -104,4 +432,50 @@ void TSharedPtr_Test()
     std::cout << "Testing bool operators" << std::endl;
     std::cout << std::boolalpha << (WeakBase0 == WeakBase1) << std::endl;
     std::cout << std::boolalpha << (UintPtr0 == UintPtr1) << std::endl;
+
+    std::cout << "Testing MakeShared with weak references" << std::endl;
+    TWeakPtr<std::vector<UInt32>> WeakVector;
+    {
+        TSharedPtr<std::vector<UInt32>> SharedVector = MakeShared<std::vector<UInt32>>(16, 7);
+        WeakVector = SharedVector;
+        std::cout << "Size=" << WeakVector->size() << std::endl;
+    }
+    std::cout << "IsExpired=" << std::boolalpha << WeakVector.IsExpired() << std::endl;
+
+    struct alignas(64) AlignedData
+    {
+        Float Data[16];
+    };
+
+    TSharedPtr<AlignedData[]> AlignedArray = MakeShared<AlignedData[]>(3);
+    std::cout << "IsAligned=" << std::boolalpha << ((reinterpret_cast<UInt64>(AlignedArray.Get()) % 64) == 0) << std::endl;
+
+    // Types with their own operator new are still constructed inside the control block
+    struct PooledData
+    {
+        static void* operator new(size_t Size) { return ::operator new(Size); }
+        static void operator delete(void* Ptr) noexcept { ::operator delete(Ptr); }
+
+        UInt32 Value = 3;
+    };
+
+    TSharedPtr<PooledData> PooledPtr = MakeShared<PooledData>();
+    TSharedPtr<PooledData[]> PooledArray = MakeShared<PooledData[]>(2);
+    std::cout << "Pooled=" << PooledPtr->Value << " " << PooledArray[1].Value << std::endl;
+
+    std::cout << "Testing ThreadSafe references" << std::endl;
+    TThreadSafeSharedPtr<UInt32> ThreadSafePtr0 = MakeShared<UInt32, ThreadSafeRefCounter>(64);
+    TThreadSafeWeakPtr<UInt32> ThreadSafeWeak = ThreadSafePtr0;
+    {
+        TThreadSafeSharedPtr<UInt32> ThreadSafePtr1 = ThreadSafePtr0;
+        std::cout << "StrongReferences=" << ThreadSafePtr0.GetStrongReferences() << std::endl;
+        std::cout << "WeakReferences=" << ThreadSafePtr0.GetWeakReferences() << std::endl;
+    }
+
+    std::cout << "StrongReferences=" << ThreadSafePtr0.GetStrongReferences() << std::endl;
+    ThreadSafePtr0.Reset();
+    std::cout << "IsExpired=" << std::boolalpha << ThreadSafeWeak.IsExpired() << std::endl;
+
+    TThreadSafeSharedPtr<UInt32> ExpiredPtr = ThreadSafeWeak.MakeShared();
+    std::cout << "Expired MakeShared=" << std::boolalpha << (ExpiredPtr == nullptr) << std::endl;
 }
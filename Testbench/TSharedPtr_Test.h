@@ -1,3 +1,4 @@
 #pragma once
 
+void TSharedPtr_Benchmark();
 void TSharedPtr_Test();
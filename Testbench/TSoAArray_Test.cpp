@@ -0,0 +1,300 @@
+#include "TSoAArray_Test.h"
+
+#include "Clock.h"
+#include "Vec3.h"
+
+#include "../Containers/SoAArray.h"
+#include "../Containers/Array.h"
+
+#include <iostream>
+#include <iterator>
+#include <string>
+
+/*
+ * PrintSoAArray
+ */
+
+template<typename... TFields>
+void PrintSoAArray(const TSoAArray<TFields...>& Array, const std::string& Name = "")
+{
+    std::cout << Name << std::endl;
+    std::cout << "--------------------------------" << std::endl;
+
+    for (auto Element : Array)
+    {
+        std::apply([](const auto&... Fields)
+        {
+            ((std::cout << Fields << " "), ...);
+        }, Element);
+
+        std::cout << std::endl;
+    }
+
+    std::cout << "Size: " << Array.Size() << std::endl;
+    std::cout << "Capacity: " << Array.Capacity() << std::endl;
+    std::cout << "--------------------------------" << std::endl << std::endl;
+}
+#define PrintSoAArray(Array) PrintSoAArray(Array, #Array)
+
+/*
+ * Benchmark
+ */
+
+struct Particle
+{
+    Vec3 Position;
+    Vec3 Velocity;
+};
+
+void TSoAArray_Benchmark()
+{
+    std::cout << std::endl << "Benchmark (TSoAArray)" << std::endl;
+    const UInt32 TestCount   = 10;
+    const UInt32 NumElements = 10000000;
+
+#if 1
+    // Reading one field
+    {
+        std::cout << std::endl << "Sum x (Elements=" << NumElements << ", TestCount=" << TestCount << ")" << std::endl;
+
+        TArray<Vec3> Vectors;
+        TSoAArray<Double, Double, Double> Columns;
+        Vectors.Reserve(NumElements);
+        Columns.Reserve(NumElements);
+        for (UInt32 i = 0; i < NumElements; i++)
+        {
+            Vectors.EmplaceBack(Double(i), Double(i) * 2.0, Double(i) * 3.0);
+            Columns.EmplaceBack(Double(i), Double(i) * 2.0, Double(i) * 3.0);
+        }
+
+        {
+            Clock  Clock;
+            Double Sum = 0.0;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                for (const Vec3& Vector : Vectors)
+                {
+                    Sum += Vector.x;
+                }
+            }
+
+            std::cout << "TArray<Vec3>:" << Clock.GetTotalDuration() / TestCount << "ns (Sum=" << Sum << ")" << std::endl;
+        }
+
+        {
+            Clock  Clock;
+            Double Sum = 0.0;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                for (Double x : Columns.GetColumn<0>())
+                {
+                    Sum += x;
+                }
+            }
+
+            std::cout << "TSoAArray   :" << Clock.GetTotalDuration() / TestCount << "ns (Sum=" << Sum << ")" << std::endl;
+        }
+    }
+#endif
+
+#if 1
+    // Integrating positions, which reads the positions and velocities but not the other particle data
+    {
+        std::cout << std::endl << "Integrate (Elements=" << NumElements << ", TestCount=" << TestCount << ")" << std::endl;
+        const Double DeltaTime = 1.0 / 60.0;
+
+        {
+            TArray<Particle> Particles;
+            Particles.Resize(NumElements);
+            for (UInt32 i = 0; i < NumElements; i++)
+            {
+                Particles[i].Velocity = Vec3(1.0, Double(i % 10), -1.0);
+            }
+
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+                for (Particle& Element : Particles)
+                {
+                    Element.Position.x += Element.Velocity.x * DeltaTime;
+                    Element.Position.y += Element.Velocity.y * DeltaTime;
+                    Element.Position.z += Element.Velocity.z * DeltaTime;
+                }
+            }
+
+            std::cout << "TArray<Particle>    :" << Clock.GetTotalDuration() / TestCount << "ns (y=" << Particles[5].Position.y << ")" << std::endl;
+        }
+
+        {
+            TSoAArray<Double, Double, Double, Double, Double, Double> Particles(NumElements);
+            for (UInt32 i = 0; i < NumElements; i++)
+            {
+                Particles.Get<3>(i) = 1.0;
+                Particles.Get<4>(i) = Double(i % 10);
+                Particles.Get<5>(i) = -1.0;
+            }
+
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+
+                // One loop per column, which the compiler vectorizes
+                Double* Positions[3]  = { Particles.Data<0>(), Particles.Data<1>(), Particles.Data<2>() };
+                Double* Velocities[3] = { Particles.Data<3>(), Particles.Data<4>(), Particles.Data<5>() };
+                for (UInt32 Axis = 0; Axis < 3; Axis++)
+                {
+                    Double* Position       = Positions[Axis];
+                    const Double* Velocity = Velocities[Axis];
+                    for (UInt32 j = 0; j < NumElements; j++)
+                    {
+                        Position[j] += Velocity[j] * DeltaTime;
+                    }
+                }
+            }
+
+            std::cout << "TSoAArray (Columns) :" << Clock.GetTotalDuration() / TestCount << "ns (y=" << Particles.Get<1>(5) << ")" << std::endl;
+        }
+    }
+#endif
+
+#if 1
+    // Growing
+    {
+        std::cout << std::endl << "EmplaceBack (Elements=" << NumElements << ", TestCount=" << TestCount << ")" << std::endl;
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+
+                TArray<Vec3> Vectors;
+                for (UInt32 j = 0; j < NumElements; j++)
+                {
+                    Vectors.EmplaceBack(Double(j), 0.0, 1.0);
+                }
+            }
+
+            std::cout << "TArray<Vec3>:" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+
+        {
+            Clock Clock;
+            for (UInt32 i = 0; i < TestCount; i++)
+            {
+                ScopedClock ScopedClock(Clock);
+
+                TSoAArray<Double, Double, Double> Columns;
+                for (UInt32 j = 0; j < NumElements; j++)
+                {
+                    Columns.EmplaceBack(Double(j), 0.0, 1.0);
+                }
+            }
+
+            std::cout << "TSoAArray   :" << Clock.GetTotalDuration() / TestCount << "ns" << std::endl;
+        }
+    }
+#endif
+}
+
+/*
+ * Test
+ */
+
+void TSoAArray_Test()
+{
+    std::cout << std::endl << "----------TSoAArray----------" << std::endl << std::endl;
+
+    std::cout << "Testing EmplaceBack" << std::endl;
+    TSoAArray<Int32, std::string, Float> Array;
+    Array.EmplaceBack(1, "One", 1.5f);
+    Array.EmplaceBack(2, "Two", 2.5f);
+    Array.EmplaceBack(3, std::string("Three"), 3.5f);
+    for (Int32 i = 4; i <= 10; i++)
+    {
+        Array.EmplaceBack(i, "Number " + std::to_string(i), Float(i) + 0.5f);
+    }
+
+    PrintSoAArray(Array);
+
+    std::cout << "Testing Proxy Reference" << std::endl;
+    {
+        auto [Number, Name, Value] = Array[1];
+        Number = 20;
+        Name   = "Twenty";
+        Value  = 20.5f;
+
+        std::get<0>(Array.Back()) = 100;
+        std::cout << "Get<0>(1)=" << Array.Get<0>(1) << " Get<1>(1)=" << Array.Get<1>(1) << " Get<2>(1)=" << Array.Get<2>(1) << " Back=" << std::get<0>(Array.Back()) << std::endl;
+
+        // Assigning a tuple assigns every field
+        Array[2] = std::make_tuple(30, std::string("Thirty"), 30.5f);
+        std::cout << "Front=" << std::get<1>(Array.Front()) << " [2]=" << std::get<1>(Array[2]) << std::endl;
+    }
+
+    std::cout << "Testing Columns" << std::endl;
+    {
+        TArrayView<Int32> Numbers = Array.GetColumn<0>();
+        TArrayView<Float> Values  = Array.GetColumn<2>();
+
+        Int32 Sum = 0;
+        for (Int32 Number : Numbers)
+        {
+            Sum += Number;
+        }
+
+        const size_t First     = reinterpret_cast<size_t>(Numbers.Data());
+        const Bool   IsAligned = (First % 16 == 0) && ((reinterpret_cast<size_t>(Array.Data<1>()) - First) % 64 == 0) && ((reinterpret_cast<size_t>(Values.Data()) - First) % 64 == 0);
+        std::cout << "Sum=" << Sum << " Size=" << Numbers.Size() << " Values[9]=" << Values[9] << " IsAligned=" << IsAligned << " Bytes=" << Array.CapacityInBytes() << std::endl;
+    }
+
+    std::cout << "Testing Iterators" << std::endl;
+    {
+        typedef TSoAArray<Int32, std::string, Float>::Iterator Iterator;
+        static_assert(std::is_same<std::iterator_traits<Iterator>::value_type, std::tuple<Int32, std::string, Float>>::value, "value_type must be the value tuple");
+
+        Iterator Last = std::prev(Array.end());
+        Iterator Middle = Array.begin() + 4;
+        Middle -= 2;
+
+        std::cout << "Last=" << std::get<0>(*Last) << " Middle[1]=" << std::get<0>(Middle[1]) << " Distance=" << std::distance(Array.begin(), Array.end())
+            << " Ordered=" << ((Array.begin() < Middle) && (Middle <= Last) && (Last > Middle) && (2 + Middle == Array.begin() + 4)) << std::endl;
+    }
+
+    std::cout << "Testing Remove" << std::endl;
+    Array.RemoveAtSwap(0);
+    Array.PopBack();
+    Array.RemoveAtSwap(Array.Size() - 1);
+    PrintSoAArray(Array);
+
+    std::cout << "Testing Resize" << std::endl;
+    {
+        TSoAArray<Vec3, UInt32> Resized;
+        Resized.Resize(3);
+        Resized.Get<1>(2) = 7;
+        Resized.EmplaceBack(Vec3(1.0, 2.0, 3.0), 8u);
+        std::cout << "Size=" << Resized.Size() << " [2]=" << Resized.Get<1>(2) << " [3]=" << std::string(Resized.Get<0>(3)) << std::endl;
+
+        Resized.Resize(1);
+        std::cout << "Size=" << Resized.Size() << " Capacity=" << Resized.Capacity() << std::endl;
+    }
+
+    std::cout << "Testing Copy/Move" << std::endl;
+    {
+        TSoAArray<Int32, std::string, Float> Copy(Array);
+        TSoAArray<Int32, std::string, Float> Moved(::Move(Copy));
+        Moved.EmplaceBack(11, "Eleven", 11.5f);
+        PrintSoAArray(Moved);
+        std::cout << "Copy.Size()=" << Copy.Size() << " Array.Size()=" << Array.Size() << std::endl;
+
+        Copy = Moved;
+        Copy.Swap(Array);
+        std::cout << "Copy.Size()=" << Copy.Size() << " Array.Size()=" << Array.Size() << std::endl;
+        Array.Clear();
+        std::cout << "Cleared Size=" << Array.Size() << " Capacity=" << (Array.Capacity() > 0) << std::endl;
+    }
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+void TSoAArray_Benchmark();
+void TSoAArray_Test();
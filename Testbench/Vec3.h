@@ -0,0 +1,39 @@
+#pragma once
+#include "../Containers/Types.h"
+
+#include <string>
+
+/*
+ * Vec3
+ */
+
+struct Vec3
+{
+    Vec3()
+        : x(0.0)
+        , y(0.0)
+        , z(0.0)
+    {
+    }
+
+    Vec3(Double InX, Double InY, Double InZ)
+        : x(InX)
+        , y(InY)
+        , z(InZ)
+    {
+    }
+
+    Double x;
+    Double y;
+    Double z;
+
+    Bool operator==(const Vec3& Other) const
+    {
+        return (x == Other.x) && (y == Other.y) && (z == Other.z);
+    }
+
+    operator std::string() const
+    {
+        return std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z);
+    }
+};